@@ -0,0 +1,556 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file mole_bench.cpp
+ *
+ * @brief Performance harness for operator construction, application,
+ *        boundary conditions and linear solves.
+ *
+ * Usage: mole_bench [--json FILE] [--filter TEXT] [--min-time SECONDS]
+ *                   [--quick] [--list]
+ *
+ * Every case is timed until at least --min-time seconds (default 0.5) and
+ * three repetitions have elapsed. Results go to stdout as a table and,
+ * with --json, to a file using the Google Benchmark JSON layout so existing
+ * comparison tooling can diff two runs.
+ *
+ * @date 2026/10/19
+ */
+
+#include "mole.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Case {
+  std::string name;
+  std::function<void()> init;  // untimed, runs once before measuring
+  std::function<void()> setup; // untimed, runs before every iteration
+  std::function<void()> run;   // timed
+  std::function<uword()> nnz;  // size of the operator involved, if any
+};
+
+// Operator (or system) plus the vectors a case works on. Built lazily by
+// Case::init so that filtered-out cases cost nothing.
+struct State {
+  sp_mat A;
+  sp_mat work;
+  vec x, b;
+};
+
+struct Result {
+  std::string name;
+  uword iterations;
+  double min_ns, median_ns, mean_ns;
+  uword nnz;
+};
+
+// Keeps results alive so the compiler cannot drop the timed work.
+volatile double sink = 0.0;
+
+const u16 orders[] = {2, 4, 6, 8};
+
+struct Sizes {
+  std::vector<u32> d1, d2, d3;
+};
+
+std::string caseName(const std::string &group, const std::string &what,
+                     int dim, u32 m, int k) {
+  std::string name = group + "/" + what + "/" + std::to_string(dim) + "D/" +
+                     std::to_string(m);
+  if (k > 0) {
+    name += "/k" + std::to_string(k);
+  }
+  return name;
+}
+
+// ---------------------------------------------------------------------------
+// Case registration
+// ---------------------------------------------------------------------------
+
+void addConstructors(std::vector<Case> &cases, const Sizes &s) {
+  const ivec dc1 = {1, 1}, nc1 = {0, 0};
+  const ivec dc2 = {1, 1, 1, 1}, nc2 = {0, 0, 0, 0};
+  const ivec dc3 = {1, 1, 1, 1, 1, 1}, nc3 = {0, 0, 0, 0, 0, 0};
+
+  for (u16 k : orders) {
+    for (u32 m : s.d1) {
+      const Real h = 1.0 / m;
+      auto add = [&](const std::string &what, std::function<uword()> f) {
+        cases.push_back({caseName("construct", what, 1, m, k), nullptr,
+                         nullptr, [f] { sink = sink + f(); }, nullptr});
+      };
+      add("Gradient", [=] { return Gradient(k, m, h).n_nonzero; });
+      add("Divergence", [=] { return Divergence(k, m, h).n_nonzero; });
+      add("Laplacian", [=] { return Laplacian(k, m, h).n_nonzero; });
+      add("InterpolCtoF",
+          [=] { return InterpolCtoF(k, m, dc1, nc1).n_nonzero; });
+      add("InterpolCtoN",
+          [=] { return InterpolCtoN(k, m, dc1, nc1).n_nonzero; });
+      add("InterpolFtoC",
+          [=] { return InterpolFtoC(k, m, dc1, nc1).n_nonzero; });
+      add("InterpolNtoC",
+          [=] { return InterpolNtoC(k, m, dc1, nc1).n_nonzero; });
+      add("RobinBC", [=] { return RobinBC(k, m, h, 1.0, 1.0).n_nonzero; });
+      add("MixedBC", [=] {
+        return MixedBC(k, m, h, "Dirichlet", {1.0}, "Robin", {1.0, 1.0})
+            .n_nonzero;
+      });
+    }
+    for (u32 m : s.d2) {
+      const Real h = 1.0 / m;
+      auto add = [&](const std::string &what, std::function<uword()> f) {
+        cases.push_back({caseName("construct", what, 2, m, k), nullptr,
+                         nullptr, [f] { sink = sink + f(); }, nullptr});
+      };
+      add("Gradient", [=] { return Gradient(k, m, m, h, h).n_nonzero; });
+      add("Divergence", [=] { return Divergence(k, m, m, h, h).n_nonzero; });
+      add("Laplacian", [=] { return Laplacian(k, m, m, h, h).n_nonzero; });
+      add("InterpolCtoF",
+          [=] { return InterpolCtoF(k, m, m, dc2, nc2).n_nonzero; });
+      add("InterpolCtoN",
+          [=] { return InterpolCtoN(k, m, m, dc2, nc2).n_nonzero; });
+      add("InterpolFtoC",
+          [=] { return InterpolFtoC(k, m, m, dc2, nc2).n_nonzero; });
+      add("InterpolNtoC",
+          [=] { return InterpolNtoC(k, m, m, dc2, nc2).n_nonzero; });
+      add("RobinBC",
+          [=] { return RobinBC(k, m, h, m, h, 1.0, 1.0).n_nonzero; });
+      add("MixedBC", [=] {
+        return MixedBC(k, m, h, m, h, "Dirichlet", {1.0}, "Robin", {1.0, 1.0},
+                       "Neumann", {1.0}, "Dirichlet", {1.0})
+            .n_nonzero;
+      });
+    }
+    for (u32 m : s.d3) {
+      const Real h = 1.0 / m;
+      auto add = [&](const std::string &what, std::function<uword()> f) {
+        cases.push_back({caseName("construct", what, 3, m, k), nullptr,
+                         nullptr, [f] { sink = sink + f(); }, nullptr});
+      };
+      add("Gradient", [=] { return Gradient(k, m, m, m, h, h, h).n_nonzero; });
+      add("Divergence",
+          [=] { return Divergence(k, m, m, m, h, h, h).n_nonzero; });
+      add("Laplacian",
+          [=] { return Laplacian(k, m, m, m, h, h, h).n_nonzero; });
+      add("InterpolCtoF",
+          [=] { return InterpolCtoF(k, m, m, m, dc3, nc3).n_nonzero; });
+      add("InterpolCtoN",
+          [=] { return InterpolCtoN(k, m, m, m, dc3, nc3).n_nonzero; });
+      add("InterpolFtoC",
+          [=] { return InterpolFtoC(k, m, m, m, dc3, nc3).n_nonzero; });
+      add("InterpolNtoC",
+          [=] { return InterpolNtoC(k, m, m, m, dc3, nc3).n_nonzero; });
+      add("RobinBC",
+          [=] { return RobinBC(k, m, h, m, h, m, h, 1.0, 1.0).n_nonzero; });
+      add("MixedBC", [=] {
+        return MixedBC(k, m, h, m, h, m, h, "Dirichlet", {1.0}, "Robin",
+                       {1.0, 1.0}, "Neumann", {1.0}, "Dirichlet", {1.0},
+                       "Dirichlet", {1.0}, "Neumann", {1.0})
+            .n_nonzero;
+      });
+    }
+  }
+
+  // Interpol has no order parameter.
+  auto addInterpol = [&cases](int dim, u32 m, std::function<uword()> f) {
+    cases.push_back({caseName("construct", "Interpol", dim, m, 0), nullptr,
+                     nullptr, [f] { sink = sink + f(); }, nullptr});
+  };
+  for (u32 m : s.d1)
+    addInterpol(1, m, [m] { return Interpol(m, 0.5).n_nonzero; });
+  for (u32 m : s.d2)
+    addInterpol(2, m, [m] { return Interpol(m, m, 0.5, 0.5).n_nonzero; });
+  for (u32 m : s.d3)
+    addInterpol(3, m,
+                [m] { return Interpol(m, m, m, 0.5, 0.5, 0.5).n_nonzero; });
+}
+
+// Assembles one of the core operators on the unit line/square/cube.
+sp_mat assemble(const std::string &op, int dim, u16 k, u32 m) {
+  const Real h = 1.0 / m;
+  if (op == "Gradient") {
+    if (dim == 1)
+      return Gradient(k, m, h);
+    if (dim == 2)
+      return Gradient(k, m, m, h, h);
+    return Gradient(k, m, m, m, h, h, h);
+  }
+  if (op == "Divergence") {
+    if (dim == 1)
+      return Divergence(k, m, h);
+    if (dim == 2)
+      return Divergence(k, m, m, h, h);
+    return Divergence(k, m, m, m, h, h, h);
+  }
+  if (dim == 1)
+    return Laplacian(k, m, h);
+  if (dim == 2)
+    return Laplacian(k, m, m, h, h);
+  return Laplacian(k, m, m, m, h, h, h);
+}
+
+// The same operators kept as Kronecker factors (2-D and 3-D only).
+mole::KronOperator factored(const std::string &op, int dim, u16 k, u32 m) {
+  const Real h = 1.0 / m;
+  if (op == "Gradient")
+    return dim == 2 ? mole::KronOperator::gradient(k, m, m, h, h)
+                    : mole::KronOperator::gradient(k, m, m, m, h, h, h);
+  if (op == "Divergence")
+    return dim == 2 ? mole::KronOperator::divergence(k, m, m, h, h)
+                    : mole::KronOperator::divergence(k, m, m, m, h, h, h);
+  return dim == 2 ? mole::KronOperator::laplacian(k, m, m, h, h)
+                  : mole::KronOperator::laplacian(k, m, m, m, h, h, h);
+}
+
+// Homogeneous Dirichlet conditions on every boundary.
+void applyDirichlet(sp_mat &A, vec &b, int dim, u16 k, u32 m) {
+  const Real h = 1.0 / m;
+  if (dim == 1) {
+    AddScalarBC::BC1D bc;
+    bc.dc = {1.0, 1.0};
+    AddScalarBC::addScalarBC(A, b, k, m, h, bc);
+  } else if (dim == 2) {
+    AddScalarBC::BC2D bc;
+    bc.dc = {1.0, 1.0, 1.0, 1.0};
+    bc.v = {vec(m, fill::zeros), vec(m, fill::zeros), vec(m + 2, fill::zeros),
+            vec(m + 2, fill::zeros)};
+    AddScalarBC::addScalarBC(A, b, k, m, h, m, h, bc);
+  } else {
+    AddScalarBC::BC3D bc;
+    bc.dc = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+    const uword yz = m * m, xz = (m + 2) * m, xy = (m + 2) * (m + 2);
+    bc.v = {vec(yz, fill::zeros), vec(yz, fill::zeros), vec(xz, fill::zeros),
+            vec(xz, fill::zeros), vec(xy, fill::zeros), vec(xy, fill::zeros)};
+    AddScalarBC::addScalarBC(A, b, k, m, h, m, h, m, h, bc);
+  }
+}
+
+template <class F> void forEachSize(const Sizes &s, F f) {
+  for (u16 k : orders) {
+    for (u32 m : s.d1)
+      f(1, m, k);
+    for (u32 m : s.d2)
+      f(2, m, k);
+    for (u32 m : s.d3)
+      f(3, m, k);
+  }
+}
+
+// Sparse matrix-vector products with the assembled operators.
+void addApply(std::vector<Case> &cases, const Sizes &s) {
+  forEachSize(s, [&cases](int dim, u32 m, u16 k) {
+    for (const char *op : {"Gradient", "Divergence", "Laplacian"}) {
+      auto st = std::make_shared<State>();
+      const std::string name = op;
+      cases.push_back({caseName("apply", name, dim, m, k),
+                       [=] {
+                         st->A = assemble(name, dim, k, m);
+                         st->x.randu(st->A.n_cols);
+                       },
+                       nullptr,
+                       [st] {
+                         st->b = st->A * st->x;
+                         sink = sink + st->b(0);
+                       },
+                       [st] { return st->A.n_nonzero; }});
+
+      // Same product through the row-major mirror, split over the threads
+      auto rows = std::make_shared<std::unique_ptr<mole::CSR>>();
+      auto vecs = std::make_shared<State>();
+      cases.push_back({caseName("apply_csr", name, dim, m, k),
+                       [=] {
+                         *rows = std::unique_ptr<mole::CSR>(
+                             new mole::CSR(assemble(name, dim, k, m)));
+                         vecs->x.randu((*rows)->cols());
+                       },
+                       nullptr,
+                       [vecs, rows] {
+                         (*rows)->apply(vecs->x, vecs->b);
+                         sink = sink + vecs->b(0);
+                       },
+                       [rows] { return (*rows)->nnz(); }});
+
+      // A batch of 16 vectors sharing each pass over the operator
+      auto bst = std::make_shared<State>();
+      auto batch = std::make_shared<std::pair<mat, mat>>();
+      cases.push_back({caseName("apply_batch16", name, dim, m, k),
+                       [=] {
+                         bst->A = assemble(name, dim, k, m);
+                         batch->first.randu(bst->A.n_cols, 16);
+                       },
+                       nullptr,
+                       [bst, batch] {
+                         mole::apply(bst->A, batch->first, batch->second);
+                         sink = sink + batch->second(0, 0);
+                       },
+                       [bst] { return bst->A.n_nonzero; }});
+
+      if (dim == 1)
+        continue;
+      // Same product as mode products over the 1-D factors
+      auto kron = std::make_shared<std::unique_ptr<mole::KronOperator>>();
+      auto kvecs = std::make_shared<State>();
+      cases.push_back({caseName("apply_kron", name, dim, m, k),
+                       [=] {
+                         *kron = std::unique_ptr<mole::KronOperator>(
+                             new mole::KronOperator(factored(name, dim, k, m)));
+                         kvecs->x.randu((*kron)->cols());
+                       },
+                       nullptr,
+                       [kvecs, kron] {
+                         (*kron)->apply(kvecs->x, kvecs->b);
+                         sink = sink + kvecs->b(0);
+                       },
+                       nullptr});
+    }
+  });
+}
+
+// addScalarBC modifies the operator in place, so every iteration starts from
+// a fresh copy made in the (untimed) setup step.
+void addBoundaryConditions(std::vector<Case> &cases, const Sizes &s) {
+  forEachSize(s, [&cases](int dim, u32 m, u16 k) {
+    auto st = std::make_shared<State>();
+    cases.push_back({caseName("addScalarBC", "Dirichlet", dim, m, k),
+                     [=] { st->A = assemble("Laplacian", dim, k, m); },
+                     [st] {
+                       st->work = st->A;
+                       st->b.zeros(st->A.n_rows);
+                     },
+                     [=] {
+                       applyDirichlet(st->work, st->b, dim, k, m);
+                       sink = sink + st->b(0);
+                     },
+                     [st] { return st->A.n_nonzero; }});
+  });
+}
+
+// Poisson problems with Dirichlet boundaries, solved by every backend that
+// was compiled in.
+void addSolvers(std::vector<Case> &cases, const Sizes &s) {
+  forEachSize(s, [&cases](int dim, u32 m, u16 k) {
+    auto st = std::make_shared<State>();
+    auto init = [=] {
+      if (st->A.n_nonzero == 0) {
+        st->A = assemble("Laplacian", dim, k, m);
+        st->b.ones(st->A.n_rows);
+        applyDirichlet(st->A, st->b, dim, k, m);
+      }
+    };
+    auto nnz = [st] { return st->A.n_nonzero; };
+
+    cases.push_back({caseName("solve", "superlu", dim, m, k), init, nullptr,
+                     [st] {
+                       st->x = spsolve(st->A, st->b, "superlu");
+                       sink = sink + st->x(0);
+                     },
+                     nnz});
+
+    // The factorisation is paid once in init; only the triangular solves
+    // against it are timed.
+    auto solver = std::make_shared<spsolve_factoriser>();
+    cases.push_back({caseName("solve", "superlu_factorised", dim, m, k),
+                     [=] {
+                       init();
+                       if (!solver->factorise(st->A))
+                         throw std::runtime_error("factorisation failed");
+                     },
+                     nullptr,
+                     [st, solver] {
+                       if (!solver->solve(st->x, st->b))
+                         throw std::runtime_error("triangular solve failed");
+                       sink = sink + st->x(0);
+                     },
+                     nnz});
+
+#ifdef EIGEN
+    cases.push_back({caseName("solve", "eigen", dim, m, k), init, nullptr,
+                     [st] {
+                       st->x = Utils::spsolve_eigen(st->A, st->b);
+                       sink = sink + st->x(0);
+                     },
+                     nnz});
+#endif
+
+    // Dense LAPACK fallback, only affordable on small 1-D systems.
+    if (dim == 1 && m <= 4096) {
+      cases.push_back({caseName("solve", "lapack", dim, m, k), init, nullptr,
+                       [st] {
+                         st->x = spsolve(st->A, st->b, "lapack");
+                         sink = sink + st->x(0);
+                       },
+                       nnz});
+    }
+  });
+}
+
+// ---------------------------------------------------------------------------
+// Timing and reporting
+// ---------------------------------------------------------------------------
+
+Result measure(const Case &c, double min_time) {
+  std::vector<double> samples;
+  double total = 0.0;
+
+  if (c.init)
+    c.init();
+
+  // One warm-up iteration to fault in memory and caches.
+  if (c.setup)
+    c.setup();
+  c.run();
+
+  while (total < min_time || samples.size() < 3) {
+    if (c.setup)
+      c.setup();
+    const auto start = Clock::now();
+    c.run();
+    const double elapsed =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    samples.push_back(elapsed);
+    total += elapsed;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const double scale = 1e9;
+  return {c.name,
+          samples.size(),
+          samples.front() * scale,
+          samples[samples.size() / 2] * scale,
+          total / samples.size() * scale,
+          c.nnz ? c.nnz() : 0};
+}
+
+std::string timestamp() {
+  char buffer[32];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::gmtime(&now));
+  return buffer;
+}
+
+void writeJson(const std::string &path, const std::vector<Result> &results,
+               double min_time) {
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("cannot open " + path + " for writing");
+  }
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+  out << std::setprecision(10);
+  out << "{\n  \"context\": {\n"
+      << "    \"date\": \"" << timestamp() << "\",\n"
+      << "    \"library\": \"mole_C++\",\n"
+      << "    \"compiler\": \"" << __VERSION__ << "\",\n"
+      << "    \"num_threads\": " << threads << ",\n"
+      << "    \"min_time\": " << min_time << ",\n"
+#ifdef EIGEN
+      << "    \"eigen\": true\n"
+#else
+      << "    \"eigen\": false\n"
+#endif
+      << "  },\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    out << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name
+        << "\", \"run_type\": \"iteration\", \"iterations\": " << r.iterations
+        << ", \"real_time\": " << r.median_ns << ", \"min_time_ns\": "
+        << r.min_ns << ", \"mean_time_ns\": " << r.mean_ns
+        << ", \"time_unit\": \"ns\", \"nnz\": " << r.nnz << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void usage(const char *argv0) {
+  std::cout << "usage: " << argv0
+            << " [--json FILE] [--filter TEXT] [--min-time SECONDS]"
+               " [--quick] [--list]\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string json, filter;
+  double min_time = 0.5;
+  bool quick = false, list = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--json" && i + 1 < argc) {
+      json = argv[++i];
+    } else if (arg == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      min_time = std::atof(argv[++i]);
+    } else if (arg == "--quick") {
+      quick = true;
+    } else if (arg == "--list") {
+      list = true;
+    } else {
+      usage(argv[0]);
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+
+  Sizes sizes;
+  if (quick) {
+    sizes = {{1000}, {64}, {20}};
+  } else {
+    sizes = {{1000, 100000}, {64, 256}, {20, 48}};
+  }
+
+  std::vector<Case> cases;
+  addConstructors(cases, sizes);
+  addApply(cases, sizes);
+  addBoundaryConditions(cases, sizes);
+  addSolvers(cases, sizes);
+
+  std::vector<Result> results;
+  for (Case &c : cases) {
+    if (!filter.empty() && c.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    if (list) {
+      std::cout << c.name << '\n';
+      continue;
+    }
+    const Result r = measure(c, min_time);
+    std::printf("%-48s %10llu it %14.0f ns (min %14.0f)\n", r.name.c_str(),
+                static_cast<unsigned long long>(r.iterations), r.median_ns,
+                r.min_ns);
+    std::fflush(stdout);
+    results.push_back(r);
+    c = Case(); // release the operators this case built
+  }
+
+  if (!json.empty() && !list) {
+    writeJson(json, results, min_time);
+    std::cout << "Results written to " << json << '\n';
+  }
+
+  return 0;
+}
@@ -96,14 +96,10 @@ int main() {
   Divergence D(k, m, n, dx, dy);  // 2D divergence operator
   Gradient G(k, m, n, dx, dy);    // 2D gradient operator
 
-  // Build the Laplacian operator
-  Laplacian L(k, m, n, dx, dy);
-  // Impose Dirichlet boundary conditions using a RobinBC
-  RobinBC BC(k, m, dx, n, dy, 0, 1);  // Neumann BC
-  L = L + BC;
-
-  // Pre-multiply the gradient operator for pressure correction.
-  G *= (-dt / rho_middle);
+  // Pressure projection with Neumann conditions (RobinBC with a = 0, b = 1).
+  // The pressure operator D*G + BC is factorized once and reused every step.
+  const mole::Projection projection(D, G, RobinBC(k, m, dx, n, dy, 0, 1));
+  vec p_vec;
 
   std::cout << "Starting simulation with " << iterations << " time steps..."
             << std::endl;
@@ -159,39 +155,24 @@ int main() {
       }
     }
 
-    // -- Pressure Solve --
+    // -- Pressure Solve and Corrector Step --
     // Flatten the predicted velocities into vectors.
     // Use transpose to match MATLAB's column-major order during vectorization
     vec u_vec = vectorise(u_star.t());
     vec v_vec = vectorise(v_star.t());
-    vec R = (rho_middle / dt) * join_cols(u_vec, v_vec);
-
-    // Calculate the right-hand side for the pressure Poisson equation
-    vec b = D * R;  // This is the divergence of the predicted velocity field
+    vec uv = join_cols(u_vec, v_vec);
 
-    // Solve the pressure Poisson equation
-    vec p_vec;
-#ifdef EIGEN
-    p_vec = Utils::spsolve_eigen(L, b);
-#else
-    // Default to SuperLU if EIGEN is not defined
-    p_vec = spsolve(L, b);
-#endif
+    // Solves L p = (rho / dt) * D * uv and corrects uv -= (dt / rho) * G * p
+    // in place, like MATLAB's u = u_s + G(1:u_length, :) * p
+    projection.project(uv, p_vec, dt / rho_middle);
 
     // Reshape the solution vector back into a matrix
     p = reshape(p_vec, m + 2, n + 2).t();
 
-    // -- Corrector Step --
-    // Update velocities by adding the pressure gradient, similar to MATLAB's u
-    // = u_s+G(1:u_length, :)*p;
-    int tot_u = u_vec.n_elem;
-    vec p_grad = G * p_vec;
-    vec p_grad_u = p_grad.rows(0, tot_u - 1);
-    vec p_grad_v = p_grad.rows(tot_u, p_grad.n_rows - 1);
-
     // Make sure to reshape in the same order that was used when flattening
-    u = reshape(u_vec + p_grad_u, m + 1, n).t();
-    v = reshape(v_vec + p_grad_v, m, n + 1).t();
+    const uword tot_u = u_vec.n_elem;
+    u = reshape(uv.rows(0, tot_u - 1), m + 1, n).t();
+    v = reshape(uv.rows(tot_u, uv.n_elem - 1), m, n + 1).t();
 
     // -- Advection of Temperature --
     // Implement a simple upwind differencing scheme for temperature advection
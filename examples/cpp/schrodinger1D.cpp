@@ -27,10 +27,10 @@ int main() {
   // Hamiltonian
   sp_mat H = -0.5 * (sp_mat)L + V;
 
-  cx_vec eigval;
-  eig_gen(eigval, (mat)H); // Compute eigenvalues
-
-  eigval = sort(eigval);
+  // Four lowest energy levels; the potential is nonnegative, so 0 is a
+  // lower bound for the spectrum and a good shift
+  mole::EigsResult levels = mole::eigs(H, 4, mole::EigsTarget::Lowest, 0.0);
+  cx_vec eigval = levels.values;
 
   cout << "Energy levels = [ ";
   for (int i = 0; i < 4; ++i)
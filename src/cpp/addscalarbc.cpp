@@ -14,6 +14,7 @@
  */
 
 #include "addscalarbc.h"
+#include "csr.h"
 
 namespace AddScalarBC {
 
@@ -49,14 +50,26 @@ uvec collectUniqueRows(const sp_mat &M) {
  * Zeros out specified rows of a sparse matrix in-place.
  *       Used to remove existing equations at boundary nodes before
  *       replacing them with boundary condition equations.
+ *       Rows are edited on a CSR copy, O(row nnz) each; erasing entries
+ *       of the CSC matrix one at a time costs O(nnz) per entry.
  */
 void zeroRows(sp_mat &A, const uvec &rows) {
+    if (rows.is_empty()) return;
+    mole::CSR byRows(A);
     for (uword i = 0; i < rows.n_elem; i++) {
-        uword row_idx = rows(i);
-        for (sp_mat::const_row_iterator it = A.begin_row(row_idx);
-             it != A.end_row(row_idx); ++it) {
-            A(it.row(), it.col()) = 0;
-        }
+        byRows.zeroRow(rows(i));
+    }
+    A = byRows.toSparse();
+}
+
+/**
+ * Fills dc and nc from typed face conditions.
+ */
+void fromFaces(vec &dc, vec &nc, const mole::FaceBC *faces, uword count) {
+    for (uword f = 0; f < count; f++) {
+        const mole::RobinCoeffs c = faces[f].robinCoeffs();
+        dc(f) = c.a;
+        nc(f) = c.b;
     }
 }
 
@@ -138,6 +151,22 @@ void applyBCPairRhs(vec &b, const vec &dc, const vec &nc,
 
 } // anonymous namespace
 
+// ============================================================================
+// Typed boundary descriptions
+// ============================================================================
+
+BC1D::BC1D(const std::array<mole::FaceBC, 2> &faces) : BC1D() {
+    fromFaces(dc, nc, faces.data(), faces.size());
+}
+
+BC2D::BC2D(const std::array<mole::FaceBC, 4> &faces) : BC2D() {
+    fromFaces(dc, nc, faces.data(), faces.size());
+}
+
+BC3D::BC3D(const std::array<mole::FaceBC, 6> &faces) : BC3D() {
+    fromFaces(dc, nc, faces.data(), faces.size());
+}
+
 // ============================================================================
 // LHS: Boundary matrix construction (1D, 2D, 3D overloads)
 // ============================================================================
@@ -145,6 +174,7 @@ void applyBCPairRhs(vec &b, const vec &dc, const vec &nc,
 void addScalarBClhs(u16 k, u32 m, Real dx,
                     const vec &dc, const vec &nc,
                     sp_mat &Al, sp_mat &Ar) {
+    MOLE_PROFILE_SCOPE("addScalarBClhs 1-D");
     mole::check_spacing(dx, "dx");
     Al = sp_mat(m+2, m+2);
     Ar = sp_mat(m+2, m+2);
@@ -172,6 +202,7 @@ void addScalarBClhs(u16 k, u32 m, Real dx,
 void addScalarBClhs(u16 k, u32 m, Real dx, u32 n, Real dy,
                     const vec &dc, const vec &nc,
                     sp_mat &Al, sp_mat &Ar, sp_mat &Ab, sp_mat &At) {
+    MOLE_PROFILE_SCOPE("addScalarBClhs 2-D");
     mole::check_spacing(dx, "dx");
     mole::check_spacing(dy, "dy");
     Al.set_size(0, 0); Ar.set_size(0, 0);
@@ -205,6 +236,7 @@ void addScalarBClhs(u16 k, u32 m, Real dx, u32 n, Real dy, u32 o, Real dz,
                     const vec &dc, const vec &nc,
                     sp_mat &Al, sp_mat &Ar, sp_mat &Ab,
                     sp_mat &At, sp_mat &Af, sp_mat &Ak) {
+    MOLE_PROFILE_SCOPE("addScalarBClhs 3-D");
     mole::check_spacing(dx, "dx");
     mole::check_spacing(dy, "dy");
     mole::check_spacing(dz, "dz");
@@ -266,6 +298,7 @@ void addScalarBCrhs(vec &b, const vec &dc, const vec &nc,
                     const std::vector<vec> &v,
                     const uvec &rl, const uvec &rr,
                     const uvec &rb, const uvec &rt) {
+    MOLE_PROFILE_SCOPE("addScalarBCrhs 2-D");
     const BCPairRhs pairs[] = {
         {0, 1, rl, rr, 0, 1},  // Left  / Right
         {2, 3, rb, rt, 2, 3},  // Bottom / Top
@@ -277,6 +310,7 @@ void addScalarBCrhs(vec &b, const vec &dc, const vec &nc,
                     const std::vector<vec> &v,
                     const uvec &rl, const uvec &rr, const uvec &rb,
                     const uvec &rt, const uvec &rf, const uvec &rk) {
+    MOLE_PROFILE_SCOPE("addScalarBCrhs 3-D");
     const BCPairRhs pairs[] = {
         {0, 1, rl, rr, 0, 1},  // Left  / Right
         {2, 3, rb, rt, 2, 3},  // Bottom / Top
@@ -290,6 +324,8 @@ void addScalarBCrhs(vec &b, const vec &dc, const vec &nc,
 // ============================================================================
 
 void addScalarBC(sp_mat &A, vec &b, u16 k, u32 m, Real dx, const BC1D &bc) {
+    MOLE_PROFILE_SCOPE("addScalarBC 1-D");
+    MOLE_PROFILE_COUNT("nnz", A.n_nonzero);
     mole::check_spacing(dx, "dx");
     assert(bc.dc.n_elem == 2 && "dc must be a 2x1 vector");
     assert(bc.nc.n_elem == 2 && "nc must be a 2x1 vector");
@@ -313,6 +349,8 @@ void addScalarBC(sp_mat &A, vec &b, u16 k, u32 m, Real dx, const BC1D &bc) {
 
 void addScalarBC(sp_mat &A, vec &b, u16 k, u32 m, Real dx,
                  u32 n, Real dy, const BC2D &bc) {
+    MOLE_PROFILE_SCOPE("addScalarBC 2-D");
+    MOLE_PROFILE_COUNT("nnz", A.n_nonzero);
     mole::check_spacing(dx, "dx");
     mole::check_spacing(dy, "dy");
     assert(bc.dc.n_elem == 4 && "dc must be a 4x1 vector");
@@ -337,6 +375,8 @@ void addScalarBC(sp_mat &A, vec &b, u16 k, u32 m, Real dx,
 
 void addScalarBC(sp_mat &A, vec &b, u16 k, u32 m, Real dx,
                  u32 n, Real dy, u32 o, Real dz, const BC3D &bc) {
+    MOLE_PROFILE_SCOPE("addScalarBC 3-D");
+    MOLE_PROFILE_COUNT("nnz", A.n_nonzero);
     mole::check_spacing(dx, "dx");
     mole::check_spacing(dy, "dy");
     mole::check_spacing(dz, "dz");
@@ -27,6 +27,8 @@
 
 #include "utils.h"
 #include "gradient.h"
+#include "boundary.h"
+#include <array>
 #include <vector>
 #include <cassert>
 
@@ -45,6 +47,9 @@ struct BC1D {
     vec v;   // Boundary values g (2x1: left, right)
 
     BC1D() : dc(2, fill::zeros), nc(2, fill::zeros), v(2, fill::zeros) {}
+
+    /** dc and nc from typed faces (left, right); v is left at zero */
+    explicit BC1D(const std::array<mole::FaceBC, 2> &faces);
 };
 
 /**
@@ -58,6 +63,9 @@ struct BC2D {
     std::vector<vec> v;  // Boundary values g (4 vectors: left, right, bottom, top)
 
     BC2D() : dc(4, fill::zeros), nc(4, fill::zeros), v(4) {}
+
+    /** dc and nc from typed faces (left, right, bottom, top) */
+    explicit BC2D(const std::array<mole::FaceBC, 4> &faces);
 };
 
 /**
@@ -71,6 +79,9 @@ struct BC3D {
     std::vector<vec> v;  // Boundary values g (6 vectors: left, right, bottom, top, front, back)
 
     BC3D() : dc(6, fill::zeros), nc(6, fill::zeros), v(6) {}
+
+    /** dc and nc from typed faces (left, right, bottom, top, front, back) */
+    explicit BC3D(const std::array<mole::FaceBC, 6> &faces);
 };
 
 // ============================================================================
@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file boundary.cpp
+ *
+ * @brief Boundary rows of Robin-type operators, assembled from triplets
+ *
+ * @date 2026/10/19
+ */
+
+#include "boundary.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace mole {
+
+FaceBC faceBC(const std::string &type, const std::vector<Real> &coeffs) {
+  const size_t needed = type == "Robin" ? 2 : 1;
+  if (coeffs.size() < needed)
+    throw std::invalid_argument("MOLE: a " + type + " condition needs " +
+                                std::to_string(needed) + " coefficient" +
+                                (needed > 1 ? "s" : "") + ", got " +
+                                std::to_string(coeffs.size()));
+  if (type == "Dirichlet")
+    return dirichlet(coeffs[0]);
+  if (type == "Neumann")
+    return neumann(coeffs[0]);
+  if (type == "Robin")
+    return robin(coeffs[0], coeffs[1]);
+  throw std::invalid_argument("Unknown boundary condition type");
+}
+
+BoundaryPlan::BoundaryPlan(u16 k, const std::vector<u32> &cells,
+                           const std::vector<Real> &spacing)
+    : cellCounts(cells), widths(spacing) {
+  MOLE_PROFILE_SCOPE("BoundaryPlan");
+  const uword dims = cells.size();
+  if (dims < 1 || dims > 3 || spacing.size() != dims)
+    throw std::invalid_argument("MOLE: expected 1 to 3 axes with a spacing "
+                                "each");
+  static const char *const names[] = {"dx", "dy", "dz"};
+  for (uword d = 0; d < dims; ++d)
+    check_spacing(spacing[d], names[d]);
+  const Real *w = Gradient::boundaryWeights(k);
+
+  uword size[3] = {1, 1, 1}, stride[3] = {1, 1, 1};
+  for (uword d = 0; d < dims; ++d) {
+    assert(cells[d] >= 2 * k);
+    size[d] = cells[d] + 2;
+  }
+  stride[1] = size[0];
+  stride[2] = size[0] * size[1];
+  total = size[0] * size[1] * size[2];
+
+  // The face rows of one axis: the diagonal, then -w / dx on the first
+  // point and -w / dx mirrored on the last one
+  struct Entry {
+    uword row, col, face;
+    bool diagonal;
+    Real weight;
+  };
+  std::vector<Entry> entries;
+  rowsOf.resize(2 * dims);
+
+  for (uword d = 0; d < dims; ++d) {
+    const uword m = cells[d];
+    const Real dx = spacing[d];
+    std::vector<Entry> line;
+    for (uword side = 0; side < 2; ++side) {
+      const uword face = 2 * d + side, point = side ? m + 1 : 0;
+      line.push_back({point, point, face, true, 1.0});
+      for (uword j = 0; j <= k; ++j)
+        line.push_back({point, side ? m + 1 - j : j, face, false,
+                        -(w[j] / dx)});
+    }
+
+    // Along axis d the rows repeat over every point of the axes before it
+    // and over the interior of the axes after it
+    uword lo[3], hi[3];
+    for (uword e = 0; e < 3; ++e) {
+      const bool interior = e > d && e < dims;
+      lo[e] = e == d ? 0 : (interior ? 1 : 0);
+      hi[e] = e == d ? 1 : (interior ? size[e] - 1 : size[e]);
+    }
+    std::vector<uword> points[2];
+    for (uword i2 = lo[2]; i2 < hi[2]; ++i2)
+      for (uword i1 = lo[1]; i1 < hi[1]; ++i1)
+        for (uword i0 = lo[0]; i0 < hi[0]; ++i0) {
+          const uword base = i0 + i1 * stride[1] + i2 * stride[2];
+          for (const Entry &entry : line)
+            entries.push_back({base + entry.row * stride[d],
+                               base + entry.col * stride[d], entry.face,
+                               entry.diagonal, entry.weight});
+          points[0].push_back(base);
+          points[1].push_back(base + (m + 1) * stride[d]);
+        }
+    rowsOf[2 * d] = uvec(points[0]);
+    rowsOf[2 * d + 1] = uvec(points[1]);
+  }
+
+  // Column-major pattern of the distinct positions; every entry keeps the
+  // slot it adds into
+  std::vector<uword> order(entries.size());
+  for (uword i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](uword x, uword y) {
+    return entries[x].col != entries[y].col ? entries[x].col < entries[y].col
+                                            : entries[x].row < entries[y].row;
+  });
+
+  std::vector<uword> rowIdx, colCount(total + 1, 0);
+  terms.resize(entries.size());
+  for (uword i = 0; i < order.size(); ++i) {
+    const Entry &entry = entries[order[i]];
+    if (i == 0 || entry.row != entries[order[i - 1]].row ||
+        entry.col != entries[order[i - 1]].col) {
+      rowIdx.push_back(entry.row);
+      ++colCount[entry.col + 1];
+    }
+    terms[i] = {rowIdx.size() - 1, entry.face, entry.diagonal, entry.weight};
+  }
+  for (uword c = 0; c < total; ++c)
+    colCount[c + 1] += colCount[c];
+  rowIndices = uvec(rowIdx);
+  colPointers = uvec(colCount);
+  MOLE_PROFILE_COUNT("nnz", rowIndices.n_elem);
+}
+
+sp_mat BoundaryPlan::build(const FaceBC *conditions, uword count) const {
+  MOLE_PROFILE_SCOPE("BoundaryPlan::build");
+  if (count != faces())
+    throw std::invalid_argument("MOLE: expected " + std::to_string(faces()) +
+                                " face conditions, got " +
+                                std::to_string(count));
+  RobinCoeffs coeffs[6];
+  for (uword f = 0; f < count; ++f) {
+    if (conditions[f].type == BCType::Periodic)
+      throw std::invalid_argument("MOLE: face " + std::to_string(f) +
+                                  " is periodic, but a BoundaryPlan keeps "
+                                  "boundary points on every axis");
+    coeffs[f] = conditions[f].robinCoeffs();
+  }
+
+  vec values(rowIndices.n_elem, fill::zeros);
+  for (const Term &term : terms) {
+    const RobinCoeffs &c = coeffs[term.face];
+    if (term.diagonal)
+      values(term.slot) += c.a;
+    else if (c.b != 0.0)
+      values(term.slot) += c.b * term.weight;
+  }
+
+  // Positions whose coefficients are zero are dropped here
+  return sp_mat(rowIndices, colPointers, values, total, total);
+}
+
+BoundaryData::BoundaryData(const BoundaryPlan &plan,
+                           const std::vector<Real> &origin)
+    : total(plan.size()), coords(plan.faces()) {
+  const std::vector<u32> &cells = plan.cells();
+  const std::vector<Real> &spacing = plan.spacing();
+  const uword dims = cells.size();
+  if (!origin.empty() && origin.size() != dims)
+    throw std::invalid_argument("MOLE: expected an origin with " +
+                                std::to_string(dims) + " coordinates");
+
+  // Point i of an axis: the boundary at 0 and m + 1, cell centers between
+  std::vector<vec> axis(3, vec(1, fill::zeros));
+  for (uword d = 0; d < dims; ++d) {
+    const u32 m = cells[d];
+    const Real start = origin.empty() ? 0.0 : origin[d];
+    vec &c = axis[d];
+    c.set_size(m + 2);
+    c(0) = start;
+    for (u32 i = 1; i <= m; ++i)
+      c(i) = start + (i - 0.5) * spacing[d];
+    c(m + 1) = start + m * spacing[d];
+  }
+
+  const uword nx = axis[0].n_elem, ny = axis[1].n_elem;
+  for (uword f = 0; f < plan.faces(); ++f) {
+    const uvec &r = plan.faceRows(f);
+    rows.push_back(r);
+    for (vec &c : coords[f])
+      c.set_size(r.n_elem);
+    for (uword p = 0; p < r.n_elem; ++p) {
+      coords[f][0](p) = axis[0](r(p) % nx);
+      coords[f][1](p) = axis[1]((r(p) / nx) % ny);
+      coords[f][2](p) = axis[2](r(p) / (nx * ny));
+    }
+  }
+}
+
+void BoundaryData::apply(vec &b, Real t, const Function &g) const {
+  MOLE_PROFILE_SCOPE("BoundaryData::apply");
+  if (b.n_elem != total)
+    throw std::invalid_argument("MOLE: expected a right-hand side of " +
+                                std::to_string(total) + " entries");
+  for (uword f = 0; f < rows.size(); ++f) {
+    const vec values = g(f, coords[f][0], coords[f][1], coords[f][2], t);
+    const uvec &r = rows[f];
+    if (values.n_elem == r.n_elem) {
+      for (uword p = 0; p < r.n_elem; ++p)
+        b(r(p)) = values(p);
+    } else if (values.n_elem == 1) {
+      for (uword p = 0; p < r.n_elem; ++p)
+        b(r(p)) = values(0);
+    } else if (!values.is_empty()) {
+      throw std::invalid_argument(
+          "MOLE: face " + std::to_string(f) + " has " +
+          std::to_string(r.n_elem) + " points, got " +
+          std::to_string(values.n_elem) + " values");
+    }
+  }
+}
+
+sp_mat robinRows(u16 k, const std::vector<u32> &cells,
+                 const std::vector<Real> &spacing,
+                 const std::vector<FaceBC> &faces) {
+  return BoundaryPlan(k, cells, spacing).build(faces);
+}
+
+} // namespace mole
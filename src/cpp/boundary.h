@@ -0,0 +1,254 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file boundary.h
+ *
+ * @brief Boundary rows of Robin-type operators, assembled from triplets
+ *
+ * A boundary operator is a u + b du/dn on the first and last point of every
+ * axis. Its nonzeros are the k + 1 gradient weights of each boundary row
+ * (Gradient::boundaryWeights) plus the diagonal, so the operator is built
+ * straight from those entries: no Gradient, no spkron and no sum of
+ * mostly-empty matrices.
+ *
+ * Faces are described by FaceBC values, and a BoundaryPlan fixes the
+ * sparsity pattern of a grid once, so that operators for other
+ * coefficients are only a pass over the entries:
+ *
+ * @code
+ *   const mole::BoundaryPlan plan(k, {m, n}, {dx, dy});
+ *   for (Real a : candidates) {
+ *     const sp_mat B = plan.build(std::array<mole::FaceBC, 4>{
+ *         mole::robin(a, 1.0), mole::neumann(1.0), mole::dirichlet(),
+ *         mole::dirichlet()});
+ *     ...
+ *   }
+ * @endcode
+ *
+ * BoundaryData writes time-dependent boundary values g(face, x, y, z, t)
+ * into a right-hand side at the same face rows.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef BOUNDARY_H
+#define BOUNDARY_H
+
+#include "gradient.h"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace mole {
+
+/**
+ * @brief a u + b du/dn on one face
+ */
+struct RobinCoeffs {
+  Real a = 0.0; // Dirichlet coefficient
+  Real b = 0.0; // Neumann coefficient
+};
+
+/**
+ * @brief Kind of condition on one face
+ *
+ * Periodic faces have both coefficients zero, as in AddScalarBC.
+ * BoundaryPlan (and so MixedBC) rejects them: its layout keeps the two
+ * boundary points of every axis, which a periodic axis does not have.
+ */
+enum class BCType { Periodic, Dirichlet, Neumann, Robin };
+
+/**
+ * @brief Typed boundary condition of one face
+ *
+ * coeffs follows MixedBC: {a} for Dirichlet, {b} for Neumann and {a, b}
+ * for Robin. Use the factories below rather than filling it by hand.
+ */
+struct FaceBC {
+  BCType type = BCType::Periodic;
+  std::array<Real, 2> coeffs{{0.0, 0.0}};
+
+  constexpr RobinCoeffs robinCoeffs() const {
+    return type == BCType::Dirichlet ? RobinCoeffs{coeffs[0], 0.0}
+           : type == BCType::Neumann ? RobinCoeffs{0.0, coeffs[0]}
+           : type == BCType::Robin   ? RobinCoeffs{coeffs[0], coeffs[1]}
+                                     : RobinCoeffs{0.0, 0.0};
+  }
+};
+
+constexpr FaceBC periodic() { return FaceBC{}; }
+constexpr FaceBC dirichlet(Real a = 1.0) {
+  return FaceBC{BCType::Dirichlet, {{a, 0.0}}};
+}
+constexpr FaceBC neumann(Real b = 1.0) {
+  return FaceBC{BCType::Neumann, {{b, 0.0}}};
+}
+constexpr FaceBC robin(Real a, Real b) {
+  return FaceBC{BCType::Robin, {{a, b}}};
+}
+
+/**
+ * @brief Parses MixedBC's "Dirichlet", "Neumann" and "Robin" names
+ *
+ * @throws std::invalid_argument for any other name, or if coeffs holds
+ *         fewer values than the type needs (one, or two for Robin)
+ */
+FaceBC faceBC(const std::string &type, const std::vector<Real> &coeffs);
+
+/**
+ * @brief Sparsity pattern of the boundary rows of one grid
+ *
+ * Same layout as RobinBC and MixedBC: along x every row of cells gets the
+ * 1-D boundary rows, except the bottom, top, front and back ones; along y
+ * the front and back layers are skipped; along z nothing is.
+ *
+ * The pattern holds the diagonal and the gradient weights of every face.
+ * build() writes the values for given coefficients into it and drops the
+ * zeros, with no sort and no string handling, so one plan serves any
+ * number of boundary conditions on the same grid.
+ */
+class BoundaryPlan {
+public:
+  /**
+   * @param k       Mimetic order of accuracy
+   * @param cells   Cells per axis, x first (1 to 3 axes)
+   * @param spacing Cell width per axis
+   *
+   * @throws std::invalid_argument for a wrong number of axes or spacings,
+   *         or a spacing that is not positive and finite
+   */
+  BoundaryPlan(u16 k, const std::vector<u32> &cells,
+               const std::vector<Real> &spacing);
+
+  /**
+   * @brief Rows (and columns) of the operator, and the number of faces
+   */
+  uword size() const { return total; }
+  uword faces() const { return rowsOf.size(); }
+
+  /**
+   * @brief Grid the plan was made for
+   */
+  const std::vector<u32> &cells() const { return cellCounts; }
+  const std::vector<Real> &spacing() const { return widths; }
+
+  /**
+   * @brief Boundary points of face f (left, right, bottom, top, front,
+   *        back), in increasing order; e.g. b(plan.faceRows(0)) = g
+   */
+  const uvec &faceRows(uword f) const { return rowsOf[f]; }
+
+  /**
+   * @brief Square operator for one condition per face
+   *
+   * @throws std::invalid_argument if there are not faces() conditions or
+   *         one of them is periodic
+   */
+  sp_mat build(const FaceBC *conditions, uword count) const;
+
+  template <std::size_t N>
+  sp_mat build(const std::array<FaceBC, N> &conditions) const {
+    return build(conditions.data(), N);
+  }
+  sp_mat build(const std::vector<FaceBC> &conditions) const {
+    return build(conditions.data(), conditions.size());
+  }
+
+private:
+  // value = a of the face on the diagonal, b times weight elsewhere
+  struct Term {
+    uword slot;
+    uword face;
+    bool diagonal;
+    Real weight;
+  };
+
+  uword total;
+  std::vector<u32> cellCounts;
+  std::vector<Real> widths;
+  uvec rowIndices, colPointers;
+  std::vector<Term> terms;
+  std::vector<uvec> rowsOf;
+};
+
+/**
+ * @brief Time-dependent boundary values written into a right-hand side
+ *
+ * The coordinates of every face's boundary points are computed once; at
+ * each step the callback gets them as whole vectors, and its result goes
+ * straight into b at the plan's face rows.
+ *
+ * @code
+ *   const mole::BoundaryData data(plan);
+ *   for (...) {
+ *     data.apply(b, t, [&](uword face, const vec &x, const vec &y,
+ *                          const vec &, Real t) -> vec {
+ *       if (face == 0) return U0 * sin(omega * t) * (y % (1.0 - y));
+ *       return {0.0};
+ *     });
+ *   }
+ * @endcode
+ */
+class BoundaryData {
+public:
+  /**
+   * @brief Face values from face index, point coordinates and time
+   *
+   * Returns one value per point, a single value for the whole face, or an
+   * empty vector to leave the face untouched.
+   */
+  using Function = std::function<vec(uword face, const vec &x, const vec &y,
+                                     const vec &z, Real t)>;
+
+  /**
+   * @param plan   Grid and face rows; only its layout is kept
+   * @param origin Lower corner of the domain, one entry per axis (zeros if
+   *               empty)
+   */
+  explicit BoundaryData(const BoundaryPlan &plan,
+                        const std::vector<Real> &origin = {});
+
+  uword faces() const { return rows.size(); }
+  const uvec &faceRows(uword f) const { return rows[f]; }
+
+  /**
+   * @brief Coordinates of the boundary points of face f; axes the grid does
+   *        not have are zero
+   */
+  const vec &x(uword f) const { return coords[f][0]; }
+  const vec &y(uword f) const { return coords[f][1]; }
+  const vec &z(uword f) const { return coords[f][2]; }
+
+  /**
+   * @brief b(faceRows(f)) = g(f, x(f), y(f), z(f), t) for every face
+   *
+   * @throws std::invalid_argument if b has not the plan's size or g
+   *         returns a vector of another length
+   */
+  void apply(vec &b, Real t, const Function &g) const;
+
+private:
+  uword total;
+  std::vector<uvec> rows;
+  std::vector<std::array<vec, 3>> coords;
+};
+
+/**
+ * @brief Boundary rows of a 1-D, 2-D or 3-D grid, with a one-off plan
+ *
+ * @param faces One condition per face: left, right, bottom, top, front,
+ *              back (2 per axis)
+ */
+sp_mat robinRows(u16 k, const std::vector<u32> &cells,
+                 const std::vector<Real> &spacing,
+                 const std::vector<FaceBC> &faces);
+
+} // namespace mole
+
+#endif // BOUNDARY_H
@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file csr.cpp
+ *
+ * @brief Row-major mirror of an operator for parallel products
+ *
+ * @date 2026/10/19
+ */
+
+#include "csr.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace mole {
+
+constexpr uword CSR::minPartNnz;
+
+namespace {
+
+// Rows are cut where the running nonzero count crosses a multiple of
+// nnz / parts; start holds rows + 1 offsets
+std::vector<uword> balance(const uword *start, uword rows) {
+  const uword nnz = start[rows];
+  uword parts = 1;
+#ifdef _OPENMP
+  parts = static_cast<uword>(omp_get_max_threads());
+#endif
+  parts = std::max<uword>(1, std::min(parts, nnz / CSR::minPartNnz));
+  std::vector<uword> split(parts + 1);
+  for (uword p = 0; p < parts; ++p)
+    split[p] = std::lower_bound(start, start + rows, nnz * p / parts) - start;
+  split[parts] = rows;
+  return split;
+}
+
+void rowProduct(const uword *ptr, const uword *col, const Real *a,
+                const std::vector<uword> &split, const Real *in, Real *out) {
+  const uword count = split.size() - 1;
+
+  // One row range per iteration; with fewer threads than ranges some
+  // threads take several
+#pragma omp parallel for schedule(static, 1) if (count > 1)
+  for (uword p = 0; p < count; ++p)
+    for (uword r = split[p]; r < split[p + 1]; ++r) {
+      Real sum = 0.0;
+#pragma omp simd reduction(+ : sum)
+      for (uword q = ptr[r]; q < ptr[r + 1]; ++q)
+        sum += a[q] * in[col[q]];
+      out[r] = sum;
+    }
+}
+
+} // namespace
+
+CSR::CSR(const sp_mat &A)
+    : nRows(A.n_rows), nCols(A.n_cols), rowPtr(A.n_rows + 1, fill::zeros),
+      colIdx(A.n_nonzero), val(A.n_nonzero) {
+  MOLE_PROFILE_SCOPE("CSR");
+  A.sync();
+  const uword *ptr = A.col_ptrs;
+  const uword *row = A.row_indices;
+  const Real *values = A.values;
+
+  // Counting sort of the CSC entries by row. Columns are visited in order,
+  // so the columns of every row come out sorted.
+  uword *start = rowPtr.memptr();
+  for (uword p = 0; p < A.n_nonzero; ++p)
+    ++start[row[p] + 1];
+  for (uword r = 0; r < nRows; ++r)
+    start[r + 1] += start[r];
+
+  std::vector<uword> next(start, start + nRows);
+  for (uword c = 0; c < nCols; ++c)
+    for (uword p = ptr[c]; p < ptr[c + 1]; ++p) {
+      const uword q = next[row[p]]++;
+      colIdx(q) = c;
+      val(q) = values[p];
+    }
+
+  split = balance(start, nRows);
+  MOLE_PROFILE_COUNT("nnz", nnz());
+}
+
+CSR::CSR(uword rows, uword cols, uvec rowPtr, uvec colIdx, vec val)
+    : nRows(rows), nCols(cols), rowPtr(std::move(rowPtr)),
+      colIdx(std::move(colIdx)), val(std::move(val)),
+      split(balance(this->rowPtr.memptr(), rows)) {}
+
+CSR CSR::fromTransposed(const sp_mat &At) {
+  MOLE_PROFILE_SCOPE("CSR::fromTransposed");
+  At.sync();
+  return CSR(At.n_cols, At.n_rows,
+             uvec(At.col_ptrs, At.n_cols + 1),
+             uvec(At.row_indices, At.n_nonzero),
+             vec(At.values, At.n_nonzero));
+}
+
+sp_mat CSR::transposeSparse() const {
+  return sp_mat(colIdx, rowPtr, val, nCols, nRows);
+}
+
+sp_mat CSR::toSparse() const {
+  MOLE_PROFILE_SCOPE("CSR::toSparse");
+  return transposeSparse().t();
+}
+
+CSRView CSR::view() const {
+  return CSRView(nRows, nCols, rowPtr.memptr(), colIdx.memptr(),
+                 val.memptr());
+}
+
+void CSR::checkRow(uword r) const {
+  if (r >= nRows)
+    throw std::invalid_argument("MOLE: row " + std::to_string(r) +
+                                " is outside " + std::to_string(nRows) +
+                                " rows");
+}
+
+void CSR::zeroRow(uword r) {
+  checkRow(r);
+  std::fill(val.begin() + rowPtr(r), val.begin() + rowPtr(r + 1), 0.0);
+}
+
+void CSR::scaleRow(uword r, Real s) {
+  checkRow(r);
+  for (uword q = rowPtr(r); q < rowPtr(r + 1); ++q)
+    val(q) *= s;
+}
+
+void CSR::apply(const vec &x, vec &y) const {
+  MOLE_PROFILE_SCOPE("CSR::apply");
+  if (x.n_elem != nCols)
+    throw std::invalid_argument("MOLE: expected a vector of length " +
+                                std::to_string(nCols));
+  if (&x == &y)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  y.set_size(nRows);
+  rowProduct(rowPtr.memptr(), colIdx.memptr(), val.memptr(), split,
+             x.memptr(), y.memptr());
+}
+
+vec CSR::operator*(const vec &x) const {
+  vec y;
+  apply(x, y);
+  return y;
+}
+
+void CSR::apply(const mat &X, mat &Y) const {
+  MOLE_PROFILE_SCOPE("CSR::apply batch");
+  if (X.n_rows != nCols)
+    throw std::invalid_argument("MOLE: expected a batch with " +
+                                std::to_string(nCols) + " rows");
+  if (&X == &Y)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  Y.set_size(nRows, X.n_cols);
+
+  const uword *ptr = rowPtr.memptr();
+  const uword *col = colIdx.memptr();
+  const Real *a = val.memptr();
+  const Real *in = X.memptr();
+  Real *out = Y.memptr();
+  const uword count = parts();
+  const uword batch = X.n_cols;
+
+#pragma omp parallel for schedule(static, 1) if (count > 1)
+  for (uword p = 0; p < count; ++p)
+    for (uword r = split[p]; r < split[p + 1]; ++r)
+      for (uword j0 = 0; j0 < batch; j0 += rhsBlock) {
+        const uword width = std::min(rhsBlock, batch - j0);
+        Real sum[rhsBlock] = {};
+        for (uword q = ptr[r]; q < ptr[r + 1]; ++q) {
+          const Real *x = in + j0 * nCols + col[q];
+          for (uword j = 0; j < width; ++j)
+            sum[j] += a[q] * x[j * nCols];
+        }
+        for (uword j = 0; j < width; ++j)
+          out[(j0 + j) * nRows + r] = sum[j];
+      }
+}
+
+mat CSR::operator*(const mat &X) const {
+  mat Y;
+  apply(X, Y);
+  return Y;
+}
+
+CSRView::CSRView(uword rows, uword cols, const uword *rowPtr,
+                 const uword *colIdx, const Real *val)
+    : nRows(rows), nCols(cols), rowPtr(rowPtr), colIdx(colIdx), val(val),
+      split(balance(rowPtr, rows)) {}
+
+CSRView CSRView::transposeOf(const sp_mat &A) {
+  A.sync();
+  return CSRView(A.n_cols, A.n_rows, A.col_ptrs, A.row_indices, A.values);
+}
+
+void CSRView::apply(const vec &x, vec &y) const {
+  MOLE_PROFILE_SCOPE("CSRView::apply");
+  if (x.n_elem != nCols)
+    throw std::invalid_argument("MOLE: expected a vector of length " +
+                                std::to_string(nCols));
+  if (&x == &y)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  y.set_size(nRows);
+  rowProduct(rowPtr, colIdx, val, split, x.memptr(), y.memptr());
+}
+
+vec CSRView::operator*(const vec &x) const {
+  vec y;
+  apply(x, y);
+  return y;
+}
+
+} // namespace mole
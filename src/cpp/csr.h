@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file csr.h
+ *
+ * @brief Row-major mirror of an operator for parallel products
+ *
+ * sp_mat stores columns, so y = A x in Armadillo scatters into y and runs
+ * on one thread. The mirror stores rows: every y(r) is one independent dot
+ * product, and the rows are split over the OpenMP threads so that each
+ * gets about the same number of nonzeros.
+ *
+ * The CSC arrays of A^T are the CSR arrays of A, so transposes cross
+ * between the two layouts without a sort: CSRView::transposeOf() reads the
+ * rows of A^T straight from an sp_mat A, and CSR::fromTransposed() and
+ * CSR::transposeSparse() copy the arrays as they are.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef CSR_H
+#define CSR_H
+
+#include "utils.h"
+#include <vector>
+
+namespace mole {
+
+class CSRView;
+
+/**
+ * @brief Compressed sparse rows copy of an sp_mat
+ *
+ * Build it once, outside the time loop; it does not follow later changes
+ * to the matrix it was made from.
+ *
+ * @code
+ *   const mole::CSR L(Laplacian(k, m, n, dx, dy));
+ *   for (...) {
+ *     L.apply(u, Lu);
+ *     u += dt * Lu;
+ *   }
+ * @endcode
+ */
+class CSR {
+public:
+  /**
+   * @brief Mirrors A, with its rows split over omp_get_max_threads() parts
+   *
+   * Small matrices get fewer parts, so that no thread works on fewer than
+   * minPartNnz nonzeros.
+   */
+  explicit CSR(const sp_mat &A);
+
+  /**
+   * @brief CSR of A from the sp_mat At = A^T, copying its arrays unsorted
+   */
+  static CSR fromTransposed(const sp_mat &At);
+
+  /**
+   * @brief Back to Armadillo; entries zeroed by row edits are dropped
+   *
+   * toSparse() sorts by column, transposeSparse() returns A^T and only
+   * copies the arrays.
+   */
+  sp_mat toSparse() const;
+  sp_mat transposeSparse() const;
+
+  /**
+   * @brief Non-owning view of the arrays; valid while this CSR lives
+   */
+  CSRView view() const;
+
+  uword rows() const { return nRows; }
+  uword cols() const { return nCols; }
+  uword nnz() const { return val.n_elem; }
+
+  /**
+   * @brief Row pointers (rows() + 1), column indices and values
+   */
+  const uvec &rowPointers() const { return rowPtr; }
+  const uvec &columns() const { return colIdx; }
+  const vec &values() const { return val; }
+
+  /**
+   * @brief Number of row ranges, and the first row of range p
+   *
+   * Range p holds rows [first(p), first(p + 1)).
+   */
+  uword parts() const { return split.size() - 1; }
+  uword first(uword p) const { return split[p]; }
+
+  /**
+   * @brief y = A x, in parallel over the row ranges
+   *
+   * @throws std::invalid_argument if x has not cols() entries or is y
+   */
+  void apply(const vec &x, vec &y) const;
+  vec operator*(const vec &x) const;
+
+  /**
+   * @brief Y = A X for a batch of column vectors
+   *
+   * Each row is read once per mole::rhsBlock columns of X.
+   *
+   * @throws std::invalid_argument if X has not cols() rows or is Y
+   */
+  void apply(const mat &X, mat &Y) const;
+  mat operator*(const mat &X) const;
+
+  /**
+   * @brief Row edits in O(row nnz), e.g. for boundary rows
+   *
+   * The sparsity pattern and the row ranges are kept, so a zeroed row holds
+   * explicit zeros until toSparse().
+   *
+   * @throws std::invalid_argument if r is not below rows()
+   */
+  void zeroRow(uword r);
+  void scaleRow(uword r, Real s);
+
+  /**
+   * @brief Nonzeros below which a matrix is not split further
+   */
+  static constexpr uword minPartNnz = 16384;
+
+private:
+  CSR(uword rows, uword cols, uvec rowPtr, uvec colIdx, vec val);
+
+  void checkRow(uword r) const;
+
+  uword nRows, nCols;
+  uvec rowPtr, colIdx;
+  vec val;
+  std::vector<uword> split;
+};
+
+/**
+ * @brief Compressed sparse rows read from arrays owned elsewhere
+ *
+ * Only the row ranges are computed; the matrix itself is not copied.
+ *
+ * @code
+ *   const sp_mat G = Gradient(k, m, n, dx, dy);
+ *   // G^T f over the rows of G^T, without forming G^T
+ *   const vec Gtf = mole::CSRView::transposeOf(G) * f;
+ * @endcode
+ */
+class CSRView {
+public:
+  /**
+   * @param rowPtr rows + 1 offsets into colIdx and val
+   */
+  CSRView(uword rows, uword cols, const uword *rowPtr, const uword *colIdx,
+          const Real *val);
+
+  /**
+   * @brief Rows of A^T, i.e. the columns of A; A must outlive the view
+   */
+  static CSRView transposeOf(const sp_mat &A);
+
+  uword rows() const { return nRows; }
+  uword cols() const { return nCols; }
+  uword nnz() const { return rowPtr[nRows]; }
+  uword parts() const { return split.size() - 1; }
+
+  const uword *rowPointers() const { return rowPtr; }
+  const uword *columns() const { return colIdx; }
+  const Real *values() const { return val; }
+
+  /**
+   * @brief y = A x, in parallel over nnz-balanced row ranges
+   *
+   * @throws std::invalid_argument if x has not cols() entries or is y
+   */
+  void apply(const vec &x, vec &y) const;
+  vec operator*(const vec &x) const;
+
+private:
+  uword nRows, nCols;
+  const uword *rowPtr, *colIdx;
+  const Real *val;
+  std::vector<uword> split;
+};
+
+} // namespace mole
+
+#endif // CSR_H
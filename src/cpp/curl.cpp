@@ -0,0 +1,287 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file curl.cpp
+ *
+ * @brief Mimetic Curl Operators
+ *
+ * @date 2026/10/19
+ */
+
+#include "curl.h"
+#include "divergence.h"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Moves a field half a cell along one axis (x fastest), updating dims:
+// faces to centers by averaging neighbours, or centers to faces by
+// averaging neighbours and extrapolating linearly at both ends
+vec halfShift(const vec &in, uword dims[3], u16 axis, bool toFaces) {
+  const uword n = dims[axis];
+  const uword stride =
+      axis == 0 ? 1 : (axis == 1 ? dims[0] : dims[0] * dims[1]);
+  const uword outer = in.n_elem / (n * stride);
+  const uword shifted = toFaces ? n + 1 : n - 1;
+  vec out(shifted * stride * outer);
+
+#pragma omp parallel for schedule(static)
+  for (uword o = 0; o < outer; ++o) {
+    for (uword s = 0; s < stride; ++s) {
+      const Real *a = in.memptr() + o * n * stride + s;
+      Real *b = out.memptr() + o * shifted * stride + s;
+      if (toFaces) {
+        b[0] = 1.5 * a[0] - 0.5 * a[stride];
+        for (uword i = 1; i < n; ++i)
+          b[i * stride] = 0.5 * (a[(i - 1) * stride] + a[i * stride]);
+        b[n * stride] = 1.5 * a[(n - 1) * stride] - 0.5 * a[(n - 2) * stride];
+      } else {
+        for (uword i = 0; i + 1 < n; ++i)
+          b[i * stride] = 0.5 * (a[i * stride] + a[(i + 1) * stride]);
+      }
+    }
+  }
+  dims[axis] = shifted;
+  return out;
+}
+
+} // anonymous namespace
+
+CurlKernel::CurlKernel(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  init(k, {m, n}, {dx, dy});
+}
+
+CurlKernel::CurlKernel(u16 k, u32 m, u32 n, u32 o, Real dx,
+                       Real dy, Real dz) {
+  init(k, {m, n, o}, {dx, dy, dz});
+}
+
+void CurlKernel::init(u16 k, const std::vector<u32> &cells,
+                      const std::vector<Real> &spacing) {
+  MOLE_PROFILE_SCOPE("CurlKernel");
+  this->cells = cells;
+  for (size_t a = 0; a < cells.size(); ++a) {
+    // Rows 1..m of the divergence: faces (m+1) to centers (m)
+    const sp_mat D = Divergence(k, cells[a], spacing[a]);
+    axes.push_back(D.rows(1, cells[a]).t());
+  }
+
+  const uword m = cells[0], n = cells[1];
+  std::vector<uword> inputs;
+  if (cells.size() == 2) {
+    // Inputs: u (m, n+1), v (m+1, n), w on the nodes (m+1, n+1)
+    inputs = {m * (n + 1), (m + 1) * n, (m + 1) * (n + 1)};
+    blocks = {{{m + 1, n, 1}, {{1, 2, 1.0}}},
+              {{m, n + 1, 1}, {{0, 2, -1.0}}},
+              {{m, n, 1}, {{0, 1, 1.0}, {1, 0, -1.0}}}};
+  } else {
+    // Inputs: u (m, n+1, o+1), v (m+1, n, o+1), w (m+1, n+1, o)
+    const uword o = cells[2];
+    inputs = {m * (n + 1) * (o + 1), (m + 1) * n * (o + 1),
+              (m + 1) * (n + 1) * o};
+    blocks = {{{m + 1, n, o}, {{1, 2, 1.0}, {2, 1, -1.0}}},
+              {{m, n + 1, o}, {{2, 0, 1.0}, {0, 2, -1.0}}},
+              {{m, n, o + 1}, {{0, 1, 1.0}, {1, 0, -1.0}}}};
+  }
+
+  inStart.assign(1, 0);
+  for (uword size : inputs)
+    inStart.push_back(inStart.back() + size);
+  outStart.assign(1, 0);
+  for (const Block &b : blocks)
+    outStart.push_back(outStart.back() + b.dims[0] * b.dims[1] * b.dims[2]);
+}
+
+void CurlKernel::sweep(const Block &block,
+                       const std::vector<const Real *> &inputs,
+                       Real *out) const {
+  const uword nx = block.dims[0], ny = block.dims[1], nz = block.dims[2];
+
+#pragma omp parallel for schedule(static)
+  for (uword line = 0; line < ny * nz; ++line) {
+    const uword j = line % ny, l = line / ny;
+    Real *y = out + line * nx;
+#pragma omp simd
+    for (uword i = 0; i < nx; ++i)
+      y[i] = 0.0;
+
+    for (const Term &term : block.terms) {
+      const sp_mat &D = axes[term.axis];
+      const uword *ptr = D.col_ptrs;
+      const uword *col = D.row_indices;
+      const Real *val = D.values;
+      const Real *x = inputs[term.input];
+
+      if (term.axis == 0) {
+        // Input lines have nx+1 entries
+        const Real *xl = x + line * (nx + 1);
+        for (uword i = 0; i < nx; ++i) {
+          Real sum = 0.0;
+          for (uword e = ptr[i]; e < ptr[i + 1]; ++e)
+            sum += val[e] * xl[col[e]];
+          y[i] += term.sign * sum;
+        }
+      } else {
+        const uword r = term.axis == 1 ? j : l;
+        for (uword e = ptr[r]; e < ptr[r + 1]; ++e) {
+          const Real c = term.sign * val[e];
+          const Real *xs = term.axis == 1
+                               ? x + (l * (ny + 1) + col[e]) * nx
+                               : x + (col[e] * ny + j) * nx;
+#pragma omp simd
+          for (uword i = 0; i < nx; ++i)
+            y[i] += c * xs[i];
+        }
+      }
+    }
+  }
+}
+
+void CurlKernel::apply(const vec &in, vec &out) const {
+  MOLE_PROFILE_SCOPE("CurlKernel::apply");
+  if (in.n_elem != cols())
+    throw std::invalid_argument("MOLE: expected a vector of length " +
+                                std::to_string(cols()));
+  out.set_size(rows());
+
+  std::vector<const Real *> inputs;
+  for (size_t b = 0; b + 1 < inStart.size(); ++b)
+    inputs.push_back(in.memptr() + inStart[b]);
+  for (size_t b = 0; b < blocks.size(); ++b)
+    sweep(blocks[b], inputs, out.memptr() + outStart[b]);
+}
+
+vec CurlKernel::apply(const vec &in) const {
+  vec out;
+  apply(in, out);
+  return out;
+}
+
+void CurlKernel::vorticity(const vec &u, const vec &v, vec &omega) const {
+  MOLE_PROFILE_SCOPE("CurlKernel::vorticity");
+  if (dimensions() != 2)
+    throw std::invalid_argument("MOLE: 3-D vorticity needs u, v, and w");
+  if (u.n_elem != inStart[1] || v.n_elem != inStart[2] - inStart[1])
+    throw std::invalid_argument("MOLE: u or v does not match the grid");
+
+  // Only the scalar (centers) block, which does not read w
+  const Block &centers = blocks[2];
+  omega.set_size(outStart[3] - outStart[2]);
+  sweep(centers, {u.memptr(), v.memptr(), nullptr}, omega.memptr());
+}
+
+void CurlKernel::vorticity(const vec &u, const vec &v, const vec &w,
+                           vec &omega) const {
+  MOLE_PROFILE_SCOPE("CurlKernel::vorticity");
+  if (dimensions() != 3)
+    throw std::invalid_argument("MOLE: 2-D vorticity takes u and v only");
+  if (u.n_elem != inStart[1] || v.n_elem != inStart[2] - inStart[1] ||
+      w.n_elem != inStart[3] - inStart[2])
+    throw std::invalid_argument("MOLE: u, v, or w does not match the grid");
+
+  omega.set_size(rows());
+  const std::vector<const Real *> inputs = {u.memptr(), v.memptr(),
+                                            w.memptr()};
+  for (size_t b = 0; b < blocks.size(); ++b)
+    sweep(blocks[b], inputs, omega.memptr() + outStart[b]);
+}
+
+void CurlKernel::vorticity(const vec &faces, vec &omega) const {
+  MOLE_PROFILE_SCOPE("CurlKernel::vorticity");
+  const uword dims = cells.size();
+  const uword m = cells[0], n = cells[1], o = dims == 3 ? cells[2] : 1;
+  // Component c is normal to the faces of axis c: one more point along c
+  const uword total = dims == 2 ? (m + 1) * n + m * (n + 1)
+                                : (m + 1) * n * o + m * (n + 1) * o +
+                                      m * n * (o + 1);
+  if (faces.n_elem != total)
+    throw std::invalid_argument("MOLE: expected " + std::to_string(total) +
+                                " face values in the Gradient layout");
+
+  std::vector<vec> edges(dims);
+  uword start = 0;
+  for (u16 c = 0; c < dims; ++c) {
+    uword size[3] = {m, n, o};
+    ++size[c];
+    const uword count = size[0] * size[1] * size[2];
+    vec component = halfShift(faces.subvec(start, start + count - 1), size,
+                              c, false);
+    for (u16 a = 0; a < dims; ++a)
+      if (a != c)
+        component = halfShift(component, size, a, true);
+    edges[c] = std::move(component);
+    start += count;
+  }
+
+  if (dims == 2)
+    vorticity(edges[0], edges[1], omega);
+  else
+    vorticity(edges[0], edges[1], edges[2], omega);
+}
+
+Curl::Curl(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  MOLE_PROFILE_SCOPE("Curl 2-D");
+  assemble(CurlKernel(k, m, n, dx, dy));
+}
+
+Curl::Curl(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  MOLE_PROFILE_SCOPE("Curl 3-D");
+  assemble(CurlKernel(k, m, n, o, dx, dy, dz));
+}
+
+Curl::Curl(const CurlKernel &kernel) {
+  MOLE_PROFILE_SCOPE("Curl");
+  assemble(kernel);
+}
+
+void Curl::assemble(const CurlKernel &kernel) {
+  uword nnz = 0;
+  for (const CurlKernel::Block &b : kernel.blocks)
+    for (const CurlKernel::Term &t : b.terms)
+      nnz += b.dims[0] * b.dims[1] * b.dims[2] / b.dims[t.axis] *
+             kernel.axes[t.axis].n_nonzero;
+  umat locations(2, nnz);
+  vec values(nnz);
+
+  // Each term repeats the 1-D stencil on every line along its axis
+  uword offset = 0;
+  for (size_t b = 0; b < kernel.blocks.size(); ++b) {
+    const CurlKernel::Block &block = kernel.blocks[b];
+    for (const CurlKernel::Term &term : block.terms) {
+      const sp_mat &D = kernel.axes[term.axis];
+      const uword L = block.dims[term.axis], per = D.n_nonzero;
+      uword stride = 1;
+      for (u16 a = 0; a < term.axis; ++a)
+        stride *= block.dims[a];
+      const uword lines = block.dims[0] * block.dims[1] * block.dims[2] / L;
+      const uword row0 = kernel.outStart[b];
+      const uword col0 = kernel.inStart[term.input];
+
+#pragma omp parallel for schedule(static)
+      for (uword line = 0; line < lines; ++line) {
+        const uword lo = line % stride, hi = line / stride;
+        uword e = offset + line * per;
+        for (uword r = 0; r < L; ++r) {
+          for (uword p = D.col_ptrs[r]; p < D.col_ptrs[r + 1]; ++p) {
+            locations(0, e) = row0 + lo + stride * (r + L * hi);
+            locations(1, e) = col0 + lo + stride * (D.row_indices[p] +
+                                                    (L + 1) * hi);
+            values(e) = term.sign * D.values[p];
+            ++e;
+          }
+        }
+      }
+      offset += lines * per;
+    }
+  }
+
+  *this = sp_mat(locations, values, kernel.rows(), kernel.cols());
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
@@ -0,0 +1,182 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file curl.h
+ *
+ * @brief Mimetic Curl Operators
+ *
+ * The C++ counterpart of curl2D.m, extended to 3-D. Derivatives are the
+ * interior rows of the 1-D mimetic divergence, so div(curl) vanishes at
+ * every interior cell.
+ *
+ * Field components are tangential: in 3-D they live on cell edges
+ * (u on x-edges, m x (n+1) x (o+1), v on y-edges, w on z-edges) and the
+ * curl lands on the faces of the Gradient layout. In 2-D the edges are
+ * the faces (u on horizontal faces, v on vertical faces) plus a scalar w
+ * on the nodes, and the scalar curl lands on the cell centers.
+ *
+ * These are not the face velocities of Gradient and Divergence, where u is
+ * normal to the x-faces ((m+1) x n) and v normal to the y-faces
+ * (m x (n+1)). CurlKernel::vorticity(faces, omega) takes that layout and
+ * moves each component half a cell along every other axis first.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef CURL_H
+#define CURL_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Curl applied without assembling the operator
+ *
+ * Every output line is computed in one sweep that fuses both of its
+ * derivative terms. Along y and z whole x-lines are combined, so the
+ * innermost loops are unit-stride. Suitable inside time loops: no sparse
+ * matrix is built and no temporaries are allocated.
+ */
+class CurlKernel {
+public:
+  /**
+   * @brief 2-D curl kernel (curl2D)
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of cells along x
+   * @param n  Number of cells along y
+   * @param dx Step size along x
+   * @param dy Step size along y
+   */
+  CurlKernel(u16 k, u32 m, u32 n, Real dx, Real dy);
+
+  /**
+   * @brief 3-D curl kernel
+   *
+   * @param o  Number of cells along z
+   * @param dz Step size along z
+   */
+  CurlKernel(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Number of dimensions (2 or 3)
+   */
+  u16 dimensions() const { return static_cast<u16>(axes.size()); }
+
+  /**
+   * @brief Rows and columns of the equivalent assembled operator
+   */
+  uword rows() const { return outStart.back(); }
+  uword cols() const { return inStart.back(); }
+
+  /**
+   * @brief out = C * in
+   *
+   * @param in  2-D: [u; v; w], 3-D: [u; v; w] on the edges
+   * @param out 2-D: [x-faces; y-faces; centers], 3-D: [x-; y-; z-faces]
+   */
+  void apply(const vec &in, vec &out) const;
+  vec apply(const vec &in) const;
+
+  /**
+   * @brief 2-D vorticity dv/dx - du/dy at the m x n cell centers
+   *
+   * @param u x-velocity on the horizontal faces, m x (n+1), x fastest
+   * @param v y-velocity on the vertical faces, (m+1) x n, x fastest
+   */
+  void vorticity(const vec &u, const vec &v, vec &omega) const;
+
+  /**
+   * @brief 3-D vorticity, [x-faces; y-faces; z-faces]
+   *
+   * @param u, v, w Velocity components on the x-, y- and z-edges
+   */
+  void vorticity(const vec &u, const vec &v, const vec &w,
+                 vec &omega) const;
+
+  /**
+   * @brief Vorticity of the face velocities of the Gradient layout
+   *
+   * faces is [u on the x-faces; v on the y-faces (; w on the z-faces)], as
+   * G * p or a Projection produce. Each component is averaged to the cell
+   * centers along its own axis, then to the edges along the others, with
+   * linear extrapolation at the boundary. This is second-order accurate
+   * whatever k is, and it allocates the moved components.
+   *
+   * @param omega 2-D: m x n cell centers, 3-D: [x-faces; y-faces; z-faces]
+   */
+  void vorticity(const vec &faces, vec &omega) const;
+
+private:
+  friend class Curl;
+
+  // One derivative term of an output block: sign * d/dx_axis (input)
+  struct Term {
+    u16 axis;
+    u16 input;
+    Real sign;
+  };
+
+  struct Block {
+    uword dims[3];
+    std::vector<Term> terms;
+  };
+
+  std::vector<u32> cells;
+  std::vector<sp_mat> axes; // interior divergence rows, transposed
+  std::vector<Block> blocks;
+  std::vector<uword> inStart, outStart;
+
+  void init(u16 k, const std::vector<u32> &cells,
+            const std::vector<Real> &spacing);
+  void sweep(const Block &block, const std::vector<const Real *> &inputs,
+             Real *out) const;
+};
+
+/**
+ * @brief Mimetic Curl operators
+ *
+ * The assembled form of CurlKernel; see curl.h for the layouts.
+ */
+class Curl : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief 2-D Mimetic Curl Constructor
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of cells along x
+   * @param n  Number of cells along y
+   * @param dx Step size along x
+   * @param dy Step size along y
+   */
+  Curl(u16 k, u32 m, u32 n, Real dx, Real dy);
+
+  /**
+   * @brief 3-D Mimetic Curl Constructor
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of cells along x
+   * @param n  Number of cells along y
+   * @param o  Number of cells along z
+   * @param dx Step size along x
+   * @param dy Step size along y
+   * @param dz Step size along z
+   */
+  Curl(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Assembles the operator a kernel applies
+   */
+  explicit Curl(const CurlKernel &kernel);
+
+private:
+  void assemble(const CurlKernel &kernel);
+};
+
+#endif // CURL_H
@@ -0,0 +1,672 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file distributed.cpp
+ *
+ * @brief Domain-decomposed operators with halo exchange
+ *
+ * @date 2026/10/19
+ */
+
+#include "distributed.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "interpol.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace mole {
+
+namespace {
+
+// Part c of s items split over p parts starts here; the first s % p parts
+// get one item more
+uword blockStart(uword s, int p, int c) {
+  return (s / p) * c + std::min<uword>(c, s % p);
+}
+
+int blockOwner(uword s, int p, uword i) {
+  const uword q = s / p, r = s % p, big = r * (q + 1);
+  return static_cast<int>(i < big ? i / (q + 1) : r + (i - big) / q);
+}
+
+// s x (s+2), picks the interior centers
+sp_mat injection(u32 s) {
+  sp_mat J(s, s + 2);
+  for (u32 i = 0; i < s; ++i)
+    J(i, i + 1) = 1.0;
+  return J;
+}
+
+sp_mat secondDerivative(u16 k, u32 s, Real h) {
+  const sp_mat D = Divergence(k, s, h), G = Gradient(k, s, h);
+  return D * G;
+}
+
+void requireDimensions(const Decomposition &d, u16 dims) {
+  if (d.dimensions() != dims)
+    throw std::invalid_argument("MOLE: expected a " + std::to_string(dims) +
+                                "-D decomposition");
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Communicator
+// ============================================================================
+
+Communicator::Communicator() {
+#ifdef MOLE_USE_MPI
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (!initialized)
+    throw std::runtime_error("MOLE: MPI_Init must be called before creating "
+                             "a Communicator");
+  comm = MPI_COMM_WORLD;
+  MPI_Comm_rank(comm, &id);
+  MPI_Comm_size(comm, &count);
+#endif
+}
+
+#ifdef MOLE_USE_MPI
+Communicator::Communicator(MPI_Comm comm) : comm(comm) {
+  MPI_Comm_rank(comm, &id);
+  MPI_Comm_size(comm, &count);
+}
+#endif
+
+Real Communicator::sum(Real value) const {
+#ifdef MOLE_USE_MPI
+  Real total = 0.0;
+  MPI_Allreduce(&value, &total, 1, MPI_DOUBLE, MPI_SUM, comm);
+  return total;
+#else
+  return value;
+#endif
+}
+
+// ============================================================================
+// Decomposition
+// ============================================================================
+
+Decomposition::Decomposition(const Communicator &comm, u32 m, u32 n)
+    : comm(std::make_shared<const Communicator>(comm)) {
+  init(comm.rank(), comm.size(), {m, n});
+}
+
+Decomposition::Decomposition(const Communicator &comm, u32 m, u32 n, u32 o)
+    : comm(std::make_shared<const Communicator>(comm)) {
+  init(comm.rank(), comm.size(), {m, n, o});
+}
+
+Decomposition::Decomposition(int rank, int size, u32 m, u32 n) {
+  init(rank, size, {m, n});
+}
+
+Decomposition::Decomposition(int rank, int size, u32 m, u32 n, u32 o) {
+  init(rank, size, {m, n, o});
+}
+
+void Decomposition::init(int rank, int size, const std::vector<u32> &cells) {
+  if (size < 1 || rank < 0 || rank >= size)
+    throw std::invalid_argument("MOLE: rank must be in [0, size)");
+  dims = static_cast<u16>(cells.size());
+  id = rank;
+  count = size;
+  for (u16 a = 0; a < dims; ++a)
+    global[a] = cells[a];
+
+  // Rank grid with the smallest box surface
+  Real best = std::numeric_limits<Real>::infinity();
+  for (int px = 1; px <= size; ++px) {
+    if (size % px)
+      continue;
+    for (int py = 1; py <= size / px; ++py) {
+      if ((size / px) % py)
+        continue;
+      const std::array<int, 3> p{{px, py, size / px / py}};
+      if (dims == 2 && p[2] != 1)
+        continue;
+      bool fits = true;
+      std::array<Real, 3> e;
+      for (u16 a = 0; a < 3; ++a) {
+        fits = fits && static_cast<u32>(p[a]) <= global[a];
+        e[a] = static_cast<Real>(global[a]) / p[a];
+      }
+      const Real surface = e[0] * e[1] + e[1] * e[2] + e[0] * e[2];
+      if (fits && surface < best) {
+        best = surface;
+        grid = p;
+      }
+    }
+  }
+  if (best == std::numeric_limits<Real>::infinity())
+    throw std::invalid_argument("MOLE: cannot split the grid into " +
+                                std::to_string(size) +
+                                " boxes of at least one cell");
+
+  at[0] = rank % grid[0];
+  at[1] = (rank / grid[0]) % grid[1];
+  at[2] = rank / (grid[0] * grid[1]);
+}
+
+u32 Decomposition::begin(u16 axis) const {
+  return static_cast<u32>(blockStart(global[axis], grid[axis], at[axis]));
+}
+
+u32 Decomposition::end(u16 axis) const {
+  return static_cast<u32>(blockStart(global[axis], grid[axis], at[axis] + 1));
+}
+
+uword Decomposition::pointsBegin(u16 axis, u16 extra, int c) const {
+  if (c == 0)
+    return 0;
+  if (c == grid[axis])
+    return global[axis] + extra;
+  // Centers are shifted by the boundary point in front of them
+  return blockStart(global[axis], grid[axis], c) + (extra == 2 ? 1 : 0);
+}
+
+uword Decomposition::pointsBegin(u16 axis, u16 extra) const {
+  return pointsBegin(axis, extra, at[axis]);
+}
+
+uword Decomposition::pointsEnd(u16 axis, u16 extra) const {
+  return pointsBegin(axis, extra, at[axis] + 1);
+}
+
+int Decomposition::owner(const std::array<u16, 3> &extra,
+                         const std::array<uword, 3> &point) const {
+  int rank = 0;
+  for (int a = 2; a >= 0; --a) {
+    const uword s = global[a];
+    uword cell = point[a];
+    if (extra[a] == 2)
+      cell = cell == 0 ? 0 : cell - 1;
+    cell = std::min(cell, s - 1);
+    rank = rank * grid[a] + blockOwner(s, grid[a], cell);
+  }
+  return rank;
+}
+
+// ============================================================================
+// DistributedOperator
+// ============================================================================
+
+// Concatenated point sets (one per field), each a box of x-fastest points
+struct DistributedOperator::Layout {
+  using Point = std::array<uword, 3>;
+
+  std::vector<std::array<u16, 3>> extra;
+  std::vector<Point> size, lo, hi;
+  std::vector<uword> globalStart{0}, localStart{0};
+
+  Layout(const Decomposition &d, const std::vector<std::array<u16, 3>> &fields)
+      : extra(fields) {
+    for (const auto &e : fields) {
+      Point s, l, h;
+      for (u16 a = 0; a < 3; ++a) {
+        s[a] = d.cells(a) + e[a];
+        l[a] = d.pointsBegin(a, e[a]);
+        h[a] = d.pointsEnd(a, e[a]);
+      }
+      size.push_back(s);
+      lo.push_back(l);
+      hi.push_back(h);
+      globalStart.push_back(globalStart.back() + s[0] * s[1] * s[2]);
+      localStart.push_back(localStart.back() +
+                           (h[0] - l[0]) * (h[1] - l[1]) * (h[2] - l[2]));
+    }
+  }
+
+  uword global(size_t f, const Point &p) const {
+    return globalStart[f] + p[0] + size[f][0] * (p[1] + size[f][1] * p[2]);
+  }
+
+  bool owns(size_t f, const Point &p) const {
+    return p[0] >= lo[f][0] && p[0] < hi[f][0] && p[1] >= lo[f][1] &&
+           p[1] < hi[f][1] && p[2] >= lo[f][2] && p[2] < hi[f][2];
+  }
+
+  uword local(size_t f, const Point &p) const {
+    const uword w0 = hi[f][0] - lo[f][0], w1 = hi[f][1] - lo[f][1];
+    return localStart[f] + (p[0] - lo[f][0]) +
+           w0 * ((p[1] - lo[f][1]) + w1 * (p[2] - lo[f][2]));
+  }
+
+  void locate(uword g, size_t &f, Point &p) const {
+    f = std::upper_bound(globalStart.begin(), globalStart.end(), g) -
+        globalStart.begin() - 1;
+    uword r = g - globalStart[f];
+    p[0] = r % size[f][0];
+    r /= size[f][0];
+    p[1] = r % size[f][1];
+    p[2] = r / size[f][1];
+  }
+
+  // Global indices of the owned points, in local order
+  uvec owned() const {
+    uvec g(localStart.back());
+    uword q = 0;
+    for (size_t f = 0; f < extra.size(); ++f)
+      for (uword z = lo[f][2]; z < hi[f][2]; ++z)
+        for (uword y = lo[f][1]; y < hi[f][1]; ++y)
+          for (uword x = lo[f][0]; x < hi[f][0]; ++x)
+            g(q++) = global(f, {{x, y, z}});
+    return g;
+  }
+};
+
+// Block (out, in) += kron(factors[2], factors[1], factors[0])
+struct DistributedOperator::Term {
+  size_t out, in;
+  std::array<sp_mat, 3> factors;
+};
+
+DistributedOperator DistributedOperator::gradient(u16 k, const Decomposition &d,
+                                                  Real dx, Real dy) {
+  requireDimensions(d, 2);
+  return staggered(d, Kind::CentersToFaces,
+                   {Gradient(k, d.cells(0), dx), Gradient(k, d.cells(1), dy)});
+}
+
+DistributedOperator DistributedOperator::gradient(u16 k, const Decomposition &d,
+                                                  Real dx, Real dy, Real dz) {
+  requireDimensions(d, 3);
+  return staggered(d, Kind::CentersToFaces,
+                   {Gradient(k, d.cells(0), dx), Gradient(k, d.cells(1), dy),
+                    Gradient(k, d.cells(2), dz)});
+}
+
+DistributedOperator DistributedOperator::divergence(u16 k,
+                                                    const Decomposition &d,
+                                                    Real dx, Real dy) {
+  requireDimensions(d, 2);
+  return staggered(
+      d, Kind::FacesToCenters,
+      {Divergence(k, d.cells(0), dx), Divergence(k, d.cells(1), dy)});
+}
+
+DistributedOperator DistributedOperator::divergence(u16 k,
+                                                    const Decomposition &d,
+                                                    Real dx, Real dy,
+                                                    Real dz) {
+  requireDimensions(d, 3);
+  return staggered(
+      d, Kind::FacesToCenters,
+      {Divergence(k, d.cells(0), dx), Divergence(k, d.cells(1), dy),
+       Divergence(k, d.cells(2), dz)});
+}
+
+// L = D G = sum over the axes of kron(..., D_a G_a, ...), with J'J on the
+// other axes
+DistributedOperator DistributedOperator::laplacian(u16 k,
+                                                   const Decomposition &d,
+                                                   Real dx, Real dy) {
+  requireDimensions(d, 2);
+  return staggered(d, Kind::CentersToCenters,
+                   {secondDerivative(k, d.cells(0), dx),
+                    secondDerivative(k, d.cells(1), dy)});
+}
+
+DistributedOperator DistributedOperator::laplacian(u16 k,
+                                                   const Decomposition &d,
+                                                   Real dx, Real dy, Real dz) {
+  requireDimensions(d, 3);
+  return staggered(d, Kind::CentersToCenters,
+                   {secondDerivative(k, d.cells(0), dx),
+                    secondDerivative(k, d.cells(1), dy),
+                    secondDerivative(k, d.cells(2), dz)});
+}
+
+DistributedOperator DistributedOperator::interpol(const Decomposition &d,
+                                                  Real c1, Real c2) {
+  requireDimensions(d, 2);
+  return staggered(d, Kind::CentersToFaces,
+                   {Interpol(d.cells(0), c1), Interpol(d.cells(1), c2)});
+}
+
+DistributedOperator DistributedOperator::interpol(const Decomposition &d,
+                                                  Real c1, Real c2, Real c3) {
+  requireDimensions(d, 3);
+  return staggered(d, Kind::CentersToFaces,
+                   {Interpol(d.cells(0), c1), Interpol(d.cells(1), c2),
+                    Interpol(d.cells(2), c3)});
+}
+
+DistributedOperator DistributedOperator::interpol(bool type,
+                                                  const Decomposition &d,
+                                                  Real c1, Real c2) {
+  requireDimensions(d, 2);
+  return staggered(
+      d, Kind::FacesToCenters,
+      {Interpol(type, d.cells(0), c1), Interpol(type, d.cells(1), c2)});
+}
+
+DistributedOperator DistributedOperator::interpol(bool type,
+                                                  const Decomposition &d,
+                                                  Real c1, Real c2, Real c3) {
+  requireDimensions(d, 3);
+  return staggered(
+      d, Kind::FacesToCenters,
+      {Interpol(type, d.cells(0), c1), Interpol(type, d.cells(1), c2),
+       Interpol(type, d.cells(2), c3)});
+}
+
+// One term per axis: the 1-D operator along it, and the interior
+// injection J (or J', J'J) along the others, as the global constructors
+// combine them
+DistributedOperator
+DistributedOperator::staggered(const Decomposition &d, Kind kind,
+                               const std::vector<sp_mat> &along) {
+  const u16 dims = d.dimensions();
+  const std::vector<std::array<u16, 3>> centers{
+      {{2, 2, static_cast<u16>(dims == 3 ? 2 : 0)}}};
+  std::vector<std::array<u16, 3>> faces;
+  for (u16 a = 0; a < dims; ++a) {
+    std::array<u16, 3> e{{0, 0, 0}};
+    e[a] = 1;
+    faces.push_back(e);
+  }
+
+  std::vector<Term> terms;
+  for (u16 a = 0; a < dims; ++a) {
+    Term t;
+    t.out = kind == Kind::CentersToFaces ? a : 0;
+    t.in = kind == Kind::FacesToCenters ? a : 0;
+    for (u16 b = 0; b < 3; ++b) {
+      if (b >= dims) {
+        t.factors[b] = speye(1, 1);
+      } else if (b == a) {
+        t.factors[b] = along[a];
+      } else {
+        const sp_mat J = injection(d.cells(b));
+        if (kind == Kind::CentersToFaces)
+          t.factors[b] = J;
+        else if (kind == Kind::FacesToCenters)
+          t.factors[b] = J.t();
+        else
+          t.factors[b] = J.t() * J;
+      }
+    }
+    terms.push_back(t);
+  }
+
+  const Layout atCenters(d, centers), atFaces(d, faces);
+  return DistributedOperator(
+      d, kind == Kind::CentersToFaces ? atFaces : atCenters,
+      kind == Kind::FacesToCenters ? atFaces : atCenters, terms);
+}
+
+DistributedOperator::DistributedOperator(const Decomposition &d,
+                                         const Layout &out, const Layout &in,
+                                         const std::vector<Term> &terms)
+    : decomposition(d) {
+  MOLE_PROFILE_SCOPE("DistributedOperator");
+  rowIndex = out.owned();
+  colIndex = in.owned();
+  const uword nRows = rowIndex.n_elem, nOwned = colIndex.n_elem;
+
+  // Rows of the 1-D factors, and where each term's rows start in the
+  // triplets: the nonzeros of a row are the product of its factors'
+  std::vector<std::array<sp_mat, 3>> rowsOf(terms.size());
+  std::vector<std::vector<uword>> start(terms.size());
+  uword nnz = 0;
+  for (size_t t = 0; t < terms.size(); ++t) {
+    const Term &term = terms[t];
+    for (u16 a = 0; a < 3; ++a)
+      rowsOf[t][a] = term.factors[a].t();
+    const Layout::Point &lo = out.lo[term.out], &hi = out.hi[term.out];
+    const uword w0 = hi[0] - lo[0], w1 = hi[1] - lo[1];
+    const uword count = out.localStart[term.out + 1] - out.localStart[term.out];
+    std::vector<uword> &s = start[t];
+    s.resize(count + 1);
+    s[0] = nnz;
+    for (uword r = 0; r < count; ++r) {
+      const Layout::Point p{{lo[0] + r % w0, lo[1] + (r / w0) % w1,
+                             lo[2] + r / (w0 * w1)}};
+      uword row = 1;
+      for (u16 a = 0; a < 3; ++a)
+        row *= rowsOf[t][a].col_ptrs[p[a] + 1] - rowsOf[t][a].col_ptrs[p[a]];
+      s[r + 1] = s[r] + row;
+    }
+    nnz = s[count];
+  }
+
+  // Owned columns get their local index; the others keep their global one
+  // until the ghosts are numbered
+  umat locations(2, nnz);
+  vec values(nnz);
+  std::vector<char> ghost(nnz);
+  for (size_t t = 0; t < terms.size(); ++t) {
+    const Term &term = terms[t];
+    const sp_mat &X = rowsOf[t][0], &Y = rowsOf[t][1], &Z = rowsOf[t][2];
+    const Layout::Point &lo = out.lo[term.out], &hi = out.hi[term.out];
+    const uword w0 = hi[0] - lo[0], w1 = hi[1] - lo[1];
+    const uword count = start[t].size() - 1;
+    const uword *s = start[t].data();
+
+#pragma omp parallel for schedule(static)
+    for (uword r = 0; r < count; ++r) {
+      const Layout::Point p{{lo[0] + r % w0, lo[1] + (r / w0) % w1,
+                             lo[2] + r / (w0 * w1)}};
+      const uword row = out.localStart[term.out] + r;
+      uword q = s[r];
+      for (uword pz = Z.col_ptrs[p[2]]; pz < Z.col_ptrs[p[2] + 1]; ++pz)
+        for (uword py = Y.col_ptrs[p[1]]; py < Y.col_ptrs[p[1] + 1]; ++py)
+          for (uword px = X.col_ptrs[p[0]]; px < X.col_ptrs[p[0] + 1]; ++px) {
+            const Layout::Point c{
+                {X.row_indices[px], Y.row_indices[py], Z.row_indices[pz]}};
+            const bool owned = in.owns(term.in, c);
+            locations(0, q) =
+                owned ? in.local(term.in, c) : in.global(term.in, c);
+            locations(1, q) = row;
+            values(q) = X.values[px] * Y.values[py] * Z.values[pz];
+            ghost[q] = !owned;
+            ++q;
+          }
+    }
+  }
+
+  // Ghosts are grouped by owner so that each rank's arrive contiguously
+  std::vector<uword> wanted;
+  for (uword q = 0; q < nnz; ++q)
+    if (ghost[q])
+      wanted.push_back(locations(0, q));
+  std::sort(wanted.begin(), wanted.end());
+  wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+
+  std::vector<std::pair<int, uword>> byOwner(wanted.size());
+  for (size_t i = 0; i < wanted.size(); ++i) {
+    size_t f;
+    Layout::Point p;
+    in.locate(wanted[i], f, p);
+    byOwner[i] = {d.owner(in.extra[f], p), wanted[i]};
+  }
+  std::sort(byOwner.begin(), byOwner.end());
+
+  ghostIndex.set_size(byOwner.size());
+  std::vector<std::pair<uword, uword>> slot(byOwner.size());
+  for (size_t i = 0; i < byOwner.size(); ++i) {
+    if (recvRanks.empty() || recvRanks.back() != byOwner[i].first) {
+      recvRanks.push_back(byOwner[i].first);
+      recvStart.push_back(i);
+    }
+    ghostIndex(i) = byOwner[i].second;
+    slot[i] = {byOwner[i].second, nOwned + i};
+  }
+  recvStart.push_back(byOwner.size());
+  std::sort(slot.begin(), slot.end());
+
+#pragma omp parallel for schedule(static)
+  for (uword q = 0; q < nnz; ++q)
+    if (ghost[q])
+      locations(0, q) =
+          std::lower_bound(slot.begin(), slot.end(),
+                           std::make_pair(locations(0, q), uword(0)))
+              ->second;
+
+  // Terms may share entries (the diagonal of the Laplacian), so add them
+  byRows = sp_mat(true, locations, values, nOwned + ghostIndex.n_elem, nRows);
+
+  for (uword r = 0; r < nRows; ++r) {
+    bool needsHalo = false;
+    for (uword p = byRows.col_ptrs[r]; p < byRows.col_ptrs[r + 1]; ++p)
+      needsHalo = needsHalo || byRows.row_indices[p] >= nOwned;
+    (needsHalo ? halo : interior).push_back(r);
+  }
+
+  ghostValues.set_size(ghostIndex.n_elem);
+  connect(in);
+  MOLE_PROFILE_COUNT("nnz", byRows.n_nonzero);
+}
+
+// Every rank tells the owners of its ghosts which entries it needs, once
+void DistributedOperator::connect(const Layout &in) {
+  const Communicator *comm = decomposition.communicator();
+  if (comm == nullptr || comm->size() == 1)
+    return;
+#ifdef MOLE_USE_MPI
+  const int size = comm->size();
+  std::vector<int> want(size, 0), give(size, 0);
+  for (size_t i = 0; i < recvRanks.size(); ++i)
+    want[recvRanks[i]] = static_cast<int>(recvStart[i + 1] - recvStart[i]);
+  MPI_Alltoall(want.data(), 1, MPI_INT, give.data(), 1, MPI_INT,
+               comm->handle());
+
+  sendStart.assign(1, 0);
+  for (int r = 0; r < size; ++r)
+    if (give[r] > 0) {
+      sendRanks.push_back(r);
+      sendStart.push_back(sendStart.back() + give[r]);
+    }
+
+  std::vector<unsigned long long> asked(sendStart.back());
+  std::vector<unsigned long long> told(ghostIndex.begin(), ghostIndex.end());
+  requests.resize(recvRanks.size() + sendRanks.size());
+  size_t q = 0;
+  for (size_t i = 0; i < sendRanks.size(); ++i)
+    MPI_Irecv(asked.data() + sendStart[i], give[sendRanks[i]],
+              MPI_UNSIGNED_LONG_LONG, sendRanks[i], 0, comm->handle(),
+              &requests[q++]);
+  for (size_t i = 0; i < recvRanks.size(); ++i)
+    MPI_Isend(told.data() + recvStart[i], want[recvRanks[i]],
+              MPI_UNSIGNED_LONG_LONG, recvRanks[i], 0, comm->handle(),
+              &requests[q++]);
+  MPI_Waitall(static_cast<int>(q), requests.data(), MPI_STATUSES_IGNORE);
+
+  sendIndex.set_size(asked.size());
+  for (size_t i = 0; i < asked.size(); ++i) {
+    size_t f;
+    Layout::Point p;
+    in.locate(asked[i], f, p);
+    sendIndex(i) = in.local(f, p);
+  }
+  sendBuffer.set_size(asked.size());
+#else
+  (void)in;
+#endif
+}
+
+// Starts the halo exchange: receives into the ghosts, sends the owned
+// entries other ranks need
+void DistributedOperator::post(const vec &in) const {
+  if (ghostIndex.is_empty() && sendRanks.empty())
+    return;
+  const Communicator *comm = decomposition.communicator();
+  if (comm == nullptr || comm->size() == 1)
+    throw std::runtime_error("MOLE: this operator needs a halo, but its "
+                             "decomposition has no communicator");
+#ifdef MOLE_USE_MPI
+  size_t q = 0;
+  for (size_t i = 0; i < recvRanks.size(); ++i)
+    MPI_Irecv(ghostValues.memptr() + recvStart[i],
+              static_cast<int>(recvStart[i + 1] - recvStart[i]), MPI_DOUBLE,
+              recvRanks[i], 1, comm->handle(), &requests[q++]);
+
+  const Real *x = in.memptr();
+  const uword *index = sendIndex.memptr();
+  Real *buffer = sendBuffer.memptr();
+  const uword count = sendIndex.n_elem;
+#pragma omp parallel for schedule(static)
+  for (uword i = 0; i < count; ++i)
+    buffer[i] = x[index[i]];
+
+  for (size_t i = 0; i < sendRanks.size(); ++i)
+    MPI_Isend(buffer + sendStart[i],
+              static_cast<int>(sendStart[i + 1] - sendStart[i]), MPI_DOUBLE,
+              sendRanks[i], 1, comm->handle(), &requests[q++]);
+#else
+  (void)in;
+#endif
+}
+
+void DistributedOperator::wait() const {
+#ifdef MOLE_USE_MPI
+  if (!requests.empty())
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+                MPI_STATUSES_IGNORE);
+#endif
+}
+
+// y(r) = row r of the local rows times [x; ghosts]. Without ghosts every
+// column is owned and the loop reads x only.
+void DistributedOperator::sweep(const std::vector<uword> &rows, const Real *x,
+                                const Real *ghosts, Real *y) const {
+  const uword *ptr = byRows.col_ptrs;
+  const uword *col = byRows.row_indices;
+  const Real *val = byRows.values;
+  const uword *list = rows.data();
+  const uword count = rows.size();
+  const uword owned = colIndex.n_elem;
+
+  if (ghosts == nullptr) {
+#pragma omp parallel for schedule(static)
+    for (uword i = 0; i < count; ++i) {
+      const uword r = list[i];
+      Real sum = 0.0;
+      for (uword p = ptr[r]; p < ptr[r + 1]; ++p)
+        sum += val[p] * x[col[p]];
+      y[r] = sum;
+    }
+  } else {
+#pragma omp parallel for schedule(static)
+    for (uword i = 0; i < count; ++i) {
+      const uword r = list[i];
+      Real sum = 0.0;
+      for (uword p = ptr[r]; p < ptr[r + 1]; ++p) {
+        const uword c = col[p];
+        sum += val[p] * (c < owned ? x[c] : ghosts[c - owned]);
+      }
+      y[r] = sum;
+    }
+  }
+}
+
+void DistributedOperator::apply(const vec &in, vec &out) const {
+  MOLE_PROFILE_SCOPE("DistributedOperator::apply");
+  if (in.n_elem != colIndex.n_elem)
+    throw std::invalid_argument("MOLE: expected the " +
+                                std::to_string(colIndex.n_elem) +
+                                " owned input entries");
+  out.set_size(rowIndex.n_elem);
+  post(in);
+  sweep(interior, in.memptr(), nullptr, out.memptr());
+  wait();
+  sweep(halo, in.memptr(), ghostValues.memptr(), out.memptr());
+}
+
+vec DistributedOperator::apply(const vec &in) const {
+  vec out;
+  apply(in, out);
+  return out;
+}
+
+} // namespace mole
@@ -0,0 +1,278 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file distributed.h
+ *
+ * @brief Domain-decomposed operators with halo exchange
+ *
+ * The cells of a 2-D or 3-D grid are split into boxes, one per rank, and
+ * each rank assembles only the rows of an operator whose output points it
+ * owns. Values a row needs from other ranks (the halo) are exchanged with
+ * non-blocking MPI while the rows that need none are computed.
+ *
+ * Build with -DMOLE_USE_MPI=ON to distribute across MPI ranks (mpirun
+ * works on a single machine too). Without it every communicator has one
+ * rank and the operators equal the global ones.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include "utils.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+#ifdef MOLE_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace mole {
+
+/**
+ * @brief The ranks an operator is distributed over
+ */
+class Communicator {
+public:
+  /**
+   * @brief MPI_COMM_WORLD, or a single rank without MPI
+   *
+   * @throws std::runtime_error if MPI has not been initialized
+   */
+  Communicator();
+
+#ifdef MOLE_USE_MPI
+  explicit Communicator(MPI_Comm comm);
+
+  MPI_Comm handle() const { return comm; }
+#endif
+
+  int rank() const { return id; }
+  int size() const { return count; }
+
+  /**
+   * @brief Sum of value over all ranks, e.g. for global dot products
+   */
+  Real sum(Real value) const;
+
+private:
+#ifdef MOLE_USE_MPI
+  MPI_Comm comm;
+#endif
+  int id = 0;
+  int count = 1;
+};
+
+/**
+ * @brief Block partition of the cells over a grid of ranks
+ *
+ * The rank grid is the factorization of the number of ranks with the
+ * smallest box surface, so the least data crosses ranks. Ranks are
+ * numbered x fastest. Every staggered point set (centers, faces) is split
+ * along the cells: a rank owns the faces and centers of its cells, and
+ * the boundary points go to the ranks at the boundary.
+ */
+class Decomposition {
+public:
+  /**
+   * @brief Decomposition over the ranks of a communicator
+   *
+   * @param m, n, o Number of cells along x, y and z
+   * @throws std::invalid_argument if an axis has fewer cells than ranks
+   */
+  Decomposition(const Communicator &comm, u32 m, u32 n);
+  Decomposition(const Communicator &comm, u32 m, u32 n, u32 o);
+
+  /**
+   * @brief The part of a given rank, without a communicator
+   *
+   * Operators built on it can be inspected but only applied if they need
+   * no halo, which is meant for tests and for planning runs.
+   */
+  Decomposition(int rank, int size, u32 m, u32 n);
+  Decomposition(int rank, int size, u32 m, u32 n, u32 o);
+
+  u16 dimensions() const { return dims; }
+  int rank() const { return id; }
+  int size() const { return count; }
+
+  /**
+   * @brief Global number of cells along an axis
+   */
+  u32 cells(u16 axis) const { return global[axis]; }
+
+  /**
+   * @brief Number of ranks along an axis, and this rank's position
+   */
+  int ranks(u16 axis) const { return grid[axis]; }
+  int coord(u16 axis) const { return at[axis]; }
+
+  /**
+   * @brief Owned cells along an axis, [begin, end)
+   */
+  u32 begin(u16 axis) const;
+  u32 end(u16 axis) const;
+
+  /**
+   * @brief Owned points along an axis with cells + extra points
+   *
+   * extra is 0 for interior centers, 1 for faces, 2 for centers with the
+   * boundary points.
+   */
+  uword pointsBegin(u16 axis, u16 extra) const;
+  uword pointsEnd(u16 axis, u16 extra) const;
+
+  /**
+   * @brief Rank that owns a point
+   */
+  int owner(const std::array<u16, 3> &extra,
+            const std::array<uword, 3> &point) const;
+
+  /**
+   * @brief nullptr if built without a communicator
+   */
+  const Communicator *communicator() const { return comm.get(); }
+
+private:
+  void init(int rank, int size, const std::vector<u32> &cells);
+  uword pointsBegin(u16 axis, u16 extra, int c) const;
+
+  std::shared_ptr<const Communicator> comm;
+  u16 dims = 0;
+  int id = 0, count = 1;
+  std::array<u32, 3> global{{1, 1, 1}};
+  std::array<int, 3> grid{{1, 1, 1}}, at{{0, 0, 0}};
+};
+
+/**
+ * @brief The local rows of a distributed operator
+ *
+ * Vectors are distributed like the operator: apply() takes the owned
+ * input entries in colIndices() order and returns the owned output rows
+ * in rowIndices() order. Only the 1-D operators of each axis are built
+ * globally; the local rows are assembled from them directly.
+ *
+ * Non-periodic operators only. apply() is not reentrant, it reuses the
+ * halo buffers.
+ */
+class DistributedOperator {
+public:
+  /**
+   * @brief Local rows of Gradient(k, m, n[, o], dx, dy[, dz])
+   */
+  static DistributedOperator gradient(u16 k, const Decomposition &d, Real dx,
+                                      Real dy);
+  static DistributedOperator gradient(u16 k, const Decomposition &d, Real dx,
+                                      Real dy, Real dz);
+
+  /**
+   * @brief Local rows of Divergence(k, m, n[, o], dx, dy[, dz])
+   */
+  static DistributedOperator divergence(u16 k, const Decomposition &d,
+                                        Real dx, Real dy);
+  static DistributedOperator divergence(u16 k, const Decomposition &d,
+                                        Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Local rows of Laplacian(k, m, n[, o], dx, dy[, dz])
+   */
+  static DistributedOperator laplacian(u16 k, const Decomposition &d,
+                                       Real dx, Real dy);
+  static DistributedOperator laplacian(u16 k, const Decomposition &d,
+                                       Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Local rows of Interpol(m, n[, o], c1, c2[, c3]), centers to faces
+   */
+  static DistributedOperator interpol(const Decomposition &d, Real c1,
+                                      Real c2);
+  static DistributedOperator interpol(const Decomposition &d, Real c1,
+                                      Real c2, Real c3);
+
+  /**
+   * @brief Local rows of Interpol(type, m, n[, o], c1, c2[, c3]), faces to
+   *        centers
+   */
+  static DistributedOperator interpol(bool type, const Decomposition &d,
+                                      Real c1, Real c2);
+  static DistributedOperator interpol(bool type, const Decomposition &d,
+                                      Real c1, Real c2, Real c3);
+
+  /**
+   * @brief Global indices of the owned output rows and input entries
+   */
+  const uvec &rowIndices() const { return rowIndex; }
+  const uvec &colIndices() const { return colIndex; }
+
+  /**
+   * @brief Global indices of the input entries received from other ranks
+   */
+  const uvec &ghostIndices() const { return ghostIndex; }
+
+  /**
+   * @brief Ghost values received by the last apply(), in ghostIndices()
+   *        order
+   */
+  const vec &ghosts() const { return ghostValues; }
+
+  /**
+   * @brief Rows that need no halo, computed while it is in flight
+   */
+  uword interiorRows() const { return interior.size(); }
+
+  /**
+   * @brief The local rows; columns are the owned entries, then the ghosts
+   */
+  sp_mat local() const { return byRows.t(); }
+
+  /**
+   * @brief out = A * in on the owned entries
+   *
+   * @throws std::invalid_argument if in does not hold the owned entries
+   * @throws std::runtime_error if a halo is needed but the decomposition
+   *         has no communicator
+   */
+  void apply(const vec &in, vec &out) const;
+  vec apply(const vec &in) const;
+
+private:
+  struct Layout;
+  struct Term;
+  enum class Kind { CentersToFaces, FacesToCenters, CentersToCenters };
+
+  DistributedOperator(const Decomposition &d, const Layout &out,
+                      const Layout &in, const std::vector<Term> &terms);
+
+  static DistributedOperator staggered(const Decomposition &d, Kind kind,
+                                       const std::vector<sp_mat> &along);
+  void connect(const Layout &in);
+  void post(const vec &in) const;
+  void wait() const;
+  void sweep(const std::vector<uword> &rows, const Real *x,
+             const Real *ghosts, Real *y) const;
+
+  Decomposition decomposition;
+  sp_mat byRows; // transposed local rows, so each row is a column
+  uvec rowIndex, colIndex, ghostIndex;
+  std::vector<uword> interior, halo;
+
+  // Halo exchange: ghosts arrive grouped by owner, owned entries are
+  // gathered into sendBuffer for the ranks that need them
+  std::vector<int> recvRanks, sendRanks;
+  std::vector<uword> recvStart, sendStart;
+  uvec sendIndex;
+  mutable vec ghostValues, sendBuffer;
+#ifdef MOLE_USE_MPI
+  mutable std::vector<MPI_Request> requests;
+#endif
+};
+
+} // namespace mole
+
+#endif // DISTRIBUTED_H
@@ -15,6 +15,7 @@
  */
 
 #include "divergence.h"
+#include "footprint.h"
 #include <vector>
 
 // ============================================================================
@@ -99,7 +100,8 @@ sp_mat Divergence::periodicDiv1D(u16 k, u32 m, Real dx) {
 // Non-periodic 1-D Constructor
 // ============================================================================
 
-Divergence::Divergence(u16 k, u32 m, Real dx) : sp_mat(m + 2, m + 1) {
+Divergence::Divergence(u16 k, u32 m, Real dx) : mole::Operator(m + 2, m + 1) {
+  MOLE_PROFILE_SCOPE("Divergence 1-D");
   mole::check_spacing(dx, "dx");
   assert(!(k % 2));
   assert(k > 1 && k < 9);
@@ -262,6 +264,7 @@ Divergence::Divergence(u16 k, u32 m, Real dx) : sp_mat(m + 2, m + 1) {
       , 1558.0 / 1247.0 };
   }
   *this /= dx;
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // Helper: returns an (s+2)×s sparse matrix used as the interior-node
@@ -292,6 +295,7 @@ void Divergence::build_divergence(sp_mat &D_m, sp_mat &I, u16 k, u32 dim,
 // ============================================================================
 
 Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  MOLE_PROFILE_SCOPE("Divergence 2-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   Divergence Dx(k, m, dx);
@@ -302,6 +306,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy) {
 
   sp_mat D1 = Utils::spkron(In, Dx);
   sp_mat D2 = Utils::spkron(Dy, Im);
+  mole::memory::Temporary held1(D1), held2(D2);
 
   if (m != n) {
     *this = Utils::spjoin_rows(D1, D2);
@@ -310,6 +315,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy) {
     A1(0, 0) = A2(0, 1) = 1.0;
     *this = Utils::spkron(A1, D1) + Utils::spkron(A2, D2);
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -317,6 +323,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy) {
 // ============================================================================
 
 Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  MOLE_PROFILE_SCOPE("Divergence 3-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   mole::check_spacing(dz, "dz");
@@ -337,6 +344,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
   sp_mat D1 = Utils::spkron(Utils::spkron(Io, In), Dx);
   sp_mat D2 = Utils::spkron(Utils::spkron(Io, Dy), Im);
   sp_mat D3 = Utils::spkron(Utils::spkron(Dz, In), Im);
+  mole::memory::Temporary held1(D1), held2(D2), held3(D3);
 
   if ((m != n) || (n != o)) {
     *this = Utils::spjoin_rows(Utils::spjoin_rows(D1, D2), D3);
@@ -346,6 +354,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
     *this =
         Utils::spkron(A1, D1) + Utils::spkron(A2, D2) + Utils::spkron(A3, D3);
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -353,7 +362,8 @@ Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
 // ============================================================================
 
 Divergence::Divergence(u16 k, u32 m, Real dx, const ivec &dc, const ivec &nc)
-    : sp_mat() {
+    : mole::Operator() {
+  MOLE_PROFILE_SCOPE("Divergence 1-D");
   mole::check_spacing(dx, "dx");
   assert(dc.n_elem == 2 && nc.n_elem == 2);
 
@@ -366,6 +376,7 @@ Divergence::Divergence(u16 k, u32 m, Real dx, const ivec &dc, const ivec &nc)
     this->sp_mat::operator=(tmp);
     Q = tmp.Q;
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -374,7 +385,8 @@ Divergence::Divergence(u16 k, u32 m, Real dx, const ivec &dc, const ivec &nc)
 
 Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy, const ivec &dc,
                        const ivec &nc)
-    : sp_mat() {
+    : mole::Operator() {
+  MOLE_PROFILE_SCOPE("Divergence 2-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   assert(dc.n_elem == 4 && nc.n_elem == 4);
@@ -395,6 +407,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy, const ivec &dc,
   sp_mat D1 = Utils::spkron(In, Dx_m);
   sp_mat D2 = Utils::spkron(Dy_m, Im);
   *this = Utils::spjoin_rows(D1, D2);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -403,7 +416,8 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy, const ivec &dc,
 
 Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
                        const ivec &dc, const ivec &nc)
-    : sp_mat() {
+    : mole::Operator() {
+  MOLE_PROFILE_SCOPE("Divergence 3-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   mole::check_spacing(dz, "dz");
@@ -433,6 +447,7 @@ Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
   sp_mat D3 = Utils::spkron(Utils::spkron(Dz_m, In), Im);
 
   *this = Utils::spjoin_rows(Utils::spjoin_rows(D1, D2), D3);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
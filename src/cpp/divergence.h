@@ -34,7 +34,7 @@
  *    identity has no meaning, which breaks the structure that makes 
  *    the divergence mimetic.
  */
-class Divergence : public sp_mat {
+class Divergence : public mole::Operator {
 public:
   using sp_mat::operator=;
 
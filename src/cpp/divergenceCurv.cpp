@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file divergenceCurv.cpp
+ *
+ * @brief Mimetic Divergence Operators on curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "divergenceCurv.h"
+
+DivergenceCurv::DivergenceCurv(const CurvilinearMetrics &metrics) {
+  MOLE_PROFILE_SCOPE("DivergenceCurv");
+  const u16 d = metrics.dimensions();
+
+  // Logical divergences acting on and returning to the centers
+  std::vector<sp_mat> centers(d);
+  std::vector<const sp_mat *> logical(d);
+  for (u16 a = 0; a < d; ++a) {
+    const CurvilinearMetrics::Axis &ax = metrics.axis(a);
+    centers[a] = metrics.expand(a, ax.D * ax.ICF);
+    logical[a] = &centers[a];
+  }
+
+  // No output on the boundary centers of non-periodic axes
+  vec interior(metrics.size(), fill::ones);
+  uword stride = 1;
+  for (u16 a = 0; a < d; ++a) {
+    const uword points = metrics.points(a);
+    if (!metrics.periodic(a)) {
+      for (uword c = 0; c < interior.n_elem; ++c) {
+        const uword index = (c / stride) % points;
+        if (index == 0 || index == points - 1)
+          interior(c) = 0.0;
+      }
+    }
+    stride *= points;
+  }
+
+  for (u16 i = 0; i < d; ++i) {
+    const sp_mat Di = metrics.transform(i, logical, interior) *
+                      metrics.expand(i, metrics.axis(i).IFC);
+    if (i == 0)
+      *this = Di;
+    else
+      *this = Utils::spjoin_rows(*this, Di);
+  }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
+
+DivergenceCurv::DivergenceCurv(u16 k, const mat &X, const mat &Y,
+                               const ivec &dc, const ivec &nc)
+    : DivergenceCurv(CurvilinearMetrics(k, X, Y, dc, nc)) {}
+
+DivergenceCurv::DivergenceCurv(u16 k, const cube &X, const cube &Y,
+                               const cube &Z, const ivec &dc, const ivec &nc)
+    : DivergenceCurv(CurvilinearMetrics(k, X, Y, Z, dc, nc)) {}
@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file divergenceCurv.h
+ *
+ * @brief Mimetic Divergence Operators on curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef DIVERGENCECURV_H
+#define DIVERGENCECURV_H
+
+#include "metrics.h"
+
+/**
+ * @brief Curvilinear mimetic Divergence operator (div2DCurv / div3DCurv)
+ *
+ * Acts on the extended faces, stacked x, y[, z], and outputs to the cell
+ * centers:
+ *
+ *   D_i = sum_a diag(dxi_a/dx_i) * (D_a * ICF_a) * kron(..., IFC_i, ...)
+ *
+ * Rows of boundary centers of non-periodic axes are zero.
+ */
+class DivergenceCurv : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief Divergence on a grid whose metrics are already computed
+   *
+   * @param metrics Shared metric terms, e.g. also used by a GradientCurv
+   */
+  explicit DivergenceCurv(const CurvilinearMetrics &metrics);
+
+  /**
+   * @brief 2-D Curvilinear Mimetic Divergence Constructor
+   *
+   * @param k  Order of accuracy
+   * @param X  x-coordinates of the centers (Utils::meshgrid layout)
+   * @param Y  y-coordinates of the centers
+   * @param dc Dirichlet coefficients for the left, right, bottom, and top boundaries
+   * @param nc Neumann coefficients for the left, right, bottom, and top boundaries
+   */
+  DivergenceCurv(u16 k, const mat &X, const mat &Y, const ivec &dc,
+                 const ivec &nc);
+
+  /**
+   * @brief 3-D Curvilinear Mimetic Divergence Constructor
+   *
+   * @param k       Order of accuracy
+   * @param X, Y, Z Coordinates of the centers (3-D Utils::meshgrid layout)
+   * @param dc      Dirichlet coefficients for the left, right, bottom, top, front, and back boundaries
+   * @param nc      Neumann coefficients for the left, right, bottom, top, front, and back boundaries
+   */
+  DivergenceCurv(u16 k, const cube &X, const cube &Y, const cube &Z,
+                 const ivec &dc, const ivec &nc);
+};
+
+#endif // DIVERGENCECURV_H
@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file divergenceNonUniform.cpp
+ *
+ * @brief Mimetic Divergence Operators on non-uniform grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "divergenceNonUniform.h"
+
+namespace {
+
+// (s+2) x s: places values on the interior centers of an axis
+sp_mat interior(u32 s) {
+  sp_mat I(s + 2, s);
+  for (u32 i = 0; i < s; ++i)
+    I(i + 1, i) = 1.0;
+  return I;
+}
+
+} // anonymous namespace
+
+DivergenceNonUniform::DivergenceNonUniform(u16 k, const vec &xticks) {
+  MOLE_PROFILE_SCOPE("DivergenceNonUniform 1-D");
+  assemble(NonUniformKernel(NonUniformKernel::Kind::Divergence, k, xticks));
+}
+
+DivergenceNonUniform::DivergenceNonUniform(u16 k, const vec &xticks,
+                                           const vec &yticks) {
+  MOLE_PROFILE_SCOPE("DivergenceNonUniform 2-D");
+  assemble(NonUniformKernel(NonUniformKernel::Kind::Divergence, k, xticks,
+                            yticks));
+}
+
+DivergenceNonUniform::DivergenceNonUniform(u16 k, const vec &xticks,
+                                           const vec &yticks,
+                                           const vec &zticks) {
+  MOLE_PROFILE_SCOPE("DivergenceNonUniform 3-D");
+  assemble(NonUniformKernel(NonUniformKernel::Kind::Divergence, k, xticks,
+                            yticks, zticks));
+}
+
+void DivergenceNonUniform::assemble(const NonUniformKernel &kernel) {
+  // The 1-D factors already carry their Jacobians, so the 2-D/3-D operators
+  // are plain Kronecker products of them (div2DNonUniform.m).
+  const sp_mat &Dx = kernel.factor(0);
+  if (kernel.dimensions() == 1) {
+    *this = Dx;
+  } else if (kernel.dimensions() == 2) {
+    const sp_mat &Dy = kernel.factor(1);
+    const sp_mat Im = interior(kernel.cells(0));
+    const sp_mat In = interior(kernel.cells(1));
+    *this = Utils::spjoin_rows(Utils::spkron(In, Dx), Utils::spkron(Dy, Im));
+  } else {
+    const sp_mat &Dy = kernel.factor(1);
+    const sp_mat &Dz = kernel.factor(2);
+    const sp_mat Im = interior(kernel.cells(0));
+    const sp_mat In = interior(kernel.cells(1));
+    const sp_mat Io = interior(kernel.cells(2));
+    const sp_mat D1 = Utils::spkron(Utils::spkron(Io, In), Dx);
+    const sp_mat D2 = Utils::spkron(Utils::spkron(Io, Dy), Im);
+    const sp_mat D3 = Utils::spkron(Utils::spkron(Dz, In), Im);
+    *this = Utils::spjoin_rows(Utils::spjoin_rows(D1, D2), D3);
+  }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file divergenceNonUniform.h
+ *
+ * @brief Mimetic Divergence Operators on non-uniform grids
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef DIVERGENCENONUNIFORM_H
+#define DIVERGENCENONUNIFORM_H
+
+#include "nonuniform.h"
+
+/**
+ * @brief Non-uniform mimetic Divergence (divNonUniform, div2DNonUniform,
+ *        div3DNonUniform)
+ *
+ * Ticks are the faces, both boundaries included (m+1 values for m
+ * cells). For applying the operator without assembling it, see
+ * NonUniformKernel.
+ */
+class DivergenceNonUniform : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief 1-D Non-uniform Mimetic Divergence Constructor
+   *
+   * @param k      Order of accuracy
+   * @param xticks Faces, strictly increasing
+   */
+  DivergenceNonUniform(u16 k, const vec &xticks);
+
+  /**
+   * @brief 2-D Non-uniform Mimetic Divergence Constructor
+   *
+   * @param k      Order of accuracy
+   * @param xticks Faces along x
+   * @param yticks Faces along y
+   */
+  DivergenceNonUniform(u16 k, const vec &xticks, const vec &yticks);
+
+  /**
+   * @brief 3-D Non-uniform Mimetic Divergence Constructor
+   *
+   * @param k      Order of accuracy
+   * @param xticks Faces along x
+   * @param yticks Faces along y
+   * @param zticks Faces along z
+   */
+  DivergenceNonUniform(u16 k, const vec &xticks, const vec &yticks,
+                     const vec &zticks);
+
+private:
+  void assemble(const NonUniformKernel &kernel);
+};
+
+#endif // DIVERGENCENONUNIFORM_H
@@ -0,0 +1,278 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file eigs.cpp
+ *
+ * @brief Thick-restarted Arnoldi with a cached shift-invert factorization
+ *
+ * @date 2026/10/19
+ */
+
+#include "eigs.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace mole {
+
+namespace {
+
+// Orthogonalizes t against the first j columns of V (classical Gram-Schmidt,
+// applied twice) and normalizes it. Returns false if t lies in span(V).
+bool orthonormalize(vec &t, const mat &V, uword j) {
+  const Real norm0 = norm(t);
+  if (norm0 == 0.0)
+    return false;
+  for (int pass = 0; pass < 2 && j > 0; ++pass) {
+    const vec h = V.cols(0, j - 1).t() * t;
+    t -= V.cols(0, j - 1) * h;
+  }
+  const Real nt = norm(t);
+  if (nt <= 1e-12 * norm0)
+    return false;
+  t /= nt;
+  return true;
+}
+
+// Order in which eigenvalues are reported.
+uvec reportOrder(const cx_vec &lambda, EigsTarget target, Real sigma) {
+  vec key(lambda.n_elem);
+  for (uword i = 0; i < lambda.n_elem; ++i) {
+    switch (target) {
+    case EigsTarget::Lowest:
+      key(i) = lambda(i).real();
+      break;
+    case EigsTarget::Nearest:
+      key(i) = std::abs(lambda(i) - sigma);
+      break;
+    case EigsTarget::LargestMagnitude:
+      key(i) = -std::abs(lambda(i));
+      break;
+    }
+  }
+  return sort_index(key);
+}
+
+} // anonymous namespace
+
+Eigensolver::Eigensolver(const sp_mat &A, EigsTarget target, Real sigma)
+    : A(A), generalized(false), target(target), sigma(sigma) {
+  prepare();
+}
+
+Eigensolver::Eigensolver(const sp_mat &A, const sp_mat &B, EigsTarget target,
+                         Real sigma)
+    : A(A), B(B), generalized(true), target(target), sigma(sigma) {
+  if (B.n_rows != A.n_rows || B.n_cols != A.n_cols)
+    throw std::invalid_argument("MOLE: eigs needs A and B of the same size");
+  prepare();
+}
+
+void Eigensolver::prepare() {
+  MOLE_PROFILE_SCOPE("Eigensolver factorization");
+  if (A.n_rows != A.n_cols || A.n_rows == 0)
+    throw std::invalid_argument("MOLE: eigs needs a square operator");
+
+  if (target == EigsTarget::LargestMagnitude) {
+    sigma = 0.0;
+    if (generalized && !factor.factorise(B))
+      throw std::runtime_error("MOLE: eigs could not factorize B");
+    return;
+  }
+
+  if (std::isnan(sigma))
+    sigma = (target == EigsTarget::Lowest) ? lowerBound() : 0.0;
+
+  const sp_mat I = generalized ? B : speye<sp_mat>(A.n_rows, A.n_cols);
+  if (!factor.factorise(A - sigma * I))
+    throw std::runtime_error("MOLE: eigs could not factorize A - sigma*B; "
+                             "sigma may be an eigenvalue");
+}
+
+// Gershgorin lower bound on the real parts of the spectrum of A (or of
+// B^{-1} A for diagonal B), pushed slightly down so that A - sigma*B is not
+// singular when the bound is attained.
+Real Eigensolver::lowerBound() const {
+  const uword n = A.n_rows;
+  vec center(n, fill::zeros), radius(n, fill::zeros), scale(n, fill::ones);
+
+  for (sp_mat::const_iterator it = A.begin(); it != A.end(); ++it) {
+    if (it.row() == it.col())
+      center(it.row()) = *it;
+    else
+      radius(it.row()) += std::abs(*it);
+  }
+
+  if (generalized) {
+    for (sp_mat::const_iterator it = B.begin(); it != B.end(); ++it) {
+      if (it.row() != it.col() && *it != 0.0)
+        throw std::invalid_argument(
+            "MOLE: eigs needs an explicit sigma when B is not diagonal");
+    }
+    for (uword i = 0; i < n; ++i) {
+      scale(i) = B(i, i);
+      if (scale(i) <= 0.0)
+        throw std::invalid_argument(
+            "MOLE: eigs needs an explicit sigma when B is not positive");
+    }
+  }
+
+  Real lower = center(0) / scale(0) - radius(0) / scale(0);
+  Real upper = center(0) / scale(0) + radius(0) / scale(0);
+  for (uword i = 1; i < n; ++i) {
+    lower = std::min(lower, (center(i) - radius(i)) / scale(i));
+    upper = std::max(upper, (center(i) + radius(i)) / scale(i));
+  }
+  return lower - 1e-3 * std::max(upper - lower, std::abs(lower)) - 1e-12;
+}
+
+void Eigensolver::apply(const vec &x, vec &y) {
+  if (inverted()) {
+    if (!factor.solve(y, generalized ? vec(B * x) : x))
+      throw std::runtime_error("MOLE: eigs shift-invert solve failed");
+  } else if (generalized) {
+    if (!factor.solve(y, vec(A * x)))
+      throw std::runtime_error("MOLE: eigs solve with B failed");
+  } else {
+    y = A * x;
+  }
+}
+
+EigsResult Eigensolver::solve(uword nev, const EigsOptions &opts) {
+  MOLE_PROFILE_SCOPE("eigs");
+  const uword n = A.n_rows;
+  if (nev == 0 || nev >= n)
+    throw std::invalid_argument("MOLE: eigs needs 0 < nev < size of A");
+
+  uword ncv = opts.ncv ? opts.ncv : std::max<uword>(2 * nev + 1, 20);
+  ncv = std::min(ncv, n);
+  if (ncv < nev + 2 && ncv < n)
+    throw std::invalid_argument("MOLE: eigs needs ncv >= nev + 2");
+
+  // V is an orthonormal basis of the search space and W = Op*V, so the
+  // Rayleigh quotient V'*Op*V is formed without extra applications.
+  mat V(n, ncv), W(n, ncv);
+  vec t = opts.v0.n_elem == n ? opts.v0 : vec(n, fill::randu);
+  vec w(n);
+  uword j = 0;
+
+  EigsResult result;
+  cx_vec theta;
+  cx_mat S;
+  uvec wanted;
+
+  for (uword restart = 0;; ++restart) {
+    // Expand the search space up to ncv vectors
+    while (j < ncv) {
+      if (!orthonormalize(t, V, j)) {
+        // Invariant subspace: continue from a fresh random direction
+        t.randu();
+        if (!orthonormalize(t, V, j))
+          break;
+      }
+      V.col(j) = t;
+      apply(t, w);
+      ++result.applications;
+      W.col(j) = w;
+      t = w;
+      ++j;
+    }
+
+    // Rayleigh-Ritz on the current space
+    const mat H = V.cols(0, j - 1).t() * W.cols(0, j - 1);
+    eig_gen(theta, S, H);
+    wanted = sort_index(abs(theta), "descend");
+
+    // Residuals ||Op*y - theta*y|| of the wanted Ritz pairs, in real
+    // arithmetic: y = V*(Sr + i*Si), Op*y = W*(Sr + i*Si)
+    const mat Sr = real(S), Si = imag(S);
+    uword converged = 0, first_open = nev;
+    vec residual_re, residual_im;
+    for (uword i = 0; i < nev; ++i) {
+      const uword c = wanted(i);
+      const Real a = theta(c).real(), b = theta(c).imag();
+      const vec yr = V.cols(0, j - 1) * Sr.col(c);
+      const vec yi = V.cols(0, j - 1) * Si.col(c);
+      const vec rr = W.cols(0, j - 1) * Sr.col(c) - a * yr + b * yi;
+      const vec ri = W.cols(0, j - 1) * Si.col(c) - b * yr - a * yi;
+      const Real res = std::sqrt(dot(rr, rr) + dot(ri, ri));
+      if (res <= opts.tol * std::abs(theta(c))) {
+        ++converged;
+      } else if (first_open == nev) {
+        first_open = i;
+        residual_re = rr;
+        residual_im = ri;
+      }
+    }
+
+    result.restarts = restart;
+    if (converged == nev || restart >= opts.max_restarts || j < ncv) {
+      result.converged = converged == nev;
+      break;
+    }
+
+    // Thick restart: keep the real and imaginary parts of the wanted Ritz
+    // vectors (plus a few more), which span the same real subspace as the
+    // conjugate pairs themselves.
+    const uword keep = std::min(nev + (ncv - nev) / 2, ncv - 1);
+    mat K(j, keep);
+    uword p = 0;
+    for (uword i = 0; i < j && p < keep; ++i) {
+      const uword c = wanted(i);
+      if (theta(c).imag() != 0.0 && i > 0 &&
+          std::abs(theta(wanted(i - 1)) - std::conj(theta(c))) <=
+              1e-12 * std::abs(theta(c)))
+        continue; // conjugate partner already kept
+      K.col(p++) = Sr.col(c);
+      if (theta(c).imag() != 0.0 && p < keep)
+        K.col(p++) = Si.col(c);
+    }
+    mat Q, R;
+    qr_econ(Q, R, K.cols(0, p - 1));
+    V.cols(0, p - 1) = V.cols(0, j - 1) * Q;
+    W.cols(0, p - 1) = W.cols(0, j - 1) * Q;
+    j = p;
+
+    // Continue from the residual of the first unconverged pair, which is
+    // orthogonal to the kept space.
+    t = norm(residual_re) >= norm(residual_im) ? residual_re : residual_im;
+  }
+
+  // Ritz vectors and spectral back-transformation
+  result.values.set_size(nev);
+  result.vectors.set_size(n, nev);
+  const mat Sr = real(S), Si = imag(S);
+  for (uword i = 0; i < nev; ++i) {
+    const uword c = wanted(i);
+    const vec yr = V.cols(0, j - 1) * Sr.col(c);
+    const vec yi = V.cols(0, j - 1) * Si.col(c);
+    result.vectors.col(i) = cx_vec(yr, yi);
+    result.values(i) =
+        inverted() ? cx_double(sigma, 0.0) + 1.0 / theta(c) : theta(c);
+  }
+
+  const uvec order = reportOrder(result.values, target, sigma);
+  const cx_vec values = result.values(order);
+  const cx_mat vectors = result.vectors.cols(order);
+  result.values = values;
+  result.vectors = vectors;
+  return result;
+}
+
+EigsResult eigs(const sp_mat &A, uword nev, EigsTarget target, Real sigma,
+                const EigsOptions &opts) {
+  Eigensolver solver(A, target, sigma);
+  return solver.solve(nev, opts);
+}
+
+EigsResult eigs(const sp_mat &A, const sp_mat &B, uword nev, EigsTarget target,
+                Real sigma, const EigsOptions &opts) {
+  Eigensolver solver(A, B, target, sigma);
+  return solver.solve(nev, opts);
+}
+
+} // namespace mole
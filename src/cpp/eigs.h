@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file eigs.h
+ *
+ * @brief Sparse eigensolver for mimetic operators
+ *
+ * Computes a few eigenpairs of A x = lambda x or A x = lambda B x with a
+ * thick-restarted Arnoldi iteration. Mimetic operators with boundary rows
+ * are not symmetric, so the general (complex) form is used throughout.
+ *
+ * Interior eigenvalues and the low end of the spectrum are reached through
+ * shift-invert, (A - sigma B)^{-1} B, whose sparse LU factorization is
+ * computed once and reused by every iteration and every solve() call.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef EIGS_H
+#define EIGS_H
+
+#include "utils.h"
+#include <limits>
+
+namespace mole {
+
+/**
+ * @brief Lets the solver pick the shift (see EigsTarget)
+ */
+constexpr Real EigsAutoShift = std::numeric_limits<Real>::quiet_NaN();
+
+/**
+ * @brief Which part of the spectrum to compute
+ *
+ * - Lowest:           smallest real parts. Shift-invert about sigma, which
+ *                     must lie below the spectrum; EigsAutoShift uses a
+ *                     Gershgorin bound. A tight bound (e.g. min(V) for
+ *                     -0.5*L + V) converges much faster.
+ * - Nearest:          eigenvalues closest to sigma (0 for EigsAutoShift)
+ * - LargestMagnitude: largest |lambda|, sigma is ignored
+ */
+enum class EigsTarget { Lowest, Nearest, LargestMagnitude };
+
+/**
+ * @brief Iteration controls
+ */
+struct EigsOptions {
+  Real tol = 1e-10;        // relative residual of the transformed problem
+  uword ncv = 0;           // search space size, 0 = max(2*nev + 1, 20)
+  uword max_restarts = 500; // restarts before giving up
+  vec v0;                  // starting vector, random if empty
+};
+
+/**
+ * @brief Eigenpairs, sorted by the requested target
+ */
+struct EigsResult {
+  cx_vec values;
+  cx_mat vectors;       // unit 2-norm columns
+  uword restarts = 0;
+  uword applications = 0; // operator (or shift-invert solve) applications
+  bool converged = false;
+};
+
+/**
+ * @brief Eigensolver with a cached spectral transformation
+ *
+ * The operator is copied once; the shift-invert (or B) factorization is
+ * built in the constructor and reused by every solve().
+ */
+class Eigensolver {
+public:
+  /**
+   * @brief Standard problem A x = lambda x
+   *
+   * @param A      Square sparse operator, e.g. -0.5*L + V
+   * @param target Part of the spectrum to compute
+   * @param sigma  Shift (see EigsTarget)
+   *
+   * @throws std::invalid_argument if A is not square
+   * @throws std::runtime_error if the shifted operator cannot be factorized
+   *         (sigma is an eigenvalue)
+   */
+  explicit Eigensolver(const sp_mat &A,
+                       EigsTarget target = EigsTarget::Lowest,
+                       Real sigma = EigsAutoShift);
+
+  /**
+   * @brief Generalized problem A x = lambda B x
+   *
+   * The automatic Lowest shift needs B diagonal and positive (e.g. mimetic
+   * weights); for other B pass sigma explicitly.
+   *
+   * @throws std::invalid_argument if the sizes differ, or if sigma must be
+   *         given explicitly
+   */
+  Eigensolver(const sp_mat &A, const sp_mat &B,
+              EigsTarget target = EigsTarget::Lowest, Real sigma = EigsAutoShift);
+
+  Eigensolver(const Eigensolver &) = delete;
+  Eigensolver &operator=(const Eigensolver &) = delete;
+
+  /**
+   * @brief Computes nev eigenpairs
+   */
+  EigsResult solve(uword nev, const EigsOptions &opts = EigsOptions());
+
+  /**
+   * @brief Shift used by the spectral transformation
+   */
+  Real shift() const { return sigma; }
+
+private:
+  sp_mat A;
+  sp_mat B;
+  bool generalized;
+  EigsTarget target;
+  Real sigma;
+  spsolve_factoriser factor; // A - sigma*B, or B in regular generalized mode
+
+  void prepare();
+  Real lowerBound() const;
+  void apply(const vec &x, vec &y);
+  bool inverted() const { return target != EigsTarget::LargestMagnitude; }
+};
+
+/**
+ * @brief One-shot wrappers around Eigensolver
+ */
+EigsResult eigs(const sp_mat &A, uword nev,
+                EigsTarget target = EigsTarget::Lowest, Real sigma = EigsAutoShift,
+                const EigsOptions &opts = EigsOptions());
+
+EigsResult eigs(const sp_mat &A, const sp_mat &B, uword nev,
+                EigsTarget target = EigsTarget::Lowest, Real sigma = EigsAutoShift,
+                const EigsOptions &opts = EigsOptions());
+
+} // namespace mole
+
+#endif // EIGS_H
@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file expression.cpp
+ *
+ * @brief Lazy compositions of operators
+ *
+ * @date 2026/10/19
+ */
+
+#include "expression.h"
+#include <algorithm>
+#include <utility>
+
+namespace mole {
+namespace expr {
+
+sp_mat combine(const Terms &terms, uword rows, uword cols) {
+  MOLE_PROFILE_SCOPE("expr::combine");
+  for (const Terms::Term &t : terms.list)
+    if (t.A != nullptr)
+      t.A->sync();
+  const uword none = static_cast<uword>(-1);
+
+  // Pass 1: size of the union of the patterns in every column
+  uvec colptr(cols + 1, fill::zeros);
+  uword *count = colptr.memptr() + 1;
+#pragma omp parallel
+  {
+    std::vector<uword> seen(rows, none);
+#pragma omp for schedule(dynamic, 256)
+    for (uword c = 0; c < cols; ++c) {
+      uword n = 0;
+      for (const Terms::Term &t : terms.list) {
+        if (t.A == nullptr) {
+          if (c < rows && seen[c] != c) {
+            seen[c] = c;
+            ++n;
+          }
+          continue;
+        }
+        for (uword p = t.A->col_ptrs[c]; p < t.A->col_ptrs[c + 1]; ++p) {
+          const uword r = t.A->row_indices[p];
+          if (seen[r] != c) {
+            seen[r] = c;
+            ++n;
+          }
+        }
+      }
+      count[c] = n;
+    }
+  }
+  for (uword c = 0; c < cols; ++c)
+    count[c] += colptr(c);
+
+  // Pass 2: accumulate every column into its exactly sized slice
+  uvec rowind(colptr(cols));
+  vec values(colptr(cols));
+#pragma omp parallel
+  {
+    std::vector<uword> seen(rows, none), at(rows);
+    std::vector<std::pair<uword, Real>> column;
+#pragma omp for schedule(dynamic, 256)
+    for (uword c = 0; c < cols; ++c) {
+      column.clear();
+      const auto add = [&](uword r, Real v) {
+        if (seen[r] != c) {
+          seen[r] = c;
+          at[r] = column.size();
+          column.push_back({r, 0.0});
+        }
+        column[at[r]].second += v;
+      };
+      for (const Terms::Term &t : terms.list) {
+        if (t.A == nullptr) {
+          if (c < rows)
+            add(c, t.coef);
+          continue;
+        }
+        for (uword p = t.A->col_ptrs[c]; p < t.A->col_ptrs[c + 1]; ++p)
+          add(t.A->row_indices[p], t.coef * t.A->values[p]);
+      }
+      std::sort(column.begin(), column.end());
+      uword q = colptr(c);
+      for (const auto &e : column) {
+        rowind(q) = e.first;
+        values(q++) = e.second;
+      }
+    }
+  }
+  return sp_mat(rowind, colptr, values, rows, cols);
+}
+
+} // namespace expr
+} // namespace mole
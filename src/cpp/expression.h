@@ -0,0 +1,327 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file expression.h
+ *
+ * @brief Lazy compositions of operators
+ *
+ * The overloads in operators.h build a new sp_mat for every D * G or
+ * L + BC. Wrapping the operators with mole::lazy() instead records the
+ * composition; nothing is assembled until materialize() is called.
+ *
+ * @code
+ *   const Laplacian L(k, m, dx);
+ *   const auto M = mole::identity(L.n_rows) - 0.5 * dt * nu * mole::lazy(L);
+ *   M.apply(u, rhs);             // one apply of L, no sparse copy
+ *   sp_mat A = M.materialize();  // one pass, exact nnz
+ * @endcode
+ *
+ * Applied to a vector, sums and scalings are folded into the alpha/beta of
+ * the underlying mole::apply_add() calls, and products apply right to
+ * left. Expressions refer to the operators they wrap, which must outlive
+ * them.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include "utils.h"
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+namespace mole {
+namespace expr {
+
+/**
+ * @brief Sparse terms coef * A of a flattened linear combination
+ *
+ * A == nullptr stands for the identity. Products are materialized into
+ * owned as they are met.
+ */
+struct Terms {
+  struct Term {
+    Real coef;
+    const sp_mat *A;
+  };
+  std::vector<Term> list;
+  std::deque<sp_mat> owned;
+};
+
+/**
+ * @brief Sum of the terms, assembled in two passes
+ *
+ * The first pass counts the union of the terms' patterns per column,
+ * the second fills the exactly sized arrays. Columns are split over the
+ * OpenMP threads.
+ */
+sp_mat combine(const Terms &terms, uword rows, uword cols);
+
+/**
+ * @brief Base of every expression node (CRTP)
+ */
+template <class E> class Expr {
+public:
+  const E &self() const { return static_cast<const E &>(*this); }
+
+  uword rows() const { return self().rows(); }
+  uword cols() const { return self().cols(); }
+
+  /**
+   * @brief out = E * in
+   */
+  void apply(const vec &in, vec &out) const {
+    out.set_size(rows());
+    self().apply_add(1.0, in, 0.0, out);
+  }
+
+  /**
+   * @brief Assembles the expression as one sparse matrix
+   */
+  sp_mat materialize() const {
+    Terms terms;
+    self().collect(1.0, terms);
+    return combine(terms, rows(), cols());
+  }
+};
+
+/**
+ * @brief An existing operator, by reference
+ */
+class Ref : public Expr<Ref> {
+public:
+  explicit Ref(const sp_mat &A) : A(&A) {}
+
+  uword rows() const { return A->n_rows; }
+  uword cols() const { return A->n_cols; }
+
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const {
+    mole::apply_add(*A, alpha, in, beta, out);
+  }
+
+  void collect(Real coef, Terms &terms) const {
+    terms.list.push_back({coef, A});
+  }
+
+  const sp_mat &matrix() const { return *A; }
+
+private:
+  const sp_mat *A;
+};
+
+/**
+ * @brief n x n identity
+ */
+class Identity : public Expr<Identity> {
+public:
+  explicit Identity(uword n) : n(n) {}
+
+  uword rows() const { return n; }
+  uword cols() const { return n; }
+
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const {
+    if (beta == 0.0)
+      out = alpha * in;
+    else
+      out = alpha * in + beta * out;
+  }
+
+  void collect(Real coef, Terms &terms) const {
+    terms.list.push_back({coef, nullptr});
+  }
+
+private:
+  uword n;
+};
+
+/**
+ * @brief s * E
+ */
+template <class E> class Scaled : public Expr<Scaled<E>> {
+public:
+  Scaled(Real s, const E &e) : s(s), e(e) {}
+
+  uword rows() const { return e.rows(); }
+  uword cols() const { return e.cols(); }
+
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const {
+    e.apply_add(alpha * s, in, beta, out);
+  }
+
+  void collect(Real coef, Terms &terms) const { e.collect(coef * s, terms); }
+
+private:
+  Real s;
+  E e;
+};
+
+/**
+ * @brief L + R
+ */
+template <class L, class R> class Sum : public Expr<Sum<L, R>> {
+public:
+  Sum(const L &l, const R &r) : l(l), r(r) {
+    if (l.rows() != r.rows() || l.cols() != r.cols())
+      throw std::invalid_argument("MOLE: sum of operators of different "
+                                  "sizes");
+  }
+
+  uword rows() const { return l.rows(); }
+  uword cols() const { return l.cols(); }
+
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const {
+    l.apply_add(alpha, in, beta, out);
+    r.apply_add(alpha, in, 1.0, out);
+  }
+
+  void collect(Real coef, Terms &terms) const {
+    l.collect(coef, terms);
+    r.collect(coef, terms);
+  }
+
+private:
+  L l;
+  R r;
+};
+
+// Factor of a product: wrapped operators are used as they are, anything
+// else is materialized into storage
+template <class E>
+const sp_mat &operand(const Expr<E> &e, sp_mat &storage) {
+  storage = e.materialize();
+  return storage;
+}
+
+inline const sp_mat &operand(const Ref &e, sp_mat &) { return e.matrix(); }
+
+/**
+ * @brief L * R
+ *
+ * apply() goes through a work vector of R's rows, allocated on first use
+ * and kept, so one product expression should not be applied from two
+ * threads at once.
+ */
+template <class L, class R> class Product : public Expr<Product<L, R>> {
+public:
+  Product(const L &l, const R &r) : l(l), r(r) {
+    if (l.cols() != r.rows())
+      throw std::invalid_argument("MOLE: product of operators of "
+                                  "incompatible sizes");
+  }
+
+  uword rows() const { return l.rows(); }
+  uword cols() const { return r.cols(); }
+
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const {
+    work.set_size(r.rows());
+    r.apply_add(1.0, in, 0.0, work);
+    l.apply_add(alpha, work, beta, out);
+  }
+
+  // Armadillo counts the product's nonzeros before it allocates
+  void collect(Real coef, Terms &terms) const {
+    sp_mat ls, rs;
+    terms.owned.push_back(operand(l, ls) * operand(r, rs));
+    terms.list.push_back({coef, &terms.owned.back()});
+  }
+
+private:
+  L l;
+  R r;
+  mutable vec work;
+};
+
+template <class L, class R>
+Sum<L, R> operator+(const Expr<L> &l, const Expr<R> &r) {
+  return Sum<L, R>(l.self(), r.self());
+}
+
+template <class L, class R>
+Sum<L, Scaled<R>> operator-(const Expr<L> &l, const Expr<R> &r) {
+  return Sum<L, Scaled<R>>(l.self(), Scaled<R>(-1.0, r.self()));
+}
+
+template <class L, class R>
+Product<L, R> operator*(const Expr<L> &l, const Expr<R> &r) {
+  return Product<L, R>(l.self(), r.self());
+}
+
+template <class E> Scaled<E> operator*(Real s, const Expr<E> &e) {
+  return Scaled<E>(s, e.self());
+}
+
+template <class E> Scaled<E> operator*(const Expr<E> &e, Real s) {
+  return Scaled<E>(s, e.self());
+}
+
+template <class E> Scaled<E> operator-(const Expr<E> &e) {
+  return Scaled<E>(-1.0, e.self());
+}
+
+// Operators mix with expressions directly: lazy(D) * G
+
+template <class L> Sum<L, Ref> operator+(const Expr<L> &l, const sp_mat &r) {
+  return l + Ref(r);
+}
+
+template <class R> Sum<Ref, R> operator+(const sp_mat &l, const Expr<R> &r) {
+  return Ref(l) + r;
+}
+
+template <class L>
+Sum<L, Scaled<Ref>> operator-(const Expr<L> &l, const sp_mat &r) {
+  return l - Ref(r);
+}
+
+template <class R>
+Sum<Ref, Scaled<R>> operator-(const sp_mat &l, const Expr<R> &r) {
+  return Ref(l) - r;
+}
+
+template <class L>
+Product<L, Ref> operator*(const Expr<L> &l, const sp_mat &r) {
+  return l * Ref(r);
+}
+
+template <class R>
+Product<Ref, R> operator*(const sp_mat &l, const Expr<R> &r) {
+  return Ref(l) * r;
+}
+
+/**
+ * @brief E * v, as a chain of applies
+ */
+template <class E> vec operator*(const Expr<E> &e, const vec &v) {
+  vec out;
+  e.apply(v, out);
+  return out;
+}
+
+/**
+ * @brief Solves E x = b, materializing E once
+ */
+template <class E> bool spsolve(vec &x, const Expr<E> &e, const vec &b) {
+  return arma::spsolve(x, e.materialize(), b);
+}
+
+} // namespace expr
+
+/**
+ * @brief Starts a lazy expression from an operator, without copying it
+ */
+inline expr::Ref lazy(const sp_mat &A) { return expr::Ref(A); }
+
+/**
+ * @brief Lazy n x n identity, e.g. for identity(n) - dt * lazy(L)
+ */
+inline expr::Identity identity(uword n) { return expr::Identity(n); }
+
+} // namespace mole
+
+#endif // EXPRESSION_H
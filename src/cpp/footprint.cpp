@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file footprint.cpp
+ *
+ * @brief Memory footprint estimates and live-temporary accounting for
+ *        operator construction
+ *
+ * @date 2026/10/19
+ */
+
+#include "footprint.h"
+#include "laplacian.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mole {
+namespace memory {
+
+namespace {
+
+std::atomic<uword> live_bytes(0);
+std::atomic<uword> peak_bytes(0);
+
+Footprint make(uword rows, uword cols, uword nnz) {
+  Footprint f;
+  f.rows = rows;
+  f.cols = cols;
+  f.nnz = nnz;
+  f.bytes = sparseBytes(cols, nnz);
+  return f;
+}
+
+sp_mat build1D(bool gradient, u16 k, u32 m) {
+  if (gradient)
+    return Gradient(k, m, 1.0);
+  return Divergence(k, m, 1.0);
+}
+
+// 2-D/3-D Gradient or Divergence: one kron block per axis, stacked (rows
+// for the gradient, columns for the divergence). Spacing does not change the
+// sparsity, so unit spacing is used for the 1-D factors.
+Estimate stacked(bool gradient, u16 k, const std::vector<u32> &cells) {
+  if (cells.size() == 1) {
+    Estimate e;
+    e.result = footprint(build1D(gradient, k, cells[0]));
+    e.peak_bytes = e.result.bytes;
+    return e;
+  }
+
+  uword centers = 1, interior = 1;
+  for (u32 c : cells) {
+    centers *= c + 2;
+    interior *= c;
+  }
+
+  uword faces = 0, nnz = 0, blocks = 0;
+  for (u32 c : cells) {
+    const uword others = interior / c;
+    const uword block_faces = others * (c + 1);
+    const uword block_nnz = others * build1D(gradient, k, c).n_nonzero;
+    faces += block_faces;
+    nnz += block_nnz;
+    blocks += gradient ? sparseBytes(centers, block_nnz)
+                       : sparseBytes(block_faces, block_nnz);
+  }
+
+  Estimate e;
+  e.result = gradient ? make(faces, centers, nnz) : make(centers, faces, nnz);
+  // Per-axis blocks and their stacked copies, the triplet buffer of the
+  // combining kron/join and the result itself.
+  e.peak_bytes = 2 * blocks + tripletBytes(nnz) + e.result.bytes;
+  return e;
+}
+
+// L = D*G is a sum of kron(I, ..., L_axis, ..., I) terms. Off-diagonal
+// entries of different terms never coincide; diagonals overlap on interior
+// cells, which inclusion-exclusion accounts for.
+Estimate laplacian(u16 k, const std::vector<u32> &cells) {
+  const Estimate D = stacked(false, k, cells);
+  const Estimate G = stacked(true, k, cells);
+
+  uword interior = 1;
+  for (u32 c : cells)
+    interior *= c;
+
+  uword nnz = 0, diagonal = 0, without_diagonal = 1;
+  for (u32 c : cells) {
+    const sp_mat L = Laplacian(k, c, 1.0);
+    uword nonzero_diag = 0;
+    for (uword i = 0; i < L.n_rows; ++i)
+      nonzero_diag += (L(i, i) != 0.0);
+    const uword others = interior / c;
+    nnz += others * L.n_nonzero;
+    diagonal += others * nonzero_diag;
+    without_diagonal *= c - nonzero_diag;
+  }
+  nnz = nnz - diagonal + (interior - without_diagonal);
+
+  Estimate e;
+  e.result = make(D.result.rows, G.result.cols, nnz);
+  // Both factors (multiplied in place, not copied), plus the product and
+  // the multiplication workspace.
+  const uword product = D.result.bytes + G.result.bytes + 2 * e.result.bytes;
+  e.peak_bytes = std::max({D.peak_bytes, D.result.bytes + G.peak_bytes,
+                           product});
+  return e;
+}
+
+std::string human(uword bytes) {
+  const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  double value = static_cast<double>(bytes);
+  int u = 0;
+  while (value >= 1024.0 && u < 4) {
+    value /= 1024.0;
+    ++u;
+  }
+  char text[32];
+  std::snprintf(text, sizeof(text), "%.1f %s", value, units[u]);
+  return text;
+}
+
+} // anonymous namespace
+
+uword sparseBytes(uword cols, uword nnz) {
+  // Armadillo keeps one sentinel past the end of values and row indices and
+  // two extra column pointers.
+  return (nnz + 1) * (sizeof(Real) + sizeof(uword)) + (cols + 2) * sizeof(uword);
+}
+
+Footprint footprint(const sp_mat &A) {
+  return make(A.n_rows, A.n_cols, A.n_nonzero);
+}
+
+uword tripletBytes(uword nnz) { return nnz * (sizeof(Real) + 2 * sizeof(uword)); }
+
+Estimate estimateGradient(u16 k, u32 m) { return stacked(true, k, {m}); }
+Estimate estimateGradient(u16 k, u32 m, u32 n) {
+  return stacked(true, k, {m, n});
+}
+Estimate estimateGradient(u16 k, u32 m, u32 n, u32 o) {
+  return stacked(true, k, {m, n, o});
+}
+
+Estimate estimateDivergence(u16 k, u32 m) { return stacked(false, k, {m}); }
+Estimate estimateDivergence(u16 k, u32 m, u32 n) {
+  return stacked(false, k, {m, n});
+}
+Estimate estimateDivergence(u16 k, u32 m, u32 n, u32 o) {
+  return stacked(false, k, {m, n, o});
+}
+
+Estimate estimateLaplacian(u16 k, u32 m) { return laplacian(k, {m}); }
+Estimate estimateLaplacian(u16 k, u32 m, u32 n) { return laplacian(k, {m, n}); }
+Estimate estimateLaplacian(u16 k, u32 m, u32 n, u32 o) {
+  return laplacian(k, {m, n, o});
+}
+
+void checkBudget(const Estimate &estimate, uword budget, const char *what) {
+  if (estimate.peak_bytes > budget) {
+    throw std::runtime_error(std::string("MOLE: building ") + what +
+                             " needs up to " + human(estimate.peak_bytes) +
+                             ", budget is " + human(budget));
+  }
+}
+
+uword liveBytes() { return live_bytes.load(); }
+
+uword peakBytes() { return peak_bytes.load(); }
+
+void resetPeak() { peak_bytes.store(live_bytes.load()); }
+
+Temporary::Temporary(uword bytes) : bytes(bytes) {
+  const uword now = live_bytes.fetch_add(bytes) + bytes;
+  uword peak = peak_bytes.load();
+  while (now > peak && !peak_bytes.compare_exchange_weak(peak, now)) {
+  }
+}
+
+Temporary::Temporary(const sp_mat &A)
+    : Temporary(sparseBytes(A.n_cols, A.n_nonzero)) {}
+
+Temporary::~Temporary() { live_bytes.fetch_sub(bytes); }
+
+std::ostream &operator<<(std::ostream &out, const Footprint &f) {
+  return out << f.rows << " x " << f.cols << ", nnz " << f.nnz << ", "
+             << human(f.bytes);
+}
+
+std::ostream &operator<<(std::ostream &out, const Estimate &e) {
+  return out << e.result << ", peak <= " << human(e.peak_bytes);
+}
+
+} // namespace memory
+} // namespace mole
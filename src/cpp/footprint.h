@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file footprint.h
+ *
+ * @brief Memory footprint estimates and live-temporary accounting for
+ *        operator construction
+ *
+ * Estimates are analytic: the multidimensional operators are Kronecker
+ * products of 1-D factors, so their nnz follow from the (cheap) 1-D
+ * operators without assembling anything large. The peak figure models the
+ * intermediates the constructors keep alive (kron factors, triplet buffers,
+ * joined blocks, the final sum) and is an upper bound.
+ *
+ * The constructors also register their large intermediates with a global
+ * live/peak counter, so liveBytes()/peakBytes() report what a build
+ * actually held.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include "utils.h"
+#include <iosfwd>
+
+namespace mole {
+namespace memory {
+
+/**
+ * @brief Shape, nnz and storage size of a sparse matrix
+ */
+struct Footprint {
+  uword rows = 0;
+  uword cols = 0;
+  uword nnz = 0;
+  uword bytes = 0;
+};
+
+/**
+ * @brief Predicted result and peak usage of one operator build
+ */
+struct Estimate {
+  Footprint result;
+  uword peak_bytes = 0;
+};
+
+/**
+ * @brief Bytes held by a CSC matrix: values, row indices and column pointers
+ */
+uword sparseBytes(uword cols, uword nnz);
+
+/**
+ * @brief Footprint of an existing matrix
+ */
+Footprint footprint(const sp_mat &A);
+
+/**
+ * @brief Bytes of the (row, col, value) triplet buffers used to assemble
+ *        a matrix with nnz entries through the batch constructor
+ */
+uword tripletBytes(uword nnz);
+
+/**
+ * @brief Estimates for the non-periodic operators
+ *
+ * @param k Order of accuracy
+ * @param m Number of cells in x-direction
+ * @param n Number of cells in y-direction
+ * @param o Number of cells in z-direction
+ *
+ * @note Laplacian nnz is structural; exact cancellations in D*G can make
+ *       the built operator slightly sparser.
+ */
+Estimate estimateGradient(u16 k, u32 m);
+Estimate estimateGradient(u16 k, u32 m, u32 n);
+Estimate estimateGradient(u16 k, u32 m, u32 n, u32 o);
+Estimate estimateDivergence(u16 k, u32 m);
+Estimate estimateDivergence(u16 k, u32 m, u32 n);
+Estimate estimateDivergence(u16 k, u32 m, u32 n, u32 o);
+Estimate estimateLaplacian(u16 k, u32 m);
+Estimate estimateLaplacian(u16 k, u32 m, u32 n);
+Estimate estimateLaplacian(u16 k, u32 m, u32 n, u32 o);
+
+/**
+ * @brief Throws std::runtime_error if the estimated peak exceeds the budget
+ *
+ * @param estimate Result of one of the estimate functions
+ * @param budget   Available bytes
+ * @param what     Label used in the error message
+ */
+void checkBudget(const Estimate &estimate, uword budget,
+                 const char *what = "operator");
+
+/**
+ * @brief Bytes currently registered by live Temporary guards
+ */
+uword liveBytes();
+
+/**
+ * @brief Largest liveBytes() value seen since the last resetPeak()
+ */
+uword peakBytes();
+
+/**
+ * @brief Restarts peak tracking from the current live value
+ */
+void resetPeak();
+
+/**
+ * @brief Registers a buffer with the live/peak counters for its lifetime
+ */
+class Temporary {
+public:
+  explicit Temporary(uword bytes);
+  explicit Temporary(const sp_mat &A);
+  ~Temporary();
+  Temporary(const Temporary &) = delete;
+  Temporary &operator=(const Temporary &) = delete;
+
+private:
+  uword bytes;
+};
+
+std::ostream &operator<<(std::ostream &out, const Footprint &f);
+std::ostream &operator<<(std::ostream &out, const Estimate &e);
+
+} // namespace memory
+} // namespace mole
+
+#endif // FOOTPRINT_H
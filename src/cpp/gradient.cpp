@@ -18,12 +18,34 @@
  */
 
 #include "gradient.h"
+#include "footprint.h"
 #include <vector>
 
 // ============================================================================
 // Private helpers
 // ============================================================================
 
+namespace {
+
+// First rows of the 1-D gradients of order 2, 4, 6 and 8, times dx
+constexpr Real boundaryRows[4][9] = {
+    {-8.0 / 3.0, 3.0, -1.0 / 3.0},
+    {-352.0 / 105.0, 35.0 / 8.0, -35.0 / 24.0, 21.0 / 40.0, -5.0 / 56.0},
+    {-13016.0 / 3465.0, 693.0 / 128.0, -385.0 / 128.0, 693.0 / 320.0,
+     -495.0 / 448.0, 385.0 / 1152.0, -63.0 / 1408.0},
+    {-4856215.0 / 1200963.0, 45858154.0 / 7297397.0,
+     -23409299.0 / 4789435.0, 3799178.0 / 719717.0, -4892189.0 / 1089890.0,
+     1789111.0 / 658879.0, -1406819.0 / 1289899.0, 1154863.0 / 4436807.0,
+     -2936602.0 / 105142673.0}};
+
+} // namespace
+
+const Real *Gradient::boundaryWeights(u16 k) {
+  assert(!(k % 2));
+  assert(k > 1 && k < 9);
+  return boundaryRows[k / 2 - 1];
+}
+
 int Gradient::isPeriodic(const ivec &dc, const ivec &nc) {
   // Periodic when every dc and nc entry for this axis is zero.
   // Iterates both vectors explicitly; no element may be nonzero.
@@ -97,19 +119,19 @@ sp_mat Gradient::periodicGrad1D(u16 k, u32 m, Real dx) {
 // Non-periodic 1-D Constructor
 // ============================================================================
 
-Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
+Gradient::Gradient(u16 k, u32 m, Real dx) : mole::Operator(m + 1, m + 2) {
+  MOLE_PROFILE_SCOPE("Gradient 1-D");
   mole::check_spacing(dx, "dx");
   assert(!(k % 2));
   assert(k > 1 && k < 9);
   assert(m >= 2 * k);
+  const Real *w = boundaryWeights(k);
+  for (u16 j = 0; j <= k; j++) {
+    at(0, j) = w[j];
+    at(m, m + 1 - j) = -w[j];
+  }
   switch (k) {
   case 2:
-    at(0, 0) = -8.0 / 3.0;
-    at(0, 1) = 3.0;
-    at(0, 2) = -1.0 / 3.0;
-    at(m, m + 1) = 8.0 / 3.0;
-    at(m, m) = -3.0;
-    at(m, m - 1) = 1.0 / 3.0;
     for (u32 i = 1; i < m; i++) {
       at(i, i) = -1.0;
       at(i, i + 1) = 1.0;
@@ -117,21 +139,11 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
     P = {3.0 / 8.0, 9.0 / 8.0, 1.0, 9.0 / 8.0, 3.0 / 8.0};
     break;
   case 4:
-    at(0, 0) = -352.0 / 105.0;
-    at(0, 1) = 35.0 / 8.0;
-    at(0, 2) = -35.0 / 24.0;
-    at(0, 3) = 21.0 / 40.0;
-    at(0, 4) = -5.0 / 56.0;
     at(1, 0) = 16.0 / 105.0;
     at(1, 1) = -31.0 / 24.0;
     at(1, 2) = 29.0 / 24.0;
     at(1, 3) = -3.0 / 40.0;
     at(1, 4) = 1.0 / 168.0;
-    at(m, m + 1) = 352.0 / 105.0;
-    at(m, m) = -35.0 / 8.0;
-    at(m, m - 1) = 35.0 / 24.0;
-    at(m, m - 2) = -21.0 / 40.0;
-    at(m, m - 3) = 5.0 / 56.0;
     at(m - 1, m + 1) = -16.0 / 105.0;
     at(m - 1, m) = 31.0 / 24.0;
     at(m - 1, m - 1) = -29.0 / 24.0;
@@ -149,13 +161,6 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
     break;
 
   case 6:
-    at(0, 0) = -13016.0 / 3465.0;
-    at(0, 1) = 693.0 / 128.0;
-    at(0, 2) = -385.0 / 128.0;
-    at(0, 3) = 693.0 / 320.0;
-    at(0, 4) = -495.0 / 448.0;
-    at(0, 5) = 385.0 / 1152.0;
-    at(0, 6) = -63.0 / 1408.0;
     at(1, 0) = 496.0 / 3465.0;
     at(1, 1) = -811.0 / 640.0;
     at(1, 2) = 449.0 / 384.0;
@@ -170,13 +175,6 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
     at(2, 4) = -101.0 / 1344.0;
     at(2, 5) = 1.0 / 128.0;
     at(2, 6) = -3.0 / 7040.0;
-    at(m, m + 1) = 13016.0 / 3465.0;
-    at(m, m) = -693.0 / 128.0;
-    at(m, m - 1) = 385.0 / 128.0;
-    at(m, m - 2) = -693.0 / 320.0;
-    at(m, m - 3) = 495.0 / 448.0;
-    at(m, m - 4) = -385.0 / 1152.0;
-    at(m, m - 5) = 63.0 / 1408.0;
     at(m - 1, m + 1) = -496.0 / 3465.0;
     at(m - 1, m) = 811.0 / 640.0;
     at(m - 1, m - 1) = -449.0 / 384.0;
@@ -207,15 +205,6 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
     break;
 
   case 8:
-    at(0, 0) = -4856215.0 / 1200963.0;
-    at(0, 1) = 45858154.0 / 7297397.0;
-    at(0, 2) = -23409299.0 / 4789435.0;
-    at(0, 3) = 3799178.0 / 719717.0;
-    at(0, 4) = -4892189.0 / 1089890.0;
-    at(0, 5) = 1789111.0 / 658879.0;
-    at(0, 6) = -1406819.0 / 1289899.0;
-    at(0, 7) = 1154863.0 / 4436807.0;
-    at(0, 8) = -2936602.0 / 105142673.0;
     at(1, 0) = 86048.0 / 675675.0;
     at(1, 1) = -131093.0 / 107520.0;
     at(1, 2) = 5503131.0 / 5166017.0;
@@ -243,15 +232,6 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
     at(3, 6) = 639.0 / 56320.0;
     at(3, 7) = -15.0 / 13312.0;
     at(3, 8) = 1.0 / 21504.0;
-    at(m, m + 1) = 4856215.0 / 1200963.0;
-    at(m, m) = -45858154.0 / 7297397.0;
-    at(m, m - 1) = 23409299.0 / 4789435.0;
-    at(m, m - 2) = -3799178.0 / 719717.0;
-    at(m, m - 3) = 4892189.0 / 1089890.0;
-    at(m, m - 4) = -1789111.0 / 658879.0;
-    at(m, m - 5) = 1406819.0 / 1289899.0;
-    at(m, m - 6) = -1154863.0 / 4436807.0;
-    at(m, m - 7) = 2936602.0 / 105142673.0;
     at(m - 1, m + 1) = -86048.0 / 675675.0;
     at(m - 1, m) = 131093.0 / 107520.0;
     at(m - 1, m - 1) = -5503131.0 / 5166017.0;
@@ -298,6 +278,7 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
     break;
   }
   *this /= dx;
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 //  Helper: returns an s×(s+2) sparse matrix used as the interior-node
@@ -327,6 +308,7 @@ void Gradient::build_gradient(sp_mat &G_m, sp_mat &I, u16 k, u32 dim,
 // ============================================================================
 
 Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  MOLE_PROFILE_SCOPE("Gradient 2-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   Gradient Gx(k, m, dx);
@@ -337,6 +319,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
 
   sp_mat G1 = Utils::spkron(In, Gx);
   sp_mat G2 = Utils::spkron(Gy, Im);
+  mole::memory::Temporary held1(G1), held2(G2);
 
   if (m != n) {
     *this = Utils::spjoin_cols(G1, G2);
@@ -345,6 +328,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
     A1(0, 0) = A2(1, 0) = 1.0;
     *this = Utils::spkron(A1, G1) + Utils::spkron(A2, G2);
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -352,6 +336,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
 // ============================================================================
 
 Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  MOLE_PROFILE_SCOPE("Gradient 3-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   mole::check_spacing(dz, "dz");
@@ -366,6 +351,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
   sp_mat G1 = Utils::spkron(Utils::spkron(Io, In), Gx);
   sp_mat G2 = Utils::spkron(Utils::spkron(Io, Gy), Im);
   sp_mat G3 = Utils::spkron(Utils::spkron(Gz, In), Im);
+  mole::memory::Temporary held1(G1), held2(G2), held3(G3);
 
   if ((m != n) || (n != o)) {
     *this = Utils::spjoin_cols(Utils::spjoin_cols(G1, G2), G3);
@@ -375,6 +361,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
     *this =
         Utils::spkron(A1, G1) + Utils::spkron(A2, G2) + Utils::spkron(A3, G3);
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -382,7 +369,8 @@ Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
 // ============================================================================
 
 Gradient::Gradient(u16 k, u32 m, Real dx, const ivec &dc, const ivec &nc)
-    : sp_mat() {
+    : mole::Operator() {
+  MOLE_PROFILE_SCOPE("Gradient 1-D");
   mole::check_spacing(dx, "dx");
   assert(dc.n_elem == 2 && nc.n_elem == 2);
 
@@ -395,6 +383,7 @@ Gradient::Gradient(u16 k, u32 m, Real dx, const ivec &dc, const ivec &nc)
     this->sp_mat::operator=(tmp);
     P = tmp.P;
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ===========================================================================
@@ -403,7 +392,8 @@ Gradient::Gradient(u16 k, u32 m, Real dx, const ivec &dc, const ivec &nc)
 
 Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy, const ivec &dc,
                    const ivec &nc)
-    : sp_mat() {
+    : mole::Operator() {
+  MOLE_PROFILE_SCOPE("Gradient 2-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   assert(dc.n_elem == 4 && nc.n_elem == 4);
@@ -424,6 +414,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy, const ivec &dc,
   sp_mat G1 = Utils::spkron(In, Gx_m);
   sp_mat G2 = Utils::spkron(Gy_m, Im);
   *this = Utils::spjoin_cols(G1, G2);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -431,7 +422,8 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy, const ivec &dc,
 // ============================================================================
 Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
                    const ivec &dc, const ivec &nc)
-    : sp_mat() {
+    : mole::Operator() {
+  MOLE_PROFILE_SCOPE("Gradient 3-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   mole::check_spacing(dz, "dz");
@@ -460,6 +452,7 @@ Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
   sp_mat G3 = Utils::spkron(Utils::spkron(Gz_m, In), Im);
 
   *this = Utils::spjoin_cols(Utils::spjoin_cols(G1, G2), G3);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // ============================================================================
@@ -28,7 +28,7 @@
  * representing a0 and b0 in the condition a0*U + b0*dU/dn = g.
  * An axis is treated as periodic when all of its dc and nc entries are zero.
  */
-class Gradient : public sp_mat {
+class Gradient : public mole::Operator {
 public:
   using sp_mat::operator=;
 
@@ -138,6 +138,15 @@ public:
    */
   vec getP();
 
+  /**
+   * @brief First row of the 1-D gradient of order k, times dx
+   *
+   * Holds k + 1 weights, for columns 0..k. The last row mirrors it:
+   * G(m, m + 1 - j) = -w[j] / dx. Boundary operators read their rows here
+   * instead of building the whole gradient.
+   */
+  static const Real *boundaryWeights(u16 k);
+
 private:
   vec P;
 
@@ -0,0 +1,44 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file gradientCurv.cpp
+ *
+ * @brief Mimetic Gradient Operators on curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "gradientCurv.h"
+
+GradientCurv::GradientCurv(const CurvilinearMetrics &metrics) {
+  MOLE_PROFILE_SCOPE("GradientCurv");
+  const u16 d = metrics.dimensions();
+
+  std::vector<const sp_mat *> logical(d);
+  for (u16 a = 0; a < d; ++a)
+    logical[a] = &metrics.logicalGradient(a);
+
+  // Physical components on the centers, then out to the faces normal to
+  // each axis
+  for (u16 i = 0; i < d; ++i) {
+    const sp_mat Gi =
+        metrics.expand(i, metrics.axis(i).ICF) * metrics.transform(i, logical);
+    if (i == 0)
+      *this = Gi;
+    else
+      *this = Utils::spjoin_cols(*this, Gi);
+  }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
+
+GradientCurv::GradientCurv(u16 k, const mat &X, const mat &Y, const ivec &dc,
+                           const ivec &nc)
+    : GradientCurv(CurvilinearMetrics(k, X, Y, dc, nc)) {}
+
+GradientCurv::GradientCurv(u16 k, const cube &X, const cube &Y, const cube &Z,
+                           const ivec &dc, const ivec &nc)
+    : GradientCurv(CurvilinearMetrics(k, X, Y, Z, dc, nc)) {}
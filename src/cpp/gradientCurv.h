@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file gradientCurv.h
+ *
+ * @brief Mimetic Gradient Operators on curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef GRADIENTCURV_H
+#define GRADIENTCURV_H
+
+#include "metrics.h"
+
+/**
+ * @brief Curvilinear mimetic Gradient operator (grad2DCurv / grad3DCurv)
+ *
+ * Acts on cell centers (boundary centers included) and outputs to the
+ * extended faces, stacked x, y[, z]:
+ *
+ *   G_i = kron(..., ICF_i, ...) * sum_a diag(dxi_a/dx_i) * (IFC_a * G_a)
+ *
+ * where G_a and IFC_a are the 1-D logical gradient and faces-to-centers
+ * interpolator along axis a.
+ */
+class GradientCurv : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief Gradient on a grid whose metrics are already computed
+   *
+   * @param metrics Shared metric terms, e.g. also used by a DivergenceCurv
+   */
+  explicit GradientCurv(const CurvilinearMetrics &metrics);
+
+  /**
+   * @brief 2-D Curvilinear Mimetic Gradient Constructor
+   *
+   * @param k  Order of accuracy
+   * @param X  x-coordinates of the centers (Utils::meshgrid layout)
+   * @param Y  y-coordinates of the centers
+   * @param dc Dirichlet coefficients for the left, right, bottom, and top boundaries
+   * @param nc Neumann coefficients for the left, right, bottom, and top boundaries
+   */
+  GradientCurv(u16 k, const mat &X, const mat &Y, const ivec &dc,
+               const ivec &nc);
+
+  /**
+   * @brief 3-D Curvilinear Mimetic Gradient Constructor
+   *
+   * @param k       Order of accuracy
+   * @param X, Y, Z Coordinates of the centers (3-D Utils::meshgrid layout)
+   * @param dc      Dirichlet coefficients for the left, right, bottom, top, front, and back boundaries
+   * @param nc      Neumann coefficients for the left, right, bottom, top, front, and back boundaries
+   */
+  GradientCurv(u16 k, const cube &X, const cube &Y, const cube &Z,
+               const ivec &dc, const ivec &nc);
+};
+
+#endif // GRADIENTCURV_H
@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file gradientNonUniform.cpp
+ *
+ * @brief Mimetic Gradient Operators on non-uniform grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "gradientNonUniform.h"
+
+namespace {
+
+// s x (s+2): picks the interior centers of an axis
+sp_mat interior(u32 s) {
+  sp_mat I(s, s + 2);
+  for (u32 i = 0; i < s; ++i)
+    I(i, i + 1) = 1.0;
+  return I;
+}
+
+} // anonymous namespace
+
+GradientNonUniform::GradientNonUniform(u16 k, const vec &xticks) {
+  MOLE_PROFILE_SCOPE("GradientNonUniform 1-D");
+  assemble(NonUniformKernel(NonUniformKernel::Kind::Gradient, k, xticks));
+}
+
+GradientNonUniform::GradientNonUniform(u16 k, const vec &xticks,
+                                       const vec &yticks) {
+  MOLE_PROFILE_SCOPE("GradientNonUniform 2-D");
+  assemble(
+      NonUniformKernel(NonUniformKernel::Kind::Gradient, k, xticks, yticks));
+}
+
+GradientNonUniform::GradientNonUniform(u16 k, const vec &xticks,
+                                       const vec &yticks, const vec &zticks) {
+  MOLE_PROFILE_SCOPE("GradientNonUniform 3-D");
+  assemble(NonUniformKernel(NonUniformKernel::Kind::Gradient, k, xticks,
+                            yticks, zticks));
+}
+
+void GradientNonUniform::assemble(const NonUniformKernel &kernel) {
+  // The 1-D factors already carry their Jacobians, so the 2-D/3-D operators
+  // are plain Kronecker products of them (grad2DNonUniform.m).
+  const sp_mat &Gx = kernel.factor(0);
+  if (kernel.dimensions() == 1) {
+    *this = Gx;
+  } else if (kernel.dimensions() == 2) {
+    const sp_mat &Gy = kernel.factor(1);
+    const sp_mat Im = interior(kernel.cells(0));
+    const sp_mat In = interior(kernel.cells(1));
+    *this = Utils::spjoin_cols(Utils::spkron(In, Gx), Utils::spkron(Gy, Im));
+  } else {
+    const sp_mat &Gy = kernel.factor(1);
+    const sp_mat &Gz = kernel.factor(2);
+    const sp_mat Im = interior(kernel.cells(0));
+    const sp_mat In = interior(kernel.cells(1));
+    const sp_mat Io = interior(kernel.cells(2));
+    const sp_mat G1 = Utils::spkron(Utils::spkron(Io, In), Gx);
+    const sp_mat G2 = Utils::spkron(Utils::spkron(Io, Gy), Im);
+    const sp_mat G3 = Utils::spkron(Utils::spkron(Gz, In), Im);
+    *this = Utils::spjoin_cols(Utils::spjoin_cols(G1, G2), G3);
+  }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
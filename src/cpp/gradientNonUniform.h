@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file gradientNonUniform.h
+ *
+ * @brief Mimetic Gradient Operators on non-uniform grids
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef GRADIENTNONUNIFORM_H
+#define GRADIENTNONUNIFORM_H
+
+#include "nonuniform.h"
+
+/**
+ * @brief Non-uniform mimetic Gradient (gradNonUniform, grad2DNonUniform,
+ *        grad3DNonUniform)
+ *
+ * Ticks are the cell centers including both boundaries (m+2 values for m
+ * cells). For applying the operator without assembling it, see
+ * NonUniformKernel.
+ */
+class GradientNonUniform : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief 1-D Non-uniform Mimetic Gradient Constructor
+   *
+   * @param k      Order of accuracy
+   * @param xticks Cell centers and boundaries, strictly increasing
+   */
+  GradientNonUniform(u16 k, const vec &xticks);
+
+  /**
+   * @brief 2-D Non-uniform Mimetic Gradient Constructor
+   *
+   * @param k      Order of accuracy
+   * @param xticks Cell centers and boundaries along x
+   * @param yticks Cell centers and boundaries along y
+   */
+  GradientNonUniform(u16 k, const vec &xticks, const vec &yticks);
+
+  /**
+   * @brief 3-D Non-uniform Mimetic Gradient Constructor
+   *
+   * @param k      Order of accuracy
+   * @param xticks Cell centers and boundaries along x
+   * @param yticks Cell centers and boundaries along y
+   * @param zticks Cell centers and boundaries along z
+   */
+  GradientNonUniform(u16 k, const vec &xticks, const vec &yticks,
+                     const vec &zticks);
+
+private:
+  void assemble(const NonUniformKernel &kernel);
+};
+
+#endif // GRADIENTNONUNIFORM_H
@@ -0,0 +1,226 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file gridgen.cpp
+ *
+ * @brief Boundary-fitted grid generation by transfinite interpolation and
+ *        by elliptic smoothing
+ *
+ * @date 2026/10/19
+ */
+
+#include "gridgen.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+using Curve = CurvilinearGrid::Curve;
+
+// Logical ticks: nodes i/m, or centers (i - 1/2)/m with 0 and 1 added
+vec nodeTicks(u32 m) { return linspace(0.0, 1.0, m + 1); }
+
+vec centerTicks(u32 m, bool boundaries) {
+  vec t(boundaries ? m + 2 : m);
+  const uword first = boundaries ? 1 : 0;
+  for (u32 i = 0; i < m; ++i)
+    t(first + i) = (i + 0.5) / m;
+  if (boundaries) {
+    t(0) = 0.0;
+    t(m + 1) = 1.0;
+  }
+  return t;
+}
+
+// Transfinite interpolation at every (xi(i), eta(j)), meshgrid layout
+void blend(const vec &xi, const vec &eta, const Curve &bottom,
+           const Curve &top, const Curve &left, const Curve &right, mat &X,
+           mat &Y) {
+  // Each curve is sampled once per tick instead of once per point
+  std::vector<std::array<Real, 2>> B(xi.n_elem), T(xi.n_elem);
+  std::vector<std::array<Real, 2>> L(eta.n_elem), R(eta.n_elem);
+  for (uword i = 0; i < xi.n_elem; ++i) {
+    B[i] = bottom(xi(i));
+    T[i] = top(xi(i));
+  }
+  for (uword j = 0; j < eta.n_elem; ++j) {
+    L[j] = left(eta(j));
+    R[j] = right(eta(j));
+  }
+  const std::array<Real, 2> b0 = bottom(0.0), b1 = bottom(1.0);
+  const std::array<Real, 2> t0 = top(0.0), t1 = top(1.0);
+
+  X.set_size(eta.n_elem, xi.n_elem);
+  Y.set_size(eta.n_elem, xi.n_elem);
+  mat *out[2] = {&X, &Y};
+
+  // Columns are contiguous, so each thread fills whole columns
+#pragma omp parallel for schedule(static)
+  for (uword i = 0; i < xi.n_elem; ++i) {
+    const Real u = xi(i);
+    for (int c = 0; c < 2; ++c) {
+      Real *col = out[c]->colptr(i);
+      for (uword j = 0; j < eta.n_elem; ++j) {
+        const Real v = eta(j);
+        col[j] = (1 - v) * B[i][c] + v * T[i][c] + (1 - u) * L[j][c] +
+                 u * R[j][c] -
+                 (u * v * t1[c] + u * (1 - v) * b1[c] + v * (1 - u) * t0[c] +
+                  (1 - u) * (1 - v) * b0[c]);
+      }
+    }
+  }
+}
+
+// One sweep of ttm.m: every interior node from the previous iterate (X,
+// Y) into (newX, newY), on at least 3 x 3 nodes. Returns the largest
+// change of a coordinate.
+Real ttmSweep(const mat &X, const mat &Y, mat &newX, mat &newY) {
+  const uword rows = X.n_rows, cols = X.n_cols;
+  const mat *in[2] = {&X, &Y};
+  mat *out[2] = {&newX, &newY};
+  Real change = 0.0;
+
+#pragma omp parallel for schedule(static) reduction(max : change)
+  for (uword i = 1; i < cols - 1; ++i) {
+    for (uword j = 1; j < rows - 1; ++j) {
+      const Real xEta = X(j + 1, i) - X(j - 1, i);
+      const Real yEta = Y(j + 1, i) - Y(j - 1, i);
+      const Real xXi = X(j, i + 1) - X(j, i - 1);
+      const Real yXi = Y(j, i + 1) - Y(j, i - 1);
+      const Real alpha = 0.25 * (xEta * xEta + yEta * yEta);
+      const Real beta = 0.0625 * (xXi * xEta + yXi * yEta);
+      const Real gamma = 0.25 * (xXi * xXi + yXi * yXi);
+      const Real scale = -0.5 / (alpha + gamma + 1e-10);
+      for (int c = 0; c < 2; ++c) {
+        const mat &A = *in[c];
+        const Real value =
+            scale * (2 * beta *
+                         (A(j + 1, i + 1) - A(j + 1, i - 1) -
+                          A(j - 1, i + 1) + A(j - 1, i - 1)) -
+                     alpha * (A(j, i + 1) + A(j, i - 1)) -
+                     gamma * (A(j + 1, i) + A(j - 1, i)));
+        change = std::max(change, std::abs(value - A(j, i)));
+        (*out[c])(j, i) = value;
+      }
+    }
+  }
+  return change;
+}
+
+// Positions of the nodes (even) or of the centers (odd, with the two
+// boundary ends if asked) of an axis with m cells, on the refined axis
+uvec refinedNodes(u32 m) { return regspace<uvec>(0, 2, 2 * m); }
+
+uvec refinedCenters(u32 m, bool boundaries) {
+  uvec r(boundaries ? m + 2 : m);
+  const uword first = boundaries ? 1 : 0;
+  for (u32 i = 0; i < m; ++i)
+    r(first + i) = 2 * i + 1;
+  if (boundaries) {
+    r(0) = 0;
+    r(m + 1) = 2 * m;
+  }
+  return r;
+}
+
+mat pick(const mat &A, const uvec &rows, const uvec &cols) {
+  mat out(rows.n_elem, cols.n_elem);
+  for (uword i = 0; i < cols.n_elem; ++i)
+    for (uword j = 0; j < rows.n_elem; ++j)
+      out(j, i) = A(rows(j), cols(i));
+  return out;
+}
+
+} // anonymous namespace
+
+CurvilinearGrid CurvilinearGrid::tfi(u32 m, u32 n, const Curve &bottom,
+                                     const Curve &top, const Curve &left,
+                                     const Curve &right) {
+  MOLE_PROFILE_SCOPE("CurvilinearGrid::tfi");
+  if (m == 0 || n == 0)
+    throw std::invalid_argument("MOLE: a grid needs at least one cell along "
+                                "each axis");
+
+  CurvilinearGrid grid(m, n);
+  const vec xn = nodeTicks(m), yn = nodeTicks(n);
+  const vec xc = centerTicks(m, true), yc = centerTicks(n, true);
+  const vec xf = centerTicks(m, false), yf = centerTicks(n, false);
+
+  const size_t nodes = index(Location::Nodes),
+               centers = index(Location::Centers),
+               xfaces = index(Location::XFaces),
+               yfaces = index(Location::YFaces);
+  blend(xn, yn, bottom, top, left, right, grid.X[nodes], grid.Y[nodes]);
+  blend(xc, yc, bottom, top, left, right, grid.X[centers], grid.Y[centers]);
+  blend(xn, yf, bottom, top, left, right, grid.X[xfaces], grid.Y[xfaces]);
+  blend(xf, yn, bottom, top, left, right, grid.X[yfaces], grid.Y[yfaces]);
+  return grid;
+}
+
+CurvilinearGrid CurvilinearGrid::ttm(u32 m, u32 n, const Curve &bottom,
+                                     const Curve &top, const Curve &left,
+                                     const Curve &right, u32 iters,
+                                     Real tol) {
+  MOLE_PROFILE_SCOPE("CurvilinearGrid::ttm");
+  if (m == 0 || n == 0)
+    throw std::invalid_argument("MOLE: a grid needs at least one cell along "
+                                "each axis");
+
+  // The boundary nodes keep their curve values; the interior starts from
+  // the TFI grid
+  mat X, Y;
+  blend(nodeTicks(2 * m), nodeTicks(2 * n), bottom, top, left, right, X, Y);
+  mat newX = X, newY = Y;
+  u32 sweeps = 0;
+  while (sweeps < iters) {
+    const Real change = ttmSweep(X, Y, newX, newY);
+    X.swap(newX);
+    Y.swap(newY);
+    ++sweeps;
+    if (change < tol)
+      break;
+  }
+  MOLE_PROFILE_COUNT("sweeps", sweeps);
+
+  CurvilinearGrid grid(m, n);
+  const uvec xn = refinedNodes(m), yn = refinedNodes(n);
+  const uvec xc = refinedCenters(m, true), yc = refinedCenters(n, true);
+  const uvec xf = refinedCenters(m, false), yf = refinedCenters(n, false);
+  // Rows and columns of every Location, in its declaration order
+  const uvec *ticks[4][2] = {
+      {&yn, &xn}, {&yc, &xc}, {&yf, &xn}, {&yn, &xf}};
+  for (size_t l = 0; l < 4; ++l) {
+    grid.X[l] = pick(X, *ticks[l][0], *ticks[l][1]);
+    grid.Y[l] = pick(Y, *ticks[l][0], *ticks[l][1]);
+  }
+  return grid;
+}
+
+const CurvilinearMetrics &CurvilinearGrid::metrics(u16 k, const ivec &dc,
+                                                   const ivec &nc) const {
+  assert(dc.n_elem == 4 && nc.n_elem == 4);
+  std::lock_guard<std::mutex> guard(cache->lock);
+  for (const Cached &c : cache->entries)
+    if (c.k == k && all(c.dc == dc) && all(c.nc == nc))
+      return *c.metrics;
+
+  // Periodic axes carry no boundary centers
+  const bool px = !any(dc.subvec(0, 1)) && !any(nc.subvec(0, 1));
+  const bool py = !any(dc.subvec(2, 3)) && !any(nc.subvec(2, 3));
+  const mat &Xc = X[index(Location::Centers)];
+  const mat &Yc = Y[index(Location::Centers)];
+  const uword r0 = py ? 1 : 0, r1 = py ? n : n + 1;
+  const uword c0 = px ? 1 : 0, c1 = px ? m : m + 1;
+
+  const mat Xs = Xc.submat(r0, c0, r1, c1), Ys = Yc.submat(r0, c0, r1, c1);
+  auto computed =
+      std::make_shared<const CurvilinearMetrics>(k, Xs, Ys, dc, nc);
+  cache->entries.push_back({k, dc, nc, computed});
+  return *computed;
+}
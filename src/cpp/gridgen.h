@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file gridgen.h
+ *
+ * @brief Boundary-fitted grid generation by transfinite interpolation and
+ *        by elliptic smoothing
+ *
+ * The C++ counterpart of tfi.m and ttm.m (the TFI and TTM methods of
+ * gridGen.m).
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef GRIDGEN_H
+#define GRIDGEN_H
+
+#include "metrics.h"
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief A 2-D boundary-fitted grid and its metrics
+ *
+ * Holds the physical coordinates of the nodes, cell centers and faces of
+ * a logically rectangular grid with m x n cells. All coordinate matrices
+ * use the Utils::meshgrid layout (rows follow y, columns follow x), so
+ * centers() can be passed to GradientCurv and DivergenceCurv directly.
+ *
+ * Metrics are computed on first request for a given (k, dc, nc) and kept,
+ * so every operator built on the grid shares them. The cache is guarded by
+ * a lock and shared by copies of the grid, so metrics() may be called from
+ * several threads.
+ */
+class CurvilinearGrid {
+public:
+  /**
+   * @brief Boundary curve, maps t in [0, 1] to a point (x, y)
+   */
+  using Curve = std::function<std::array<Real, 2>(Real)>;
+
+  /**
+   * @brief Where coordinates are given
+   */
+  enum class Location {
+    Nodes,   // (n+1) x (m+1)
+    Centers, // (n+2) x (m+2), boundary centers included
+    XFaces,  // n x (m+1), faces normal to xi
+    YFaces   // (n+1) x m, faces normal to eta
+  };
+
+  /**
+   * @brief Transfinite interpolation (tfi.m)
+   *
+   * Each curve is sampled once per logical coordinate it is needed at,
+   * then the interior points are blended in parallel. The curves are
+   * only called from the calling thread.
+   *
+   * @param m      Number of cells along xi
+   * @param n      Number of cells along eta
+   * @param bottom Curve at eta = 0, from left to right
+   * @param top    Curve at eta = 1, from left to right
+   * @param left   Curve at xi = 0, from bottom to top
+   * @param right  Curve at xi = 1, from bottom to top
+   *
+   * @throws std::invalid_argument if m or n is zero
+   */
+  static CurvilinearGrid tfi(u32 m, u32 n, const Curve &bottom,
+                             const Curve &top, const Curve &left,
+                             const Curve &right);
+
+  /**
+   * @brief Elliptic (Thompson-Thames-Mastin) grid, ttm.m
+   *
+   * Iterates the smoothing sweep of ttm.m, in which every interior node is
+   * updated from the previous iterate, until no coordinate moves by more
+   * than tol. The iteration starts from the TFI grid instead of zeros, so
+   * it needs far fewer sweeps, and each sweep runs in parallel.
+   *
+   * ttm.m only places nodes. To give centers and faces the same smoothing,
+   * the sweeps run on the grid refined twice along each axis. Its even
+   * nodes are the nodes, and its odd ones the faces and cell centers.
+   *
+   * @param iters Maximum number of sweeps
+   * @param tol   Largest coordinate change at which the sweeps stop
+   *
+   * @throws std::invalid_argument if m or n is zero
+   */
+  static CurvilinearGrid ttm(u32 m, u32 n, const Curve &bottom,
+                             const Curve &top, const Curve &left,
+                             const Curve &right, u32 iters,
+                             Real tol = 1e-6);
+
+  /**
+   * @brief Number of cells along an axis (0: xi, 1: eta)
+   */
+  u32 cells(u16 axis) const { return axis == 0 ? m : n; }
+
+  /**
+   * @brief Physical coordinates at a location
+   */
+  const mat &x(Location where) const { return X[index(where)]; }
+  const mat &y(Location where) const { return Y[index(where)]; }
+
+  /**
+   * @brief Metrics of the cell centers, computed once per (k, dc, nc)
+   *
+   * Along a periodic axis the boundary centers are dropped, as
+   * CurvilinearMetrics expects.
+   *
+   * @param k  Order of accuracy
+   * @param dc Dirichlet coefficients for the left, right, bottom, and top
+   *           boundaries
+   * @param nc Neumann coefficients for the left, right, bottom, and top
+   *           boundaries
+   */
+  const CurvilinearMetrics &metrics(u16 k, const ivec &dc,
+                                    const ivec &nc) const;
+
+private:
+  CurvilinearGrid(u32 m, u32 n) : m(m), n(n) {}
+
+  static size_t index(Location where) { return static_cast<size_t>(where); }
+
+  struct Cached {
+    u16 k;
+    ivec dc, nc;
+    std::shared_ptr<const CurvilinearMetrics> metrics;
+  };
+
+  struct Cache {
+    std::mutex lock;
+    std::vector<Cached> entries;
+  };
+
+  u32 m, n;
+  std::array<mat, 4> X, Y;
+  std::shared_ptr<Cache> cache = std::make_shared<Cache>();
+};
+
+#endif // GRIDGEN_H
@@ -16,7 +16,8 @@
 #include "interpol.h"
 
 // 1-D Constructor
-Interpol::Interpol(u32 m, Real c) : sp_mat(m + 1, m + 2) {
+Interpol::Interpol(u32 m, Real c) : mole::Operator(m + 1, m + 2) {
+  MOLE_PROFILE_SCOPE("Interpol 1-D");
   assert(m >= 4);
   assert(c >= 0 && c <= 1);
 
@@ -27,10 +28,12 @@ Interpol::Interpol(u32 m, Real c) : sp_mat(m + 1, m + 2) {
     at(i, i) = c;
     at(i, i + 1) = 1 - c;
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor
 Interpol::Interpol(u32 m, u32 n, Real c1, Real c2) {
+  MOLE_PROFILE_SCOPE("Interpol 2-D");
   Interpol Ix(m, c1);
   Interpol Iy(n, c2);
 
@@ -54,10 +57,12 @@ Interpol::Interpol(u32 m, u32 n, Real c1, Real c2) {
     A1(0, 0) = A2(1, 0) = 1.0;
     *this = Utils::spkron(A1, I1) + Utils::spkron(A2, I2);
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor
 Interpol::Interpol(u32 m, u32 n, u32 o, Real c1, Real c2, Real c3) {
+  MOLE_PROFILE_SCOPE("Interpol 3-D");
   Interpol Ix(m, c1);
   Interpol Iy(n, c2);
   Interpol Iz(o, c3);
@@ -88,10 +93,12 @@ Interpol::Interpol(u32 m, u32 n, u32 o, Real c1, Real c2, Real c3) {
     *this =
         Utils::spkron(A1, I1) + Utils::spkron(A2, I2) + Utils::spkron(A3, I3);
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 1-D Constructor for second type
-Interpol::Interpol(bool type, u32 m, Real c) : sp_mat(m + 2, m + 1) {
+Interpol::Interpol(bool type, u32 m, Real c) : mole::Operator(m + 2, m + 1) {
+  MOLE_PROFILE_SCOPE("Interpol 1-D");
   assert(m >= 4 && "m >= 4");
   assert(c >= 0 && c <= 1 && "0 <= c <= 1");
 
@@ -106,10 +113,12 @@ Interpol::Interpol(bool type, u32 m, Real c) : sp_mat(m + 2, m + 1) {
     at(i, j + 1) = avg(1);
     j++;
   }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor for second type
 Interpol::Interpol(bool type, u32 m, u32 n, Real c1, Real c2) {
+  MOLE_PROFILE_SCOPE("Interpol 2-D");
   Interpol Ix(true, m, c1);
   Interpol Iy(true, n, c2);
 
@@ -123,10 +132,12 @@ Interpol::Interpol(bool type, u32 m, u32 n, Real c1, Real c2) {
   sp_mat Sy = Utils::spkron(Iy, Im);
 
   *this = Utils::spjoin_rows(Sx, Sy);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor for second type
 Interpol::Interpol(bool type, u32 m, u32 n, u32 o, Real c1, Real c2, Real c3) {
+  MOLE_PROFILE_SCOPE("Interpol 3-D");
   Interpol Ix(true, m, c1);
   Interpol Iy(true, n, c2);
   Interpol Iz(true, o, c3);
@@ -145,4 +156,5 @@ Interpol::Interpol(bool type, u32 m, u32 n, u32 o, Real c1, Real c2, Real c3) {
   sp_mat Sz = Utils::spkron(Utils::spkron(Iz, In), Im);
 
   *this = Utils::spjoin_rows(Utils::spjoin_rows(Sx, Sy), Sz);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
@@ -22,7 +22,7 @@
  * @brief Mimetic Interpolator operator
  *
  */
-class Interpol : public sp_mat {
+class Interpol : public mole::Operator {
 
 public:
   using sp_mat::operator=;
@@ -18,6 +18,7 @@
 // 1-D Constructor
 InterpolCtoF::InterpolCtoF(u16 k, u32 m, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolCtoF 1-D");
     assert(dc.n_elem == 2);
     assert(nc.n_elem == 2);
 
@@ -35,11 +36,13 @@ InterpolCtoF::InterpolCtoF(u16 k, u32 m, const ivec& dc, const ivec& nc)
     }
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor
 InterpolCtoF::InterpolCtoF(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolCtoF 2-D");
     assert(dc.n_elem == 4);
     assert(nc.n_elem == 4);
 
@@ -83,11 +86,13 @@ InterpolCtoF::InterpolCtoF(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
     I(arma::span(I1.n_rows, I.n_rows - 1), arma::span(I1.n_cols, I.n_cols - 1)) = I2;
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor
 InterpolCtoF::InterpolCtoF(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolCtoF 3-D");
     assert(dc.n_elem == 6);
     assert(nc.n_elem == 6);
 
@@ -146,10 +151,11 @@ InterpolCtoF::InterpolCtoF(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ive
     I(arma::span(I1.n_rows + I2.n_rows, I.n_rows - 1), arma::span(I1.n_cols + I2.n_cols, I.n_cols - 1)) = I3;
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 1-D Nonperiodic Constructor
-InterpolCtoF::InterpolCtoF(u16 k, u32 m) : sp_mat(m + 1, m + 2)
+InterpolCtoF::InterpolCtoF(u16 k, u32 m) : mole::Operator(m + 1, m + 2)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
@@ -332,7 +338,7 @@ InterpolCtoF::InterpolCtoF(u16 k, u32 m) : sp_mat(m + 1, m + 2)
 }
 
 // 1-D Periodic Constructor
-InterpolCtoF::InterpolCtoF(u16 k, u32 m, bool dummy) : sp_mat(m, m)
+InterpolCtoF::InterpolCtoF(u16 k, u32 m, bool dummy) : mole::Operator(m, m)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
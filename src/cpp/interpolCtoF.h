@@ -22,7 +22,7 @@
  * @brief Mimetic Interpolator operator from the Centers to Faces
  * 
  */
-class InterpolCtoF : public sp_mat {
+class InterpolCtoF : public mole::Operator {
 
 public:
     using sp_mat::operator=;
@@ -18,6 +18,7 @@
 // 1-D Constructor
 InterpolCtoN::InterpolCtoN(u16 k, u32 m, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolCtoN 1-D");
     assert(dc.n_elem == 2);
     assert(nc.n_elem == 2);
 
@@ -35,11 +36,13 @@ InterpolCtoN::InterpolCtoN(u16 k, u32 m, const ivec& dc, const ivec& nc)
     }
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor
 InterpolCtoN::InterpolCtoN(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolCtoN 2-D");
     assert(dc.n_elem == 4);
     assert(nc.n_elem == 4);
 
@@ -68,11 +71,13 @@ InterpolCtoN::InterpolCtoN(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
 
     // Join
     *this = Utils::spkron(Iy, Ix);
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor
 InterpolCtoN::InterpolCtoN(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolCtoN 3-D");
     assert(dc.n_elem == 6);
     assert(nc.n_elem == 6);
 
@@ -110,10 +115,11 @@ InterpolCtoN::InterpolCtoN(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ive
 
     // Join
     *this = Utils::spkron(Iz, Utils::spkron(Iy, Ix));
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 1-D Nonperiodic Constructor
-InterpolCtoN::InterpolCtoN(u16 k, u32 m) : sp_mat(m + 1, m + 2)
+InterpolCtoN::InterpolCtoN(u16 k, u32 m) : mole::Operator(m + 1, m + 2)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
@@ -297,7 +303,7 @@ InterpolCtoN::InterpolCtoN(u16 k, u32 m) : sp_mat(m + 1, m + 2)
 }
 
 // 1-D Periodic Constructor
-InterpolCtoN::InterpolCtoN(u16 k, u32 m, bool dummy) : sp_mat(m, m)
+InterpolCtoN::InterpolCtoN(u16 k, u32 m, bool dummy) : mole::Operator(m, m)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
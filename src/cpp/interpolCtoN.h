@@ -23,7 +23,7 @@
  * @brief Mimetic Interpolator operators from the Centers to Nodes
  * 
  */
-class InterpolCtoN : public sp_mat
+class InterpolCtoN : public mole::Operator
 {
 public:
     using sp_mat::operator=;
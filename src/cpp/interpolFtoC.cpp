@@ -18,6 +18,7 @@
 // 1-D Constructor
 InterpolFtoC::InterpolFtoC(u16 k, u32 m, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolFtoC 1-D");
     assert(dc.n_elem == 2);
     assert(nc.n_elem == 2);
 
@@ -35,11 +36,13 @@ InterpolFtoC::InterpolFtoC(u16 k, u32 m, const ivec& dc, const ivec& nc)
     }
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor
 InterpolFtoC::InterpolFtoC(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolFtoC 2-D");
     assert(dc.n_elem == 4);
     assert(nc.n_elem == 4);
 
@@ -82,11 +85,13 @@ InterpolFtoC::InterpolFtoC(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
     I(arma::span(I1.n_rows, I.n_rows - 1), arma::span(I1.n_cols, I.n_cols - 1)) = I2;
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor
 InterpolFtoC::InterpolFtoC(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolFtoC 3-D");
     assert(dc.n_elem == 6);
     assert(nc.n_elem == 6);
 
@@ -145,10 +150,11 @@ InterpolFtoC::InterpolFtoC(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ive
     I(arma::span(I1.n_rows + I2.n_rows, I.n_rows - 1), arma::span(I1.n_cols + I2.n_cols, I.n_cols - 1)) = I3;
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 1-D Nonperiodic Constructor
-InterpolFtoC::InterpolFtoC(u16 k, u32 m) : sp_mat(m + 2, m + 1)
+InterpolFtoC::InterpolFtoC(u16 k, u32 m) : mole::Operator(m + 2, m + 1)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
@@ -336,7 +342,7 @@ InterpolFtoC::InterpolFtoC(u16 k, u32 m) : sp_mat(m + 2, m + 1)
 }
 
 // 1-D Periodic Constructor
-InterpolFtoC::InterpolFtoC(u16 k, u32 m, bool dummy) : sp_mat(m, m)
+InterpolFtoC::InterpolFtoC(u16 k, u32 m, bool dummy) : mole::Operator(m, m)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
@@ -23,7 +23,7 @@
  * @brief Mimetic Interpolator operators from the Faces to Centers
  * 
  */
-class InterpolFtoC : public sp_mat {
+class InterpolFtoC : public mole::Operator {
 
 public:
     using sp_mat::operator=;
@@ -18,6 +18,7 @@
 // 1-D Constructor
 InterpolNtoC::InterpolNtoC(u16 k, u32 m, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolNtoC 1-D");
     assert(dc.n_elem == 2);
     assert(nc.n_elem == 2);
 
@@ -35,11 +36,13 @@ InterpolNtoC::InterpolNtoC(u16 k, u32 m, const ivec& dc, const ivec& nc)
     }
 
     *this = I;
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor
 InterpolNtoC::InterpolNtoC(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolNtoC 2-D");
     assert(dc.n_elem == 4);
     assert(nc.n_elem == 4);
 
@@ -67,11 +70,13 @@ InterpolNtoC::InterpolNtoC(u16 k, u32 m, u32 n, const ivec& dc, const ivec& nc)
 
     // Join
     *this = Utils::spkron(Iy, Ix);
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor
 InterpolNtoC::InterpolNtoC(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ivec& nc)
 {
+    MOLE_PROFILE_SCOPE("InterpolNtoC 3-D");
     assert(dc.n_elem == 6);
     assert(nc.n_elem == 6);
 
@@ -109,10 +114,11 @@ InterpolNtoC::InterpolNtoC(u16 k, u32 m, u32 n, u32 o, const ivec& dc, const ive
 
     // Join
     *this = Utils::spkron(Iz, Utils::spkron(Iy, Ix));
+    MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 1-D Nonperiodic Constructor
-InterpolNtoC::InterpolNtoC(u16 k, u32 m) : sp_mat(m + 2, m + 1)
+InterpolNtoC::InterpolNtoC(u16 k, u32 m) : mole::Operator(m + 2, m + 1)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
@@ -300,7 +306,7 @@ InterpolNtoC::InterpolNtoC(u16 k, u32 m) : sp_mat(m + 2, m + 1)
 }
 
 // 1-D Periodic Constructor
-InterpolNtoC::InterpolNtoC(u16 k, u32 m, bool dummy) : sp_mat(m, m)
+InterpolNtoC::InterpolNtoC(u16 k, u32 m, bool dummy) : mole::Operator(m, m)
 {
     assert(!(k % 2));
     assert(k > 1 && k < 9);
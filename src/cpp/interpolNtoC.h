@@ -23,7 +23,7 @@
  * @brief Mimetic Interpolator operators from the Nodes to Centers
  * 
  */
-class InterpolNtoC : public sp_mat
+class InterpolNtoC : public mole::Operator
 {
 public:
     using sp_mat::operator=;
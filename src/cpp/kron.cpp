@@ -0,0 +1,400 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file kron.cpp
+ *
+ * @brief Operators kept as sums of Kronecker products of 1-D factors
+ *
+ * @date 2026/10/19
+ */
+
+#include "kron.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "interpol.h"
+#include "laplacian.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace mole {
+
+constexpr uword KronOperator::minParallelPoints;
+
+namespace {
+
+// s x (s+2): the identity without its first and last rows
+sp_mat interiorRows(u32 s) {
+  sp_mat I = speye(s + 2, s + 2);
+  I.shed_row(0);
+  I.shed_row(s);
+  return I;
+}
+
+// (s+2) x s: the identity without its first and last columns
+sp_mat interiorCols(u32 s) {
+  sp_mat I = speye(s + 2, s + 2);
+  I.shed_col(0);
+  I.shed_col(s);
+  return I;
+}
+
+bool isIdentity(const sp_mat &A) {
+  if (A.n_rows != A.n_cols || A.n_nonzero != A.n_rows)
+    return false;
+  for (sp_mat::const_iterator it = A.begin(); it != A.end(); ++it)
+    if (it.row() != it.col() || *it != 1.0)
+      return false;
+  return true;
+}
+
+enum class Stack { Rows, Cols, Sum };
+
+// One block per axis: along[a] on axis a, other[b] on every other axis b.
+// The blocks are stacked by rows (gradient), by columns (divergence) or
+// summed (laplacian).
+KronOperator alongAxes(const std::vector<sp_mat> &along,
+                       const std::vector<sp_mat> &other, Stack how) {
+  MOLE_PROFILE_SCOPE("KronOperator");
+  const uword dims = along.size();
+  std::vector<uword> blockRows(dims, 1), blockCols(dims, 1);
+  for (uword a = 0; a < dims; ++a)
+    for (uword b = 0; b < dims; ++b) {
+      const sp_mat &F = a == b ? along[b] : other[b];
+      blockRows[a] *= F.n_rows;
+      blockCols[a] *= F.n_cols;
+    }
+
+  uword rows = blockRows[0], cols = blockCols[0];
+  for (uword a = 1; a < dims; ++a) {
+    if (how == Stack::Rows)
+      rows += blockRows[a];
+    if (how == Stack::Cols)
+      cols += blockCols[a];
+  }
+
+  KronOperator A(rows, cols);
+  uword rowOffset = 0, colOffset = 0;
+  for (uword a = 0; a < dims; ++a) {
+    std::vector<sp_mat> factors(other);
+    factors[a] = along[a];
+    A.add(rowOffset, colOffset, factors);
+    if (how == Stack::Rows)
+      rowOffset += blockRows[a];
+    if (how == Stack::Cols)
+      colOffset += blockCols[a];
+  }
+  return A;
+}
+
+// out(b, r, a) = scale * sum_q F(r, q) in(b, q, a), where b runs over the
+// axes before the factor's and a over the ones after it. With add the
+// result is accumulated into out.
+void modeProduct(const CSR &F, uword before, uword after, const Real *in,
+                 Real *out, Real scale, bool add) {
+  const uword *ptr = F.rowPointers().memptr();
+  const uword *col = F.columns().memptr();
+  const Real *val = F.values().memptr();
+  const uword p = F.rows(), q = F.cols();
+
+#pragma omp parallel for collapse(2) schedule(static)                         \
+    if (before * p * after >= KronOperator::minParallelPoints)
+  for (uword a = 0; a < after; ++a)
+    for (uword r = 0; r < p; ++r) {
+      const Real *x = in + a * q * before;
+      Real *y = out + (a * p + r) * before;
+      if (!add)
+        std::fill(y, y + before, 0.0);
+      for (uword t = ptr[r]; t < ptr[r + 1]; ++t) {
+        const Real c = scale * val[t];
+        const Real *xq = x + col[t] * before;
+#pragma omp simd
+        for (uword b = 0; b < before; ++b)
+          y[b] += c * xq[b];
+      }
+    }
+}
+
+} // namespace
+
+KronOperator::KronOperator(uword rows, uword cols)
+    : nRows(rows), nCols(cols) {}
+
+void KronOperator::add(uword rowOffset, uword colOffset,
+                       const std::vector<sp_mat> &factors, Real coef) {
+  if (factors.empty())
+    throw std::invalid_argument("MOLE: Kronecker block without factors");
+  uword rows = 1, cols = 1;
+  for (const sp_mat &F : factors) {
+    rows *= F.n_rows;
+    cols *= F.n_cols;
+  }
+  if (rowOffset + rows > nRows || colOffset + cols > nCols)
+    throw std::invalid_argument(
+        "MOLE: Kronecker block of " + std::to_string(rows) + " x " +
+        std::to_string(cols) + " at (" + std::to_string(rowOffset) + ", " +
+        std::to_string(colOffset) + ") does not fit in " +
+        std::to_string(nRows) + " x " + std::to_string(nCols));
+
+  Block block{rowOffset, colOffset, coef, {}, {}};
+  for (u16 axis = 0; axis < factors.size(); ++axis) {
+    block.factors.emplace_back(factors[axis]);
+    if (!isIdentity(factors[axis]))
+      block.order.push_back(axis);
+  }
+
+  // Mode products commute; shrinking factors go first to keep the
+  // intermediate tensors small
+  std::stable_sort(block.order.begin(), block.order.end(),
+                   [&block](u16 i, u16 j) {
+                     const CSR &a = block.factors[i], &b = block.factors[j];
+                     return a.rows() * b.cols() < b.rows() * a.cols();
+                   });
+
+  uword size = cols;
+  for (uword s = 0; s + 1 < block.order.size(); ++s) {
+    const CSR &F = block.factors[block.order[s]];
+    size = size / F.cols() * F.rows();
+    workSize = std::max(workSize, size);
+  }
+  blocks.push_back(std::move(block));
+}
+
+KronOperator KronOperator::gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  return alongAxes({Gradient(k, m, dx), Gradient(k, n, dy)},
+                   {interiorRows(m), interiorRows(n)}, Stack::Rows);
+}
+
+KronOperator KronOperator::gradient(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                    Real dy, Real dz) {
+  return alongAxes(
+      {Gradient(k, m, dx), Gradient(k, n, dy), Gradient(k, o, dz)},
+      {interiorRows(m), interiorRows(n), interiorRows(o)}, Stack::Rows);
+}
+
+KronOperator KronOperator::divergence(u16 k, u32 m, u32 n, Real dx,
+                                      Real dy) {
+  return alongAxes({Divergence(k, m, dx), Divergence(k, n, dy)},
+                   {interiorCols(m), interiorCols(n)}, Stack::Cols);
+}
+
+KronOperator KronOperator::divergence(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                      Real dy, Real dz) {
+  return alongAxes(
+      {Divergence(k, m, dx), Divergence(k, n, dy), Divergence(k, o, dz)},
+      {interiorCols(m), interiorCols(n), interiorCols(o)}, Stack::Cols);
+}
+
+KronOperator KronOperator::laplacian(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  return alongAxes({Laplacian(k, m, dx), Laplacian(k, n, dy)},
+                   {interiorCols(m) * interiorRows(m),
+                    interiorCols(n) * interiorRows(n)},
+                   Stack::Sum);
+}
+
+KronOperator KronOperator::laplacian(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                     Real dy, Real dz) {
+  return alongAxes({Laplacian(k, m, dx), Laplacian(k, n, dy),
+                    Laplacian(k, o, dz)},
+                   {interiorCols(m) * interiorRows(m),
+                    interiorCols(n) * interiorRows(n),
+                    interiorCols(o) * interiorRows(o)},
+                   Stack::Sum);
+}
+
+KronOperator KronOperator::interpol(u32 m, u32 n, Real c1, Real c2) {
+  return alongAxes({Interpol(m, c1), Interpol(n, c2)},
+                   {interiorRows(m), interiorRows(n)}, Stack::Rows);
+}
+
+KronOperator KronOperator::interpol(u32 m, u32 n, u32 o, Real c1, Real c2,
+                                    Real c3) {
+  return alongAxes({Interpol(m, c1), Interpol(n, c2), Interpol(o, c3)},
+                   {interiorRows(m), interiorRows(n), interiorRows(o)},
+                   Stack::Rows);
+}
+
+KronOperator KronOperator::interpol(bool type, u32 m, u32 n, Real c1,
+                                    Real c2) {
+  return alongAxes({Interpol(type, m, c1), Interpol(type, n, c2)},
+                   {interiorCols(m), interiorCols(n)}, Stack::Cols);
+}
+
+KronOperator KronOperator::interpol(bool type, u32 m, u32 n, u32 o, Real c1,
+                                    Real c2, Real c3) {
+  return alongAxes(
+      {Interpol(type, m, c1), Interpol(type, n, c2), Interpol(type, o, c3)},
+      {interiorCols(m), interiorCols(n), interiorCols(o)}, Stack::Cols);
+}
+
+uword KronOperator::bytes() const {
+  uword total = 0;
+  for (const Block &block : blocks)
+    for (const CSR &F : block.factors)
+      total += (F.rows() + 1 + F.nnz()) * sizeof(uword) +
+               F.nnz() * sizeof(Real);
+  return total;
+}
+
+void KronOperator::run(const Block &block, Real scale, const Real *in,
+                       Real *out) const {
+  std::vector<uword> shape;
+  uword size = 1;
+  for (const CSR &F : block.factors) {
+    shape.push_back(F.cols());
+    size *= F.cols();
+  }
+
+  // Only identity factors: the block is a scaled copy
+  if (block.order.empty()) {
+    for (uword i = 0; i < size; ++i)
+      out[i] += scale * in[i];
+    return;
+  }
+
+  const Real *src = in;
+  for (uword s = 0; s < block.order.size(); ++s) {
+    const u16 axis = block.order[s];
+    uword before = 1, after = 1;
+    for (uword i = 0; i < shape.size(); ++i) {
+      if (i < axis)
+        before *= shape[i];
+      if (i > axis)
+        after *= shape[i];
+    }
+    const bool last = s + 1 == block.order.size();
+    Real *dst = last ? out : work[s % 2].memptr();
+    modeProduct(block.factors[axis], before, after, src, dst,
+                last ? scale : 1.0, last);
+    shape[axis] = block.factors[axis].rows();
+    src = dst;
+  }
+}
+
+void KronOperator::apply_add(Real alpha, const vec &in, Real beta,
+                             vec &out) const {
+  MOLE_PROFILE_SCOPE("KronOperator::apply");
+  if (in.n_elem != nCols || out.n_elem != nRows)
+    throw std::invalid_argument(
+        "MOLE: operator is " + std::to_string(nRows) + " x " +
+        std::to_string(nCols) + ", got in of length " +
+        std::to_string(in.n_elem) + " and out of length " +
+        std::to_string(out.n_elem));
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply_add needs distinct in and out");
+
+  if (beta == 0.0)
+    out.zeros();
+  else if (beta != 1.0)
+    out *= beta;
+  if (alpha == 0.0)
+    return;
+
+  for (vec &w : work)
+    if (w.n_elem < workSize)
+      w.set_size(workSize);
+  for (const Block &block : blocks)
+    run(block, alpha * block.coef, in.memptr() + block.colOffset,
+        out.memptr() + block.rowOffset);
+}
+
+void KronOperator::apply(const vec &in, vec &out) const {
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  out.set_size(nRows);
+  apply_add(1.0, in, 0.0, out);
+}
+
+vec KronOperator::operator*(const vec &in) const {
+  vec out;
+  apply(in, out);
+  return out;
+}
+
+void KronOperator::apply_add(Real alpha, const mat &in, Real beta,
+                             mat &out) const {
+  MOLE_PROFILE_SCOPE("KronOperator::apply batch");
+  if (in.n_rows != nCols || out.n_rows != nRows || out.n_cols != in.n_cols)
+    throw std::invalid_argument(
+        "MOLE: operator is " + std::to_string(nRows) + " x " +
+        std::to_string(nCols) + ", got in of " + std::to_string(in.n_rows) +
+        " x " + std::to_string(in.n_cols) + " and out of " +
+        std::to_string(out.n_rows) + " x " + std::to_string(out.n_cols));
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply_add needs distinct in and out");
+
+  if (beta == 0.0)
+    out.zeros();
+  else if (beta != 1.0)
+    out *= beta;
+  if (alpha == 0.0)
+    return;
+
+  // The mode products are parallel already; columns go one after the other
+  // through the shared work buffers
+  for (vec &w : work)
+    if (w.n_elem < workSize)
+      w.set_size(workSize);
+  for (uword j = 0; j < in.n_cols; ++j)
+    for (const Block &block : blocks)
+      run(block, alpha * block.coef, in.colptr(j) + block.colOffset,
+          out.colptr(j) + block.rowOffset);
+}
+
+void KronOperator::apply(const mat &in, mat &out) const {
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  out.set_size(nRows, in.n_cols);
+  apply_add(1.0, in, 0.0, out);
+}
+
+sp_mat KronOperator::assemble() const {
+  MOLE_PROFILE_SCOPE("KronOperator::assemble");
+  std::vector<uword> rows, cols;
+  std::vector<Real> values;
+  for (const Block &block : blocks) {
+    // Kronecker indices are built from the slowest axis to the fastest:
+    // row = (rz * py + ry) * px + rx
+    std::vector<uword> r{0}, c{0};
+    std::vector<Real> v{block.coef};
+    for (uword axis = block.factors.size(); axis-- > 0;) {
+      const CSR &F = block.factors[axis];
+      const uword *ptr = F.rowPointers().memptr();
+      const uword *col = F.columns().memptr();
+      const Real *val = F.values().memptr();
+      std::vector<uword> nr, nc;
+      std::vector<Real> nv;
+      nr.reserve(r.size() * F.nnz());
+      nc.reserve(r.size() * F.nnz());
+      nv.reserve(r.size() * F.nnz());
+      for (uword e = 0; e < r.size(); ++e)
+        for (uword i = 0; i < F.rows(); ++i)
+          for (uword t = ptr[i]; t < ptr[i + 1]; ++t) {
+            nr.push_back(r[e] * F.rows() + i);
+            nc.push_back(c[e] * F.cols() + col[t]);
+            nv.push_back(v[e] * val[t]);
+          }
+      r.swap(nr);
+      c.swap(nc);
+      v.swap(nv);
+    }
+    for (uword e = 0; e < r.size(); ++e) {
+      rows.push_back(block.rowOffset + r[e]);
+      cols.push_back(block.colOffset + c[e]);
+      values.push_back(v[e]);
+    }
+  }
+
+  umat locations(2, values.size());
+  for (uword e = 0; e < values.size(); ++e) {
+    locations(0, e) = rows[e];
+    locations(1, e) = cols[e];
+  }
+  return sp_mat(true, locations, vec(values), nRows, nCols);
+}
+
+} // namespace mole
@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file kron.h
+ *
+ * @brief Operators kept as sums of Kronecker products of 1-D factors
+ *
+ * The 2-D and 3-D operators are blocks of the form Fz ⊗ Fy ⊗ Fx, where one
+ * factor is a 1-D operator and the others select interior points. A
+ * KronOperator stores only these factors, O(m + n + o) memory, and applies
+ * each block as a sequence of mode products: the input is viewed as an
+ * x-fastest tensor and every factor is applied along its own axis, like
+ * ttm() in the MATLAB version.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef KRON_H
+#define KRON_H
+
+#include "csr.h"
+#include "utils.h"
+#include <vector>
+
+namespace mole {
+
+/**
+ * @brief Matrix-free sum of Kronecker-product blocks
+ *
+ * @code
+ *   const auto L = mole::KronOperator::laplacian(4, m, n, o, dx, dy, dz);
+ *   for (...) {
+ *     L.apply(u, Lu);
+ *     u += dt * Lu;
+ *   }
+ * @endcode
+ *
+ * Non-periodic operators only. apply() reuses two work buffers, so one
+ * KronOperator should not be applied from two threads at once.
+ */
+class KronOperator {
+public:
+  /**
+   * @brief Empty rows x cols operator, filled with add()
+   */
+  KronOperator(uword rows, uword cols);
+
+  /**
+   * @brief Adds coef * (F[d-1] ⊗ ... ⊗ F[0]) at a block offset
+   *
+   * @param factors One factor per axis, x first
+   * @throws std::invalid_argument if there are no factors or the block does
+   *         not fit inside the operator
+   */
+  void add(uword rowOffset, uword colOffset, const std::vector<sp_mat> &factors,
+           Real coef = 1.0);
+
+  /**
+   * @brief Factored Gradient(k, m, n[, o], dx, dy[, dz])
+   */
+  static KronOperator gradient(u16 k, u32 m, u32 n, Real dx, Real dy);
+  static KronOperator gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy,
+                               Real dz);
+
+  /**
+   * @brief Factored Divergence(k, m, n[, o], dx, dy[, dz])
+   */
+  static KronOperator divergence(u16 k, u32 m, u32 n, Real dx, Real dy);
+  static KronOperator divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy,
+                                 Real dz);
+
+  /**
+   * @brief Factored Laplacian(k, m, n[, o], dx, dy[, dz])
+   *
+   * D * G has one block per axis, D_x G_x along x and the products of the
+   * selectors, diag(0, 1, ..., 1, 0), along the other axes.
+   */
+  static KronOperator laplacian(u16 k, u32 m, u32 n, Real dx, Real dy);
+  static KronOperator laplacian(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy,
+                                Real dz);
+
+  /**
+   * @brief Factored Interpol(m, n[, o], c1, c2[, c3]), centers to faces
+   */
+  static KronOperator interpol(u32 m, u32 n, Real c1, Real c2);
+  static KronOperator interpol(u32 m, u32 n, u32 o, Real c1, Real c2,
+                               Real c3);
+
+  /**
+   * @brief Factored Interpol(type, m, n[, o], c1, c2[, c3]), faces to centers
+   */
+  static KronOperator interpol(bool type, u32 m, u32 n, Real c1, Real c2);
+  static KronOperator interpol(bool type, u32 m, u32 n, u32 o, Real c1,
+                               Real c2, Real c3);
+
+  uword rows() const { return nRows; }
+  uword cols() const { return nCols; }
+
+  /**
+   * @brief Number of Kronecker blocks
+   */
+  uword terms() const { return blocks.size(); }
+
+  /**
+   * @brief Bytes held by the factors
+   */
+  uword bytes() const;
+
+  /**
+   * @brief out = A * in
+   *
+   * @throws std::invalid_argument if in has not cols() entries or aliases
+   *         out
+   */
+  void apply(const vec &in, vec &out) const;
+
+  /**
+   * @brief out = alpha * A * in + beta * out; beta = 0 overwrites out
+   */
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const;
+
+  vec operator*(const vec &in) const;
+
+  /**
+   * @brief Batched forms; every column of in is one vector
+   */
+  void apply(const mat &in, mat &out) const;
+  void apply_add(Real alpha, const mat &in, Real beta, mat &out) const;
+
+  /**
+   * @brief The global sparse matrix, for checks and direct solvers
+   */
+  sp_mat assemble() const;
+
+  /**
+   * @brief Points below which a mode product runs on one thread
+   */
+  static constexpr uword minParallelPoints = 16384;
+
+private:
+  struct Block {
+    uword rowOffset, colOffset;
+    Real coef;
+    std::vector<CSR> factors;
+    std::vector<u16> order; // axes in the order they are applied
+  };
+
+  void run(const Block &block, Real scale, const Real *in, Real *out) const;
+
+  uword nRows, nCols;
+  std::vector<Block> blocks;
+  uword workSize = 0;
+  mutable vec work[2];
+};
+
+} // namespace mole
+
+#endif // KRON_H
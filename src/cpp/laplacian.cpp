@@ -16,36 +16,46 @@
 
 
 #include "laplacian.h"
+#include "footprint.h"
 
 // 1-D Constructor
 Laplacian::Laplacian(u16 k, u32 m, Real dx) {
+  MOLE_PROFILE_SCOPE("Laplacian 1-D");
   mole::check_spacing(dx, "dx");
   Divergence div(k, m, dx);
   Gradient grad(k, m, dx);
+  mole::memory::Temporary held_div(div), held_grad(grad);
 
   // Dimensions = m+2, m+2
-  *this = (sp_mat)div * (sp_mat)grad;
+  *this = static_cast<const sp_mat &>(div) * static_cast<const sp_mat &>(grad);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 2-D Constructor
 Laplacian::Laplacian(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  MOLE_PROFILE_SCOPE("Laplacian 2-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   Divergence div(k, m, n, dx, dy);
   Gradient grad(k, m, n, dx, dy);
+  mole::memory::Temporary held_div(div), held_grad(grad);
 
   // Dimensions = (m+2)*(n+2), (m+2)*(n+2)
-  *this = (sp_mat)div * (sp_mat)grad;
+  *this = static_cast<const sp_mat &>(div) * static_cast<const sp_mat &>(grad);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
 
 // 3-D Constructor
 Laplacian::Laplacian(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  MOLE_PROFILE_SCOPE("Laplacian 3-D");
   mole::check_spacing(dx, "dx");
   mole::check_spacing(dy, "dy");
   mole::check_spacing(dz, "dz");
   Divergence div(k, m, n, o, dx, dy, dz);
   Gradient grad(k, m, n, o, dx, dy, dz);
+  mole::memory::Temporary held_div(div), held_grad(grad);
 
   // Dimensions = (m+2)*(n+2)*(o+2), (m+2)*(n+2)*(o+2)
-  *this = (sp_mat)div * (sp_mat)grad;
+  *this = static_cast<const sp_mat &>(div) * static_cast<const sp_mat &>(grad);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
 }
@@ -22,7 +22,7 @@
  * @brief Mimetic Laplacian operator
  *
  */
-class Laplacian : public sp_mat {
+class Laplacian : public mole::Operator {
 
 public:
   using sp_mat::operator=;
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file meshgrid.cpp
+ *
+ * @brief Tensor-product grids kept as their 1-D ticks
+ *
+ * @date 2026/10/19
+ */
+
+#include "meshgrid.h"
+
+namespace mole {
+
+constexpr uword MeshGrid::minParallelPoints;
+
+void MeshView::copyTo(mat &out) const {
+  out.set_size(n_rows, n_cols);
+#pragma omp parallel for if (out.n_elem >= MeshGrid::minParallelPoints)
+  for (uword j = 0; j < n_cols; ++j)
+    for (uword i = 0; i < n_rows; ++i)
+      out(i, j) = (*this)(i, j);
+}
+
+void MeshView::copyTo(cube &out) const {
+  out.set_size(n_rows, n_cols, n_slices);
+#pragma omp parallel for collapse(2) if (out.n_elem >=                       \
+                                             MeshGrid::minParallelPoints)
+  for (uword k = 0; k < n_slices; ++k)
+    for (uword j = 0; j < n_cols; ++j)
+      for (uword i = 0; i < n_rows; ++i)
+        out(i, j, k) = (*this)(i, j, k);
+}
+
+mat MeshView::asMat() const {
+  mat out;
+  copyTo(out);
+  return out;
+}
+
+cube MeshView::asCube() const {
+  cube out;
+  copyTo(out);
+  return out;
+}
+
+MeshGrid::MeshGrid(const vec &x, const vec &y)
+    : nDims(2), ticks{{x, y, vec(1, fill::zeros)}} {
+  if (x.is_empty() || y.is_empty())
+    throw std::invalid_argument("MOLE: a grid needs ticks on every axis");
+}
+
+MeshGrid::MeshGrid(const vec &x, const vec &y, const vec &z)
+    : nDims(3), ticks{{x, y, z}} {
+  if (x.is_empty() || y.is_empty() || z.is_empty())
+    throw std::invalid_argument("MOLE: a grid needs ticks on every axis");
+}
+
+// 2-D views follow the meshgrid layout, rows along y
+MeshView MeshGrid::X() const {
+  const uword nx = ticks[0].n_elem, ny = ticks[1].n_elem;
+  if (nDims == 2)
+    return MeshView(ticks[0], 1, ny, nx, 1);
+  return MeshView(ticks[0], 0, nx, ny, ticks[2].n_elem);
+}
+
+MeshView MeshGrid::Y() const {
+  const uword nx = ticks[0].n_elem, ny = ticks[1].n_elem;
+  if (nDims == 2)
+    return MeshView(ticks[1], 0, ny, nx, 1);
+  return MeshView(ticks[1], 1, nx, ny, ticks[2].n_elem);
+}
+
+MeshView MeshGrid::Z() const {
+  if (nDims == 2)
+    throw std::invalid_argument("MOLE: a 2-D grid has no Z coordinate");
+  return MeshView(ticks[2], 2, ticks[0].n_elem, ticks[1].n_elem,
+                  ticks[2].n_elem);
+}
+
+} // namespace mole
@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file meshgrid.h
+ *
+ * @brief Tensor-product grids kept as their 1-D ticks
+ *
+ * Utils::meshgrid stores a full copy of every coordinate: three m x n x o
+ * cubes in 3-D, often only to evaluate an initial condition once. A
+ * MeshGrid keeps the ticks and computes coordinates on access; evaluate()
+ * fills a field from a point function, in parallel, without any
+ * coordinate arrays.
+ *
+ * @code
+ *   const mole::MeshGrid grid(xc, yc, zc);
+ *   const vec u0 = mole::evaluate(grid, [](Real x, Real y, Real z) {
+ *     return std::sin(x) * std::cos(y) * z;
+ *   });
+ * @endcode
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef MESHGRID_H
+#define MESHGRID_H
+
+#include "utils.h"
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace mole {
+
+/**
+ * @brief One coordinate of a MeshGrid, computed on access
+ *
+ * Indexed like the arrays of Utils::meshgrid: X(row, col) with rows along
+ * y in 2-D, X(i, j, k) with i along x in 3-D. It refers to the grid's
+ * ticks, so it must not outlive the grid.
+ */
+class MeshView {
+public:
+  MeshView(const vec &ticks, uword slot, uword rows, uword cols,
+           uword slices)
+      : n_rows(rows), n_cols(cols), n_slices(slices), ticks(ticks),
+        slot(slot) {}
+
+  Real operator()(uword i, uword j, uword k = 0) const {
+    return ticks(slot == 0 ? i : (slot == 1 ? j : k));
+  }
+
+  /**
+   * @brief The dense array Utils::meshgrid would have produced; copyTo
+   *        resizes out and fills it in place
+   */
+  mat asMat() const;
+  cube asCube() const;
+  void copyTo(mat &out) const;
+  void copyTo(cube &out) const;
+
+  const uword n_rows, n_cols, n_slices;
+
+private:
+  const vec &ticks;
+  uword slot; // which index selects the tick
+};
+
+/**
+ * @brief 2-D or 3-D tensor-product grid from its ticks
+ *
+ * Points are numbered x fastest, then y, then z, as the unknowns of the
+ * MOLE operators.
+ */
+class MeshGrid {
+public:
+  MeshGrid(const vec &x, const vec &y);
+  MeshGrid(const vec &x, const vec &y, const vec &z);
+
+  uword dims() const { return nDims; }
+  uword size() const {
+    return ticks[0].n_elem * ticks[1].n_elem * ticks[2].n_elem;
+  }
+  const vec &ticksOf(uword axis) const { return ticks[axis]; }
+
+  /**
+   * @brief Coordinate views in the Utils::meshgrid layout
+   *
+   * @throws std::invalid_argument for Z() of a 2-D grid
+   */
+  MeshView X() const;
+  MeshView Y() const;
+  MeshView Z() const;
+
+  /**
+   * @brief Points below which evaluate() stays on one thread
+   */
+  static constexpr uword minParallelPoints = 16384;
+
+private:
+  uword nDims;
+  std::array<vec, 3> ticks; // z is {0} in 2-D
+};
+
+/**
+ * @brief out(p) = f(x, y) or f(x, y, z) at every point, x fastest
+ *
+ * The overload is picked by the number of coordinates f takes. The points
+ * are split over the OpenMP threads, so f is called concurrently and must
+ * not write shared state.
+ *
+ * @throws std::invalid_argument if f does not take grid.dims() coordinates
+ */
+template <typename F>
+auto evaluate(const MeshGrid &grid, F &&f, vec &out)
+    -> decltype(f(Real(), Real()), void()) {
+  if (grid.dims() != 2)
+    throw std::invalid_argument("MOLE: f(x, y) needs a 2-D grid");
+  const Real *x = grid.ticksOf(0).memptr(), *y = grid.ticksOf(1).memptr();
+  const uword nx = grid.ticksOf(0).n_elem, ny = grid.ticksOf(1).n_elem;
+  out.set_size(nx * ny);
+  Real *field = out.memptr();
+#pragma omp parallel for if (nx * ny >= MeshGrid::minParallelPoints)
+  for (uword j = 0; j < ny; ++j)
+    for (uword i = 0; i < nx; ++i)
+      field[i + nx * j] = f(x[i], y[j]);
+}
+
+template <typename F>
+auto evaluate(const MeshGrid &grid, F &&f, vec &out)
+    -> decltype(f(Real(), Real(), Real()), void()) {
+  if (grid.dims() != 3)
+    throw std::invalid_argument("MOLE: f(x, y, z) needs a 3-D grid");
+  const Real *x = grid.ticksOf(0).memptr(), *y = grid.ticksOf(1).memptr(),
+             *z = grid.ticksOf(2).memptr();
+  const uword nx = grid.ticksOf(0).n_elem, ny = grid.ticksOf(1).n_elem,
+              nz = grid.ticksOf(2).n_elem;
+  out.set_size(nx * ny * nz);
+  Real *field = out.memptr();
+#pragma omp parallel for collapse(2) if (nx * ny * nz >=                     \
+                                             MeshGrid::minParallelPoints)
+  for (uword k = 0; k < nz; ++k)
+    for (uword j = 0; j < ny; ++j)
+      for (uword i = 0; i < nx; ++i)
+        field[i + nx * (j + ny * k)] = f(x[i], y[j], z[k]);
+}
+
+template <typename F> vec evaluate(const MeshGrid &grid, F &&f) {
+  vec out;
+  evaluate(grid, std::forward<F>(f), out);
+  return out;
+}
+
+} // namespace mole
+
+#endif // MESHGRID_H
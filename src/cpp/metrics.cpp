@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file metrics.cpp
+ *
+ * @brief Jacobian and metric coefficients of curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "metrics.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "interpolCtoF.h"
+#include "interpolFtoC.h"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+CurvilinearMetrics::CurvilinearMetrics(u16 k, const mat &X, const mat &Y,
+                                       const ivec &dc, const ivec &nc)
+    : k(k) {
+  MOLE_PROFILE_SCOPE("CurvilinearMetrics 2-D");
+  assert(dc.n_elem == 4 && nc.n_elem == 4);
+  if (X.n_rows != Y.n_rows || X.n_cols != Y.n_cols)
+    throw std::invalid_argument("MOLE: X and Y must be the same size");
+
+  buildAxes({X.n_cols, X.n_rows}, dc, nc);
+  // meshgrid layout has rows along y; centers are numbered x fastest
+  computeMetrics({vectorise(X.t()), vectorise(Y.t())});
+}
+
+CurvilinearMetrics::CurvilinearMetrics(u16 k, const cube &X, const cube &Y,
+                                       const cube &Z, const ivec &dc,
+                                       const ivec &nc)
+    : k(k) {
+  MOLE_PROFILE_SCOPE("CurvilinearMetrics 3-D");
+  assert(dc.n_elem == 6 && nc.n_elem == 6);
+  if (X.n_rows != Y.n_rows || X.n_cols != Y.n_cols ||
+      X.n_slices != Y.n_slices || X.n_rows != Z.n_rows ||
+      X.n_cols != Z.n_cols || X.n_slices != Z.n_slices)
+    throw std::invalid_argument("MOLE: X, Y, and Z must be the same size");
+
+  buildAxes({X.n_rows, X.n_cols, X.n_slices}, dc, nc);
+  computeMetrics({vectorise(X), vectorise(Y), vectorise(Z)});
+}
+
+void CurvilinearMetrics::buildAxes(const uvec &extent, const ivec &dc,
+                                   const ivec &nc) {
+  const u16 d = static_cast<u16>(extent.n_elem);
+  axes.resize(d);
+  centerGradient.resize(d);
+
+  for (u16 a = 0; a < d; ++a) {
+    const ivec dca = dc.subvec(2 * a, 2 * a + 1);
+    const ivec nca = nc.subvec(2 * a, 2 * a + 1);
+    Axis &ax = axes[a];
+    ax.periodic = !any(dca) && !any(nca);
+    ax.points = static_cast<u32>(extent(a));
+    if (!ax.periodic && ax.points < 3)
+      throw std::invalid_argument("MOLE: curvilinear grid needs at least one "
+                                  "cell along axis " + std::to_string(a));
+    ax.cells = ax.periodic ? ax.points : ax.points - 2;
+
+    // Logical coordinates span [0, 1]
+    const Real h = 1.0 / ax.cells;
+    ax.G = Gradient(k, ax.cells, h, dca, nca);
+    ax.D = Divergence(k, ax.cells, h, dca, nca);
+    ax.ICF = InterpolCtoF(k, ax.cells, dca, nca);
+    ax.IFC = InterpolFtoC(k, ax.cells, dca, nca);
+  }
+
+  // Logical derivatives acting on and returning to the centers
+  for (u16 a = 0; a < d; ++a)
+    centerGradient[a] = expand(a, axes[a].IFC * axes[a].G);
+}
+
+sp_mat CurvilinearMetrics::expand(u16 axis, const sp_mat &A) const {
+  sp_mat result;
+  // The last axis varies slowest, so it is the outermost Kronecker factor
+  for (int b = static_cast<int>(axes.size()) - 1; b >= 0; --b) {
+    const sp_mat factor =
+        (b == axis) ? A : sp_mat(speye(axes[b].points, axes[b].points));
+    result = (b == static_cast<int>(axes.size()) - 1)
+                 ? factor
+                 : Utils::spkron(result, factor);
+  }
+  return result;
+}
+
+void CurvilinearMetrics::computeMetrics(const std::vector<vec> &coordinates) {
+  const u16 d = dimensions();
+  const uword N = coordinates[0].n_elem;
+
+  forward.set_size(N, d * d);
+  for (u16 i = 0; i < d; ++i)
+    for (u16 a = 0; a < d; ++a)
+      forward.col(i * d + a) = centerGradient[a] * coordinates[i];
+
+  J.set_size(N);
+  inverse.set_size(N, d * d);
+  const mat &F = forward;
+  bool degenerate = false;
+
+#pragma omp parallel for schedule(static) reduction(|| : degenerate)
+  for (uword c = 0; c < N; ++c) {
+    if (d == 2) {
+      const Real xe = F(c, 0), xn = F(c, 1), ye = F(c, 2), yn = F(c, 3);
+      const Real j = xe * yn - xn * ye;
+      degenerate = degenerate || j == 0.0;
+      J(c) = j;
+      inverse(c, 0) = yn / j;
+      inverse(c, 1) = -ye / j;
+      inverse(c, 2) = -xn / j;
+      inverse(c, 3) = xe / j;
+    } else {
+      const Real xe = F(c, 0), xn = F(c, 1), xk = F(c, 2);
+      const Real ye = F(c, 3), yn = F(c, 4), yk = F(c, 5);
+      const Real ze = F(c, 6), zn = F(c, 7), zk = F(c, 8);
+      const Real j = xe * (yn * zk - yk * zn) - xn * (ye * zk - yk * ze) +
+                     xk * (ye * zn - yn * ze);
+      degenerate = degenerate || j == 0.0;
+      J(c) = j;
+      inverse(c, 0) = (yn * zk - zn * yk) / j;
+      inverse(c, 1) = (ze * yk - ye * zk) / j;
+      inverse(c, 2) = (ye * zn - ze * yn) / j;
+      inverse(c, 3) = (zn * xk - xn * zk) / j;
+      inverse(c, 4) = (xe * zk - ze * xk) / j;
+      inverse(c, 5) = (ze * xn - xe * zn) / j;
+      inverse(c, 6) = (xn * yk - yn * xk) / j;
+      inverse(c, 7) = (ye * xk - xe * yk) / j;
+      inverse(c, 8) = (xe * yn - ye * xn) / j;
+    }
+  }
+
+  if (degenerate)
+    throw std::runtime_error("MOLE: curvilinear grid has a degenerate cell "
+                             "(zero Jacobian)");
+}
+
+sp_mat CurvilinearMetrics::transform(u16 i,
+                                     const std::vector<const sp_mat *> &logical,
+                                     const vec &mask) const {
+  const u16 d = dimensions();
+  assert(logical.size() == d);
+  const uword rows = logical[0]->n_rows, cols = logical[0]->n_cols;
+  assert(rows == size());
+  const bool masked = mask.n_elem > 0;
+
+  // First pass: entries kept per (term, column), so that every column can
+  // be filled independently in the second pass.
+  std::vector<uword> start(d * cols + 1, 0);
+  for (u16 a = 0; a < d; ++a) {
+    const sp_mat &T = *logical[a];
+    assert(T.n_rows == rows && T.n_cols == cols);
+    T.sync();
+    const Real *scale = inverse.colptr(i * d + a);
+#pragma omp parallel for schedule(static)
+    for (uword c = 0; c < cols; ++c) {
+      uword kept = 0;
+      for (uword p = T.col_ptrs[c]; p < T.col_ptrs[c + 1]; ++p) {
+        const uword r = T.row_indices[p];
+        kept += (!masked || mask(r) != 0.0) && scale[r] * T.values[p] != 0.0;
+      }
+      start[a * cols + c + 1] = kept;
+    }
+  }
+  for (uword s = 1; s < start.size(); ++s)
+    start[s] += start[s - 1];
+
+  umat locations(2, start.back());
+  vec values(start.back());
+  for (u16 a = 0; a < d; ++a) {
+    const sp_mat &T = *logical[a];
+    const Real *scale = inverse.colptr(i * d + a);
+#pragma omp parallel for schedule(static)
+    for (uword c = 0; c < cols; ++c) {
+      uword out = start[a * cols + c];
+      for (uword p = T.col_ptrs[c]; p < T.col_ptrs[c + 1]; ++p) {
+        const uword r = T.row_indices[p];
+        const Real v = scale[r] * T.values[p];
+        if ((!masked || mask(r) != 0.0) && v != 0.0) {
+          locations(0, out) = r;
+          locations(1, out) = c;
+          values(out) = v;
+          ++out;
+        }
+      }
+    }
+  }
+
+  // Entries of different terms at the same position are summed
+  MOLE_PROFILE_COUNT("nnz", values.n_elem);
+  return sp_mat(true, locations, values, rows, cols);
+}
@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file metrics.h
+ *
+ * @brief Jacobian and metric coefficients of curvilinear grids
+ *
+ * The C++ counterpart of jacobian2D.m / jacobian3D.m (dc/nc form). Metrics
+ * are computed once per grid and shared by GradientCurv and DivergenceCurv.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Metric terms of a logically rectangular curvilinear grid
+ *
+ * The grid is given by the physical coordinates of its cell centers,
+ * including the boundary centers of non-periodic axes (m+2 points along a
+ * non-periodic axis with m cells, m points along a periodic one). The
+ * logical coordinates are the unit square/cube.
+ *
+ * All per-center quantities are stored structure-of-arrays: one contiguous
+ * column per term, indexed by center with x fastest, then y, then z.
+ */
+class CurvilinearMetrics {
+public:
+  /**
+   * @brief 2-D metrics
+   *
+   * @param k  Order of accuracy
+   * @param X  x-coordinates of the centers, as returned by Utils::meshgrid
+   *           (rows follow y, columns follow x)
+   * @param Y  y-coordinates of the centers, same layout as X
+   * @param dc Dirichlet coefficients for the left, right, bottom, and top
+   *           boundaries
+   * @param nc Neumann coefficients for the left, right, bottom, and top
+   *           boundaries
+   *
+   * @note An axis is periodic when all of its dc and nc entries are zero.
+   */
+  CurvilinearMetrics(u16 k, const mat &X, const mat &Y, const ivec &dc,
+                     const ivec &nc);
+
+  /**
+   * @brief 3-D metrics
+   *
+   * @param X, Y, Z Coordinates of the centers, as returned by the 3-D
+   *                Utils::meshgrid (X(i, j, l) is the point (x_i, y_j, z_l))
+   * @param dc, nc  Coefficients for the left, right, bottom, top, front, and
+   *                back boundaries
+   */
+  CurvilinearMetrics(u16 k, const cube &X, const cube &Y, const cube &Z,
+                     const ivec &dc, const ivec &nc);
+
+  /**
+   * @brief Order of accuracy
+   */
+  u16 order() const { return k; }
+
+  /**
+   * @brief Number of dimensions (2 or 3)
+   */
+  u16 dimensions() const { return static_cast<u16>(axes.size()); }
+
+  /**
+   * @brief Number of cells along an axis
+   */
+  u32 cells(u16 axis) const { return axes[axis].cells; }
+
+  /**
+   * @brief Number of centers along an axis (cells + 2 unless periodic)
+   */
+  u32 points(u16 axis) const { return axes[axis].points; }
+
+  /**
+   * @brief Whether an axis is periodic
+   */
+  bool periodic(u16 axis) const { return axes[axis].periodic; }
+
+  /**
+   * @brief Total number of centers
+   */
+  uword size() const { return J.n_elem; }
+
+  /**
+   * @brief Jacobian determinant at every center
+   */
+  const vec &jacobian() const { return J; }
+
+  /**
+   * @brief Covariant metrics, column i*d + a holds dx_i/dxi_a
+   */
+  const mat &covariant() const { return forward; }
+
+  /**
+   * @brief Contravariant metrics, column i*d + a holds dxi_a/dx_i
+   *
+   * These are the row scalings that turn logical derivatives into
+   * physical ones: d/dx_i = sum_a (dxi_a/dx_i) d/dxi_a.
+   */
+  const mat &contravariant() const { return inverse; }
+
+  /**
+   * @brief Logical center-to-center derivative d/dxi_a
+   *
+   * kron(..., IFC_a * G_a, ...), the operator the metrics are computed with.
+   */
+  const sp_mat &logicalGradient(u16 axis) const { return centerGradient[axis]; }
+
+  /**
+   * @brief Places a 1-D operator on an axis: kron(I, ..., A, ..., I)
+   */
+  sp_mat expand(u16 axis, const sp_mat &A) const;
+
+  /**
+   * @brief Physical component i of a logical operator
+   *
+   * Returns sum_a diag(dxi_a/dx_i) * (*logical[a]), assembled in parallel
+   * directly from the compressed columns of the logical operators. Rows
+   * whose mask entry is zero are left empty.
+   */
+  sp_mat transform(u16 i, const std::vector<const sp_mat *> &logical,
+                   const vec &mask = vec()) const;
+
+  /**
+   * @brief 1-D building blocks of one logical axis
+   */
+  struct Axis {
+    u32 cells;
+    u32 points;
+    bool periodic;
+    sp_mat G;   // gradient, centers to faces
+    sp_mat D;   // divergence, faces to centers
+    sp_mat ICF; // interpolator, centers to faces
+    sp_mat IFC; // interpolator, faces to centers
+  };
+
+  /**
+   * @brief 1-D building blocks along an axis
+   */
+  const Axis &axis(u16 a) const { return axes[a]; }
+
+private:
+  u16 k;
+  std::vector<Axis> axes;
+  std::vector<sp_mat> centerGradient;
+  vec J;
+  mat forward;
+  mat inverse;
+
+  void buildAxes(const uvec &extent, const ivec &dc, const ivec &nc);
+  void computeMetrics(const std::vector<vec> &coordinates);
+};
+
+#endif // METRICS_H
@@ -18,17 +18,42 @@
 #ifndef MIXEDBC_H
 #define MIXEDBC_H
 
-#include "gradient.h"
+#include "boundary.h"
 
 /**
  * @brief Mimetic Mixed Boundary Condition operator
  *
  */
-class MixedBC : public sp_mat {
+class MixedBC : public mole::Operator {
 
 public:
   using sp_mat::operator=;
 
+  /**
+   * @brief 1-D Constructor from typed face conditions
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   * @param faces Left and right conditions, e.g.
+   * {{mole::dirichlet(1.0), mole::robin(1.0, 2.0)}}
+   */
+  MixedBC(u16 k, u32 m, Real dx, const std::array<mole::FaceBC, 2> &faces);
+
+  /**
+   * @brief 2-D Constructor from typed face conditions (left, right, bottom,
+   * top)
+   */
+  MixedBC(u16 k, u32 m, Real dx, u32 n, Real dy,
+          const std::array<mole::FaceBC, 4> &faces);
+
+  /**
+   * @brief 3-D Constructor from typed face conditions (left, right, bottom,
+   * top, front, back)
+   */
+  MixedBC(u16 k, u32 m, Real dx, u32 n, Real dy, u32 o, Real dz,
+          const std::array<mole::FaceBC, 6> &faces);
+
   /**
    * @brief 1-D Constructor
    *
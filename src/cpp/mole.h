@@ -17,17 +17,42 @@
 #define MOLE_H
 
 #include "addscalarbc.h"
+#include "boundary.h"
+#include "csr.h"
+#include "curl.h"
+#include "distributed.h"
 #include "divergence.h"
+#include "divergenceCurv.h"
+#include "divergenceNonUniform.h"
+#include "eigs.h"
+#include "expression.h"
+#include "footprint.h"
 #include "gradient.h"
+#include "gradientCurv.h"
+#include "gradientNonUniform.h"
+#include "gridgen.h"
 #include "interpol.h"
 #include "interpolCtoF.h"
 #include "interpolCtoN.h"
 #include "interpolFtoC.h"
 #include "interpolNtoC.h"
+#include "kron.h"
 #include "laplacian.h"
+#include "meshgrid.h"
+#include "metrics.h"
 #include "mixedbc.h"
+#include "nodal.h"
+#include "nonuniform.h"
 #include "operators.h"
+#include "profiler.h"
+#include "projection.h"
+#include "quadrature.h"
 #include "robinbc.h"
+#include "sidedNodal.h"
+#include "snapshot.h"
+#include "solver.h"
 #include "utils.h"
+#include "vtkwriter.h"
+#include "weights.h"
 
 #endif // MOLE_H
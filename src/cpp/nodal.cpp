@@ -0,0 +1,316 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file nodal.cpp
+ *
+ * @brief First derivatives on uniform nodal grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "nodal.h"
+#include "interpolCtoN.h"
+#include "interpolNtoC.h"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Weights of the first derivative at 0 from the points s, i.e. the
+// derivatives of the Lagrange basis (the Vandermonde solve of nodal.m)
+std::vector<Real> derivativeWeights(const std::vector<Real> &s) {
+  const size_t q = s.size();
+  std::vector<Real> w(q, 0.0);
+  for (size_t j = 0; j < q; ++j) {
+    for (size_t l = 0; l < q; ++l) {
+      if (l == j)
+        continue;
+      Real term = 1.0 / (s[j] - s[l]);
+      for (size_t r = 0; r < q; ++r)
+        if (r != j && r != l)
+          term *= -s[r] / (s[j] - s[r]);
+      w[j] += term;
+    }
+  }
+  return w;
+}
+
+bool isPeriodic(const ivec &dc, const ivec &nc, u16 axis) {
+  return dc(2 * axis) == 0 && dc(2 * axis + 1) == 0 && nc(2 * axis) == 0 &&
+         nc(2 * axis + 1) == 0;
+}
+
+} // anonymous namespace
+
+NodalKernel::NodalKernel(u16 k, u32 m, Real dx) {
+  init(k, {m}, {dx}, {false});
+}
+
+NodalKernel::NodalKernel(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  init(k, {m, n}, {dx, dy}, {false, false});
+}
+
+NodalKernel::NodalKernel(u16 k, u32 m, u32 n, u32 o, Real dx,
+                         Real dy, Real dz) {
+  init(k, {m, n, o}, {dx, dy, dz}, {false, false, false});
+}
+
+NodalKernel NodalKernel::onCells(u16 k, u32 m, Real dx, const ivec &dc,
+                                 const ivec &nc) {
+  assert(dc.n_elem == 2 && nc.n_elem == 2);
+  NodalKernel kernel;
+  const bool px = isPeriodic(dc, nc, 0);
+  kernel.init(k, {px ? m : m + 1}, {dx}, {px});
+  kernel.toNodes = InterpolCtoN(k, m, dc, nc);
+  kernel.toCenters = InterpolNtoC(k, m, dc, nc);
+  return kernel;
+}
+
+NodalKernel NodalKernel::onCells(u16 k, u32 m, u32 n, Real dx, Real dy,
+                                 const ivec &dc, const ivec &nc) {
+  assert(dc.n_elem == 4 && nc.n_elem == 4);
+  NodalKernel kernel;
+  const bool px = isPeriodic(dc, nc, 0), py = isPeriodic(dc, nc, 1);
+  kernel.init(k, {px ? m : m + 1, py ? n : n + 1}, {dx, dy}, {px, py});
+  kernel.toNodes = InterpolCtoN(k, m, n, dc, nc);
+  kernel.toCenters = InterpolNtoC(k, m, n, dc, nc);
+  return kernel;
+}
+
+NodalKernel NodalKernel::onCells(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                 Real dy, Real dz, const ivec &dc,
+                                 const ivec &nc) {
+  assert(dc.n_elem == 6 && nc.n_elem == 6);
+  NodalKernel kernel;
+  const bool px = isPeriodic(dc, nc, 0), py = isPeriodic(dc, nc, 1),
+             pz = isPeriodic(dc, nc, 2);
+  kernel.init(k, {px ? m : m + 1, py ? n : n + 1, pz ? o : o + 1},
+              {dx, dy, dz}, {px, py, pz});
+  kernel.toNodes = InterpolCtoN(k, m, n, o, dc, nc);
+  kernel.toCenters = InterpolNtoC(k, m, n, o, dc, nc);
+  return kernel;
+}
+
+void NodalKernel::init(u16 k, const std::vector<u32> &nodes,
+                       const std::vector<Real> &spacing,
+                       const std::vector<bool> &periodic) {
+  MOLE_PROFILE_SCOPE("NodalKernel");
+  static const char *const names[] = {"dx", "dy", "dz"};
+  for (size_t a = 0; a < spacing.size(); ++a)
+    mole::check_spacing(spacing[a], names[a]);
+  assert(!(k % 2));
+  assert(k > 1);
+  const u32 p = k / 2, q = k + 1;
+
+  // Interior: points -p..p. Boundary row i: points -i..k-i.
+  std::vector<Real> points(q);
+  for (u32 j = 0; j < q; ++j)
+    points[j] = static_cast<Real>(j) - p;
+  std::vector<Real> centered = derivativeWeights(points);
+  centered[p] = 0.0; // antisymmetric stencil
+  std::vector<std::vector<Real>> sided(p);
+  for (u32 i = 0; i < p; ++i) {
+    for (u32 j = 0; j < q; ++j)
+      points[j] = static_cast<Real>(j) - i;
+    sided[i] = derivativeWeights(points);
+  }
+
+  total = 1;
+  axes.resize(nodes.size());
+  for (size_t a = 0; a < nodes.size(); ++a) {
+    const u32 L = nodes[a];
+    assert(L >= q);
+    const Real h = spacing[a];
+    Line &line = axes[a];
+    line.nodes = L;
+    line.periodic = periodic[a];
+    line.half = p;
+    line.interior.resize(q);
+    for (u32 j = 0; j < q; ++j)
+      line.interior[j] = centered[j] / h;
+
+    line.rowStart.assign(1, 0);
+    auto add = [&line](u32 c, Real v) {
+      if (v != 0.0) {
+        line.col.push_back(c);
+        line.val.push_back(v);
+      }
+    };
+    for (u32 i = 0; i < L; ++i) {
+      if (i >= p && i + p < L) {
+        for (u32 j = 0; j < q; ++j)
+          add(i - p + j, line.interior[j]);
+      } else if (line.periodic) {
+        for (u32 j = 0; j < q; ++j)
+          add((i + L - p + j) % L, line.interior[j]);
+      } else if (i < p) {
+        for (u32 j = 0; j < q; ++j)
+          add(j, sided[i][j] / h);
+      } else {
+        // Mirror of the left rows: -Pp*A*Pq in nodal.m
+        const u32 r = L - 1 - i;
+        for (u32 j = q; j-- > 0;)
+          add(L - 1 - j, -sided[r][j] / h);
+      }
+      line.rowStart.push_back(line.col.size());
+    }
+    total *= L;
+  }
+}
+
+void NodalKernel::apply(const vec &u, vec &out) const {
+  MOLE_PROFILE_SCOPE("NodalKernel::apply");
+  if (u.n_elem != total)
+    throw std::invalid_argument("MOLE: expected " + std::to_string(total) +
+                                " nodal values");
+  out.set_size(axes.size() * total);
+
+  uword inner = 1;
+  for (size_t a = 0; a < axes.size(); ++a) {
+    const Line &line = axes[a];
+    const uword L = line.nodes, p = line.half, width = 2 * p + 1;
+    const uword outer = total / (inner * L);
+    const uword *start = line.rowStart.data();
+    const u32 *col = line.col.data();
+    const Real *val = line.val.data();
+    const Real *w = line.interior.data();
+    const Real *x = u.memptr();
+    Real *y = out.memptr() + a * total;
+
+    if (inner == 1) {
+      // x: the nodes of a line are contiguous
+#pragma omp parallel for schedule(static)
+      for (uword o = 0; o < outer; ++o) {
+        const Real *xl = x + o * L;
+        Real *yl = y + o * L;
+        // Boundary rows from the table, interior rows with the stencil
+        for (uword b = 0; b < 2 * p; ++b) {
+          const uword i = b < p ? b : L - 2 * p + b;
+          Real sum = 0.0;
+          for (uword e = start[i]; e < start[i + 1]; ++e)
+            sum += val[e] * xl[col[e]];
+          yl[i] = sum;
+        }
+#pragma omp simd
+        for (uword i = p; i < L - p; ++i) {
+          Real sum = 0.0;
+          for (uword j = 0; j < width; ++j)
+            sum += w[j] * xl[i - p + j];
+          yl[i] = sum;
+        }
+      }
+    } else {
+      // y, z: each row combines whole contiguous x-lines
+#pragma omp parallel for schedule(static)
+      for (uword r = 0; r < outer * L; ++r) {
+        const uword o = r / L, i = r % L;
+        const Real *xo = x + o * L * inner;
+        Real *yl = y + r * inner;
+#pragma omp simd
+        for (uword t = 0; t < inner; ++t)
+          yl[t] = 0.0;
+        for (uword e = start[i]; e < start[i + 1]; ++e) {
+          const Real c = val[e];
+          const Real *xs = xo + col[e] * inner;
+#pragma omp simd
+          for (uword t = 0; t < inner; ++t)
+            yl[t] += c * xs[t];
+        }
+      }
+    }
+    inner *= L;
+  }
+}
+
+vec NodalKernel::apply(const vec &u) const {
+  vec out;
+  apply(u, out);
+  return out;
+}
+
+void NodalKernel::applyCenters(const vec &centers, vec &out,
+                               bool atCenters) const {
+  if (toNodes.n_rows == 0)
+    throw std::runtime_error("MOLE: applyCenters needs a kernel made with "
+                             "NodalKernel::onCells");
+  if (centers.n_elem != toNodes.n_cols)
+    throw std::invalid_argument("MOLE: expected " +
+                                std::to_string(toNodes.n_cols) +
+                                " cell-centered values");
+  vec derivatives;
+  apply(toNodes * centers, derivatives);
+  if (!atCenters) {
+    out = std::move(derivatives);
+    return;
+  }
+
+  const uword C = toCenters.n_rows;
+  out.set_size(axes.size() * C);
+  for (uword a = 0; a < axes.size(); ++a) {
+    const vec block(derivatives.memptr() + a * total, total, false, true);
+    out.subvec(a * C, (a + 1) * C - 1) = toCenters * block;
+  }
+}
+
+Nodal::Nodal(u16 k, u32 m, Real dx) {
+  MOLE_PROFILE_SCOPE("Nodal 1-D");
+  assemble(NodalKernel(k, m, dx));
+}
+
+Nodal::Nodal(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  MOLE_PROFILE_SCOPE("Nodal 2-D");
+  assemble(NodalKernel(k, m, n, dx, dy));
+}
+
+Nodal::Nodal(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  MOLE_PROFILE_SCOPE("Nodal 3-D");
+  assemble(NodalKernel(k, m, n, o, dx, dy, dz));
+}
+
+Nodal::Nodal(const NodalKernel &kernel) {
+  MOLE_PROFILE_SCOPE("Nodal");
+  assemble(kernel);
+}
+
+void Nodal::assemble(const NodalKernel &kernel) {
+  const uword N = kernel.size();
+  const u16 d = kernel.dimensions();
+
+  uword nnz = 0;
+  for (u16 a = 0; a < d; ++a)
+    nnz += N / kernel.nodes(a) * kernel.line(a).val.size();
+  umat locations(2, nnz);
+  vec values(nnz);
+
+  // Every line of an axis repeats the same entries, so the position of each
+  // line's entries is known up front and lines are filled in parallel.
+  uword offset = 0, inner = 1;
+  for (u16 a = 0; a < d; ++a) {
+    const NodalKernel::Line &line = kernel.line(a);
+    const uword L = line.nodes, lines = N / L, per = line.val.size();
+
+#pragma omp parallel for schedule(static)
+    for (uword l = 0; l < lines; ++l) {
+      const uword base = (l / inner) * L * inner + l % inner;
+      uword e = offset + l * per;
+      for (uword i = 0; i < L; ++i) {
+        for (uword p = line.rowStart[i]; p < line.rowStart[i + 1]; ++p) {
+          locations(0, e) = a * N + base + i * inner;
+          locations(1, e) = base + line.col[p] * inner;
+          values(e) = line.val[p];
+          ++e;
+        }
+      }
+    }
+    offset += lines * per;
+    inner *= L;
+  }
+
+  *this = sp_mat(locations, values, d * N, N);
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
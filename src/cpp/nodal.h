@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file nodal.h
+ *
+ * @brief First derivatives on uniform nodal grids
+ *
+ * The C++ counterpart of nodal.m, nodal2D.m and nodal3D.m. Interior nodes
+ * use the centered (k+1)-point stencil; the k/2 nodes next to each boundary
+ * use one-sided (k+1)-point stencils.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef NODAL_H
+#define NODAL_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Nodal derivatives applied with stencils
+ *
+ * Stores one stencil table per axis and applies the stacked operator
+ * [Dx; Dy; Dz] to nodal values without assembling it. Along x the interior
+ * stencil runs over contiguous nodes; along y and z it is applied to whole
+ * x-lines at once, so the innermost loops are unit-stride and vectorise.
+ */
+class NodalKernel {
+public:
+  /**
+   * @brief 1-D, 2-D and 3-D kernels on non-periodic nodal grids
+   *
+   * @param k  Order of accuracy (even)
+   * @param m  Number of nodes along x
+   * @param dx Step size along x
+   */
+  NodalKernel(u16 k, u32 m, Real dx);
+  NodalKernel(u16 k, u32 m, u32 n, Real dx, Real dy);
+  NodalKernel(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Kernel on the nodes of a cell-centered grid
+   *
+   * The nodes are those InterpolCtoN produces for the same dc/nc: m+1
+   * nodes along a non-periodic axis with m cells, m nodes along a periodic
+   * one (where the stencils wrap around). The InterpolCtoN/InterpolNtoC
+   * pair is kept, so applyCenters() differentiates cell-centered data.
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of cells along x
+   * @param dx Step size along x
+   * @param dc Dirichlet coefficients, two per axis
+   * @param nc Neumann coefficients, two per axis
+   */
+  static NodalKernel onCells(u16 k, u32 m, Real dx, const ivec &dc,
+                             const ivec &nc);
+  static NodalKernel onCells(u16 k, u32 m, u32 n, Real dx, Real dy,
+                             const ivec &dc, const ivec &nc);
+  static NodalKernel onCells(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy,
+                             Real dz, const ivec &dc, const ivec &nc);
+
+  /**
+   * @brief Number of dimensions (1, 2 or 3)
+   */
+  u16 dimensions() const { return static_cast<u16>(axes.size()); }
+
+  /**
+   * @brief Number of nodes along an axis
+   */
+  u32 nodes(u16 axis) const { return axes[axis].nodes; }
+
+  /**
+   * @brief Whether the stencils wrap around along an axis
+   */
+  bool periodic(u16 axis) const { return axes[axis].periodic; }
+
+  /**
+   * @brief Total number of nodes
+   */
+  uword size() const { return total; }
+
+  /**
+   * @brief out = [Dx; Dy; Dz] * u, without assembling the operator
+   *
+   * @param u   Nodal values, x fastest
+   * @param out Derivatives, one block of size() entries per axis
+   */
+  void apply(const vec &u, vec &out) const;
+  vec apply(const vec &u) const;
+
+  /**
+   * @brief Derivatives of cell-centered data
+   *
+   * Interpolates with InterpolCtoN, applies the stencils and, if atCenters
+   * is set, brings every derivative block back with InterpolNtoC. Only for
+   * kernels made with onCells().
+   */
+  void applyCenters(const vec &centers, vec &out,
+                    bool atCenters = false) const;
+
+  /**
+   * @brief Interpolators of an onCells() kernel
+   */
+  const sp_mat &centersToNodes() const { return toNodes; }
+  const sp_mat &nodesToCenters() const { return toCenters; }
+
+  /**
+   * @brief One axis as a list of (row, column, value) entries
+   *
+   * Row i of a line holds entries rowStart[i] to rowStart[i+1]-1. Columns
+   * are positions along the same line; values include 1/dx.
+   */
+  struct Line {
+    u32 nodes;
+    bool periodic;
+    u32 half;                   // k/2, rows before the interior stencil
+    std::vector<Real> interior; // centered stencil, k+1 weights
+    std::vector<uword> rowStart;
+    std::vector<u32> col;
+    std::vector<Real> val;
+  };
+
+  /**
+   * @brief Stencil table of an axis
+   */
+  const Line &line(u16 axis) const { return axes[axis]; }
+
+private:
+  NodalKernel() = default;
+
+  std::vector<Line> axes;
+  uword total = 0;
+  sp_mat toNodes;
+  sp_mat toCenters;
+
+  void init(u16 k, const std::vector<u32> &nodes,
+            const std::vector<Real> &spacing,
+            const std::vector<bool> &periodic);
+};
+
+/**
+ * @brief Nodal first derivative operators (nodal, nodal2D, nodal3D)
+ *
+ * Rows are stacked [Dx; Dy; Dz] over all nodes, x fastest. The 2-D and 3-D
+ * operators are assembled directly from the 1-D stencils, without Kronecker
+ * products. For derivatives of cell-centered data, multiply by
+ * NodalKernel::centersToNodes() of a kernel made with NodalKernel::onCells().
+ */
+class Nodal : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief 1-D Nodal Operator Constructor
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of nodes
+   * @param dx Step size
+   */
+  Nodal(u16 k, u32 m, Real dx);
+
+  /**
+   * @brief 2-D Nodal Operator Constructor
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of nodes along x
+   * @param n  Number of nodes along y
+   * @param dx Step size along x
+   * @param dy Step size along y
+   */
+  Nodal(u16 k, u32 m, u32 n, Real dx, Real dy);
+
+  /**
+   * @brief 3-D Nodal Operator Constructor
+   *
+   * @param k  Order of accuracy
+   * @param m  Number of nodes along x
+   * @param n  Number of nodes along y
+   * @param o  Number of nodes along z
+   * @param dx Step size along x
+   * @param dy Step size along y
+   * @param dz Step size along z
+   */
+  Nodal(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Assembles the operator a kernel applies
+   */
+  explicit Nodal(const NodalKernel &kernel);
+
+private:
+  void assemble(const NodalKernel &kernel);
+};
+
+#endif // NODAL_H
@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file nonuniform.cpp
+ *
+ * @brief Building blocks and matrix-free application of non-uniform
+ *        mimetic operators
+ *
+ * @date 2026/10/19
+ */
+
+#include "nonuniform.h"
+#include "divergence.h"
+#include "gradient.h"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+NonUniformKernel::NonUniformKernel(Kind kind, u16 k, const vec &xticks)
+    : kind(kind) {
+  init(k, {xticks});
+}
+
+NonUniformKernel::NonUniformKernel(Kind kind, u16 k, const vec &xticks,
+                                   const vec &yticks)
+    : kind(kind) {
+  init(k, {xticks, yticks});
+}
+
+NonUniformKernel::NonUniformKernel(Kind kind, u16 k, const vec &xticks,
+                                   const vec &yticks, const vec &zticks)
+    : kind(kind) {
+  init(k, {xticks, yticks, zticks});
+}
+
+void NonUniformKernel::init(u16 k, const std::vector<vec> &ticks) {
+  MOLE_PROFILE_SCOPE("NonUniformKernel");
+  const bool gradient = kind == Kind::Gradient;
+  // Gradient ticks are centers (m+2), divergence ticks are faces (m+1)
+  const uword extra = gradient ? 2 : 1;
+
+  // Smallest cell counts accepted by the uniform operators
+  const uword fewest = gradient ? 2 * k : 2 * k + 1;
+
+  for (const vec &t : ticks) {
+    if (t.n_elem < extra + fewest)
+      throw std::invalid_argument("MOLE: too few ticks (" +
+                                  std::to_string(t.n_elem) + ") for order " +
+                                  std::to_string(k));
+    for (uword i = 1; i < t.n_elem; ++i) {
+      if (!(t(i) > t(i - 1)))
+        throw std::invalid_argument(
+            "MOLE: ticks must be strictly increasing");
+    }
+
+    const u32 cells = static_cast<u32>(t.n_elem - extra);
+    m.push_back(cells);
+    const sp_mat U = gradient ? sp_mat(Gradient(k, cells, 1.0))
+                              : sp_mat(Divergence(k, cells, 1.0));
+    factors.push_back(scaleByJacobian(U, t));
+    byRows.push_back(factors.back().t());
+  }
+
+  // Centers: prod(m+2). Faces: the a-th block has m_a+1 entries along a
+  // and m_b interior entries along every other axis.
+  uword centers = 1, faces = 0;
+  for (size_t a = 0; a < m.size(); ++a) {
+    centers *= m[a] + 2;
+    uword block = m[a] + 1;
+    for (size_t b = 0; b < m.size(); ++b)
+      if (b != a)
+        block *= m[b];
+    faces += block;
+  }
+  n_rows = gradient ? faces : centers;
+  n_cols = gradient ? centers : faces;
+}
+
+sp_mat NonUniformKernel::scaleByJacobian(const sp_mat &U, const vec &ticks) {
+  assert(U.n_cols == ticks.n_elem);
+  const vec J = U * ticks;
+
+  U.sync();
+  uvec row_indices(U.n_nonzero), col_ptrs(U.n_cols + 1);
+  vec values(U.n_nonzero);
+  for (uword c = 0; c <= U.n_cols; ++c)
+    col_ptrs(c) = U.col_ptrs[c];
+  for (uword p = 0; p < U.n_nonzero; ++p) {
+    const uword r = U.row_indices[p];
+    if (J(r) == 0.0)
+      throw std::invalid_argument("MOLE: ticks give a zero Jacobian");
+    row_indices(p) = r;
+    values(p) = U.values[p] / J(r);
+  }
+  return sp_mat(row_indices, col_ptrs, values, U.n_rows, U.n_cols);
+}
+
+void NonUniformKernel::apply(const vec &u, vec &out) const {
+  MOLE_PROFILE_SCOPE("NonUniformKernel::apply");
+  if (u.n_elem != n_cols)
+    throw std::invalid_argument("MOLE: expected a vector of length " +
+                                std::to_string(n_cols));
+  out.zeros(n_rows);
+
+  const bool gradient = kind == Kind::Gradient;
+  const size_t d = m.size();
+
+  // Strides of the centers grid (m_b + 2 per axis, x fastest)
+  std::vector<uword> centerStride(d, 1);
+  for (size_t b = 1; b < d; ++b)
+    centerStride[b] = centerStride[b - 1] * (m[b - 1] + 2);
+
+  uword offset = 0; // start of the current face block
+  for (size_t a = 0; a < d; ++a) {
+    // Strides inside face block a: m_a+1 along a, m_b along the others
+    std::vector<uword> faceStride(d, 1);
+    for (size_t b = 1; b < d; ++b)
+      faceStride[b] = faceStride[b - 1] * (b - 1 == a ? m[a] + 1 : m[b - 1]);
+
+    uword lines = 1;
+    for (size_t b = 0; b < d; ++b)
+      if (b != a)
+        lines *= m[b];
+
+    const sp_mat &A = byRows[a];
+    const uword *ptr = A.col_ptrs;
+    const uword *col = A.row_indices;
+    const Real *val = A.values;
+    const uword length = A.n_cols; // rows of the 1-D operator
+
+    const uword centerStep = centerStride[a], faceStep = faceStride[a];
+    const Real *in = u.memptr();
+    Real *res = out.memptr();
+
+#pragma omp parallel for schedule(static)
+    for (uword line = 0; line < lines; ++line) {
+      // Interior index along every other axis; boundary centers of those
+      // axes are neither read (gradient) nor written (divergence).
+      uword rest = line, center = 0, face = offset;
+      for (size_t b = 0; b < d; ++b) {
+        if (b == a)
+          continue;
+        const uword t = rest % m[b];
+        rest /= m[b];
+        center += (t + 1) * centerStride[b];
+        face += t * faceStride[b];
+      }
+
+      for (uword r = 0; r < length; ++r) {
+        Real sum = 0.0;
+        for (uword p = ptr[r]; p < ptr[r + 1]; ++p)
+          sum += val[p] * (gradient ? in[center + col[p] * centerStep]
+                                    : in[face + col[p] * faceStep]);
+        if (gradient)
+          res[face + r * faceStep] = sum;
+        else
+          res[center + r * centerStep] += sum;
+      }
+    }
+
+    uword block = m[a] + 1;
+    for (size_t b = 0; b < d; ++b)
+      if (b != a)
+        block *= m[b];
+    offset += block;
+  }
+}
+
+vec NonUniformKernel::apply(const vec &u) const {
+  vec out;
+  apply(u, out);
+  return out;
+}
@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file nonuniform.h
+ *
+ * @brief Building blocks and matrix-free application of non-uniform
+ *        mimetic operators
+ *
+ * A non-uniform operator is the unit-spacing operator U with each row
+ * divided by the local Jacobian, diag((U*ticks)^-1) * U (gradNonUniform.m,
+ * divNonUniform.m). The division is applied to the values of U as they are
+ * copied, so no diagonal matrix or sparse product is formed.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef NONUNIFORM_H
+#define NONUNIFORM_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Non-uniform Gradient or Divergence applied line by line
+ *
+ * Keeps only the 1-D operators of each axis and applies the 2-D/3-D
+ * operator to a vector without assembling it. Lines are processed in
+ * parallel with OpenMP. GradientNonUniform and DivergenceNonUniform are
+ * assembled from the same 1-D operators, so both paths agree exactly.
+ */
+class NonUniformKernel {
+public:
+  enum class Kind { Gradient, Divergence };
+
+  /**
+   * @brief 1-D, 2-D and 3-D kernels
+   *
+   * @param kind   Gradient (ticks are the m+2 cell centers, boundaries
+   *               included) or Divergence (ticks are the m+1 faces)
+   * @param k      Order of accuracy
+   * @param xticks Coordinates along x, strictly increasing
+   *
+   * @throws std::invalid_argument if the ticks are not strictly increasing
+   *         or too few for order k
+   */
+  NonUniformKernel(Kind kind, u16 k, const vec &xticks);
+  NonUniformKernel(Kind kind, u16 k, const vec &xticks, const vec &yticks);
+  NonUniformKernel(Kind kind, u16 k, const vec &xticks, const vec &yticks,
+                   const vec &zticks);
+
+  /**
+   * @brief Rows and columns of the equivalent assembled operator
+   */
+  uword rows() const { return n_rows; }
+  uword cols() const { return n_cols; }
+
+  /**
+   * @brief out = Op * u, without assembling Op
+   */
+  void apply(const vec &u, vec &out) const;
+  vec apply(const vec &u) const;
+
+  /**
+   * @brief Number of dimensions (1, 2 or 3)
+   */
+  u16 dimensions() const { return static_cast<u16>(m.size()); }
+
+  /**
+   * @brief Number of cells along an axis
+   */
+  u32 cells(u16 axis) const { return m[axis]; }
+
+  /**
+   * @brief 1-D operator along an axis, Jacobian included
+   */
+  const sp_mat &factor(u16 axis) const { return factors[axis]; }
+
+  /**
+   * @brief diag((U*ticks)^-1) * U, scaling the values of U in place of a
+   *        sparse product
+   *
+   * Rows of U that are empty (e.g. the boundary rows of a divergence) stay
+   * empty.
+   */
+  static sp_mat scaleByJacobian(const sp_mat &U, const vec &ticks);
+
+private:
+  Kind kind;
+  std::vector<u32> m;
+  std::vector<sp_mat> factors;
+  std::vector<sp_mat> byRows; // transposes: CSC of A^T is CSR of A
+  uword n_rows, n_cols;
+
+  void init(u16 k, const std::vector<vec> &ticks);
+};
+
+#endif // NONUNIFORM_H
@@ -32,106 +32,146 @@
 #include "interpolCtoN.h"
 #include "interpolFtoC.h"
 #include "interpolNtoC.h"
+#include "curl.h"
+#include "gradientCurv.h"
+#include "divergenceCurv.h"
+#include "gradientNonUniform.h"
+#include "divergenceNonUniform.h"
+#include "nodal.h"
+#include "sidedNodal.h"
+
+// The operators are used through const sp_mat references: a (sp_mat) cast
+// would copy the whole matrix on every call. For products into existing
+// buffers use the apply()/apply_add() members. The compositions below are
+// assembled eagerly; mole::lazy() (expression.h) defers them instead.
 
 inline sp_mat operator*(const Divergence &div, const Gradient &grad) {
-  return (sp_mat)div * (sp_mat)grad;
+  return static_cast<const sp_mat &>(div) * static_cast<const sp_mat &>(grad);
 }
 
 inline sp_mat operator*(const InterpolCtoF &I, const Divergence &div) {
-  return (sp_mat)I * (sp_mat)div;
+  return static_cast<const sp_mat &>(I) * static_cast<const sp_mat &>(div);
 }
 
 inline sp_mat operator*(const InterpolFtoC &I, const Gradient &grad) {
-  return (sp_mat)I * (sp_mat)grad;
+  return static_cast<const sp_mat &>(I) * static_cast<const sp_mat &>(grad);
 }
 
 inline sp_mat operator*(const Divergence &div, const InterpolCtoF &I) {
-  return (sp_mat)div * (sp_mat)I;
+  return static_cast<const sp_mat &>(div) * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator*(const Gradient &grad, const InterpolFtoC &I) {
-  return (sp_mat)grad * (sp_mat)I;
+  return static_cast<const sp_mat &>(grad) * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator+(const Laplacian &lap, const RobinBC &bc) {
-  return (sp_mat)lap + (sp_mat)bc;
+  return static_cast<const sp_mat &>(lap) + static_cast<const sp_mat &>(bc);
 }
 
 inline sp_mat operator+(const Laplacian &lap, const MixedBC &bc) {
-  return (sp_mat)lap + (sp_mat)bc;
+  return static_cast<const sp_mat &>(lap) + static_cast<const sp_mat &>(bc);
 }
 
 inline vec operator*(const Divergence &div, const vec &v) {
-  return (sp_mat)div * v;
+  return static_cast<const sp_mat &>(div) * v;
 }
 
 inline vec operator*(const Gradient &grad, const vec &v) {
-  return (sp_mat)grad * v;
+  return static_cast<const sp_mat &>(grad) * v;
 }
 
 inline vec operator*(const Laplacian &lap, const vec &v) {
-  return (sp_mat)lap * v;
+  return static_cast<const sp_mat &>(lap) * v;
 }
 
 inline vec operator*(const Interpol &I, const vec &v) { 
-  return (sp_mat)I * v; 
+  return static_cast<const sp_mat &>(I) * v; 
 }
 
 inline vec operator*(const InterpolCtoF &I, const vec &v) {
-  return (sp_mat)I * v;
+  return static_cast<const sp_mat &>(I) * v;
 }
 
 inline vec operator*(const InterpolCtoN &I, const vec &v) {
-  return (sp_mat)I * v;
+  return static_cast<const sp_mat &>(I) * v;
 }
 
 inline vec operator*(const InterpolFtoC &I, const vec &v) {
-  return (sp_mat)I * v;
+  return static_cast<const sp_mat &>(I) * v;
 }
 
 inline vec operator*(const InterpolNtoC &I, const vec &v) {
-  return (sp_mat)I * v;
+  return static_cast<const sp_mat &>(I) * v;
+}
+
+inline vec operator*(const Curl &C, const vec &v) {
+  return static_cast<const sp_mat &>(C) * v;
+}
+
+inline vec operator*(const GradientCurv &grad, const vec &v) {
+  return static_cast<const sp_mat &>(grad) * v;
+}
+
+inline vec operator*(const DivergenceCurv &div, const vec &v) {
+  return static_cast<const sp_mat &>(div) * v;
+}
+
+inline vec operator*(const GradientNonUniform &grad, const vec &v) {
+  return static_cast<const sp_mat &>(grad) * v;
+}
+
+inline vec operator*(const DivergenceNonUniform &div, const vec &v) {
+  return static_cast<const sp_mat &>(div) * v;
+}
+
+inline vec operator*(const Nodal &N, const vec &v) {
+  return static_cast<const sp_mat &>(N) * v;
+}
+
+inline vec operator*(const SidedNodal &N, const vec &v) {
+  return static_cast<const sp_mat &>(N) * v;
 }
 
 // Add scalar multiplication operators
 inline sp_mat operator*(const double scalar, const Interpol& I) {
-    return scalar * (sp_mat)I;
+    return scalar * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator*(const Interpol& I, const double scalar) {
-    return scalar * (sp_mat)I;
+    return scalar * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator*(const double scalar, const Laplacian& L) {
-    return scalar * (sp_mat)L;
+    return scalar * static_cast<const sp_mat &>(L);
 }
 
 inline sp_mat operator*(const Laplacian& L, const double scalar) {
-    return scalar * (sp_mat)L;
+    return scalar * static_cast<const sp_mat &>(L);
 }
 
 inline sp_mat operator*(const double scalar, const RobinBC& bc) {
-    return scalar * (sp_mat)bc;
+    return scalar * static_cast<const sp_mat &>(bc);
 }
 
 inline sp_mat operator*(const RobinBC& bc, const double scalar) {
-    return scalar * (sp_mat)bc;
+    return scalar * static_cast<const sp_mat &>(bc);
 }
 
 inline sp_mat operator*(const InterpolCtoF& I, const double scalar) {
-    return scalar * (sp_mat)I;
+    return scalar * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator*(const InterpolCtoN& I, const double scalar) {
-    return scalar * (sp_mat)I;
+    return scalar * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator*(const InterpolFtoC& I, const double scalar) {
-    return scalar * (sp_mat)I;
+    return scalar * static_cast<const sp_mat &>(I);
 }
 
 inline sp_mat operator*(const InterpolNtoC& I, const double scalar) {
-    return scalar * (sp_mat)I;
+    return scalar * static_cast<const sp_mat &>(I);
 }
 
 #endif // OPERATORS_H
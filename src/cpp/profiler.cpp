@@ -0,0 +1,305 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file profiler.cpp
+ *
+ * @brief Lightweight scoped timers and counters for MOLE hot paths
+ *
+ * @date 2026/10/19
+ */
+
+#include "profiler.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mole {
+namespace profiling {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Chrome traces beyond this many events per thread are truncated; the
+// aggregated report is always complete.
+const size_t max_events = size_t(1) << 20;
+
+struct Node {
+  const char *name;
+  int parent;
+  std::vector<int> children;
+  std::uint64_t calls = 0;
+  std::uint64_t ns = 0;
+  std::vector<std::pair<const char *, double>> counters;
+
+  Node(const char *name, int parent) : name(name), parent(parent) {}
+};
+
+struct Event {
+  const char *name;
+  std::uint64_t start_ns;
+  std::uint64_t dur_ns;
+};
+
+struct Frame {
+  int node;
+  Clock::time_point start;
+};
+
+// Call tree of one thread. Node 0 is the thread root.
+struct Tree {
+  std::vector<Node> nodes;
+
+  Tree() { nodes.emplace_back("total", -1); }
+
+  int child(int parent, const char *name) {
+    for (int c : nodes[parent].children) {
+      if (nodes[c].name == name || std::strcmp(nodes[c].name, name) == 0)
+        return c;
+    }
+    nodes.emplace_back(name, parent);
+    const int id = static_cast<int>(nodes.size()) - 1;
+    nodes[parent].children.push_back(id);
+    return id;
+  }
+
+  void addCounter(int node, const char *name, double value) {
+    for (auto &c : nodes[node].counters) {
+      if (c.first == name || std::strcmp(c.first, name) == 0) {
+        c.second += value;
+        return;
+      }
+    }
+    nodes[node].counters.emplace_back(name, value);
+  }
+};
+
+struct ThreadData {
+  int tid;
+  Tree tree;
+  std::vector<Frame> stack;
+  std::vector<Event> events;
+  std::uint64_t dropped = 0;
+};
+
+void mergeInto(Tree &dst, int d, const Tree &src, int s) {
+  const Node &from = src.nodes[s];
+  dst.nodes[d].calls += from.calls;
+  dst.nodes[d].ns += from.ns;
+  for (const auto &c : from.counters)
+    dst.addCounter(d, c.first, c.second);
+  for (int c : from.children)
+    mergeInto(dst, dst.child(d, src.nodes[c].name), src, c);
+}
+
+// Counters are mostly integral (nnz, bytes); print them without the fixed
+// formatting used for times.
+std::string formatCounter(double value) {
+  std::ostringstream text;
+  text << std::setprecision(15) << value;
+  return text.str();
+}
+
+void printNode(std::ostream &out, const Tree &tree, int id, int depth) {
+  const Node &node = tree.nodes[id];
+  std::uint64_t child_ns = 0;
+  for (int c : node.children)
+    child_ns += tree.nodes[c].ns;
+  const double total_ms = node.ns * 1e-6;
+  const double self_ms = (node.ns > child_ns ? node.ns - child_ns : 0) * 1e-6;
+
+  out << std::setw(12) << total_ms << std::setw(12) << self_ms
+      << std::setw(10) << node.calls << "  " << std::string(2 * depth, ' ')
+      << node.name;
+  for (const auto &c : node.counters)
+    out << "  " << c.first << '=' << formatCounter(c.second);
+  out << '\n';
+
+  for (int c : node.children)
+    printNode(out, tree, c, depth + 1);
+}
+
+void printReport(std::ostream &out, const Tree &all) {
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+
+  out << "MOLE profile (wall time, all threads)\n"
+      << std::setw(12) << "total ms" << std::setw(12) << "self ms"
+      << std::setw(10) << "calls" << "  scope\n";
+  out << std::fixed << std::setprecision(3);
+  for (int c : all.nodes[0].children)
+    printNode(out, all, c, 0);
+  if (!all.nodes[0].counters.empty()) {
+    out << "unscoped counters:";
+    for (const auto &c : all.nodes[0].counters)
+      out << "  " << c.first << '=' << formatCounter(c.second);
+    out << '\n';
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// Owns the data of every thread that ever recorded a scope. Threads keep
+// a shared reference, so data survive thread exit until the report.
+class Registry {
+public:
+  Registry() : epoch(Clock::now()) {}
+
+  ~Registry() {
+    try {
+      dump();
+    } catch (...) {
+      // Never throw during static destruction.
+    }
+  }
+
+  std::shared_ptr<ThreadData> attach() {
+    auto data = std::make_shared<ThreadData>();
+    std::lock_guard<std::mutex> guard(lock);
+    data->tid = static_cast<int>(threads.size());
+    threads.push_back(data);
+    return data;
+  }
+
+  Tree merged() {
+    std::lock_guard<std::mutex> guard(lock);
+    Tree all;
+    for (const auto &t : threads) {
+      for (int c : t->tree.nodes[0].children)
+        mergeInto(all, all.child(0, t->tree.nodes[c].name), t->tree, c);
+      for (const auto &c : t->tree.nodes[0].counters)
+        all.addCounter(0, c.first, c.second);
+    }
+    return all;
+  }
+
+  void trace(std::ostream &out) {
+    std::lock_guard<std::mutex> guard(lock);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    out << std::fixed << std::setprecision(3);
+    for (const auto &t : threads) {
+      for (const Event &e : t->events) {
+        out << (first ? "\n" : ",\n") << "{\"name\": \"" << e.name
+            << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << t->tid
+            << ", \"ts\": " << e.start_ns * 1e-3
+            << ", \"dur\": " << e.dur_ns * 1e-3 << "}";
+        first = false;
+      }
+      if (t->dropped) {
+        std::cerr << "MOLE profiler: thread " << t->tid << " dropped "
+                  << t->dropped << " trace events\n";
+      }
+    }
+    out << "\n]}\n";
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (const auto &t : threads) {
+      t->tree = Tree();
+      t->events.clear();
+      t->dropped = 0;
+    }
+  }
+
+  Clock::time_point epoch;
+
+private:
+  std::mutex lock;
+  std::vector<std::shared_ptr<ThreadData>> threads;
+
+  void dump() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (threads.empty())
+        return;
+    }
+    printReport(std::cerr, merged());
+    if (const char *path = std::getenv("MOLE_PROFILE_TRACE")) {
+      std::ofstream out(path);
+      trace(out);
+    }
+  }
+};
+
+Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+
+ThreadData &local() {
+  // Touch the registry first so it is destroyed after any thread_local.
+  static thread_local std::shared_ptr<ThreadData> data = registry().attach();
+  return *data;
+}
+
+} // anonymous namespace
+
+void begin(const char *name) {
+  ThreadData &t = local();
+  const int parent = t.stack.empty() ? 0 : t.stack.back().node;
+  t.stack.push_back({t.tree.child(parent, name), Clock::now()});
+}
+
+void end() {
+  const Clock::time_point stop = Clock::now();
+  ThreadData &t = local();
+  if (t.stack.empty())
+    return;
+  const Frame frame = t.stack.back();
+  t.stack.pop_back();
+
+  const auto ns = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stop - frame.start)
+          .count());
+  Node &node = t.tree.nodes[frame.node];
+  node.calls++;
+  node.ns += ns;
+
+  if (t.events.size() < max_events) {
+    const auto start = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            frame.start - registry().epoch)
+            .count());
+    t.events.push_back({node.name, start, ns});
+  } else {
+    t.dropped++;
+  }
+}
+
+void count(const char *name, double value) {
+  ThreadData &t = local();
+  t.tree.addCounter(t.stack.empty() ? 0 : t.stack.back().node, name, value);
+}
+
+void report(std::ostream &out) { printReport(out, registry().merged()); }
+
+void writeChromeTrace(const std::string &path) {
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("MOLE: cannot open " + path + " for writing");
+  }
+  registry().trace(out);
+}
+
+void reset() { registry().clear(); }
+
+} // namespace profiling
+} // namespace mole
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file profiler.h
+ *
+ * @brief Lightweight scoped timers and counters for MOLE hot paths
+ *
+ * Instrumentation is compiled in only when MOLE_ENABLE_PROFILING is defined
+ * (CMake option of the same name). Otherwise every macro expands to nothing
+ * and the library carries no overhead.
+ *
+ *   MOLE_PROFILE_SCOPE("assembly");        // times the enclosing scope
+ *   MOLE_PROFILE_COUNT("nnz", A.n_nonzero); // adds to the innermost scope
+ *
+ * Scopes nest into a per-thread call tree. At program exit the merged tree
+ * is printed to stderr; if the MOLE_PROFILE_TRACE environment variable
+ * names a file, a Chrome trace (chrome://tracing, Perfetto) is written too.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <iosfwd>
+#include <string>
+
+namespace mole {
+namespace profiling {
+
+/**
+ * @brief Opens a named scope on the calling thread
+ *
+ * @param name Scope name; must outlive the program (use string literals)
+ */
+void begin(const char *name);
+
+/**
+ * @brief Closes the innermost scope opened by begin() on this thread
+ */
+void end();
+
+/**
+ * @brief Accumulates a counter (e.g. nnz, bytes) on the innermost scope
+ *
+ * @param name  Counter name; must outlive the program (use string literals)
+ * @param value Amount to add
+ */
+void count(const char *name, double value);
+
+/**
+ * @brief Prints the merged call tree: total/self time, calls and counters
+ */
+void report(std::ostream &out);
+
+/**
+ * @brief Writes every recorded scope as a Chrome trace JSON file
+ */
+void writeChromeTrace(const std::string &path);
+
+/**
+ * @brief Discards everything recorded so far
+ *
+ * @note Call only while no scope is open on any thread.
+ */
+void reset();
+
+/**
+ * @brief RAII helper behind MOLE_PROFILE_SCOPE
+ */
+class ScopedTimer {
+public:
+  explicit ScopedTimer(const char *name) { begin(name); }
+  ~ScopedTimer() { end(); }
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+};
+
+} // namespace profiling
+} // namespace mole
+
+#define MOLE_PROFILE_CONCAT_(a, b) a##b
+#define MOLE_PROFILE_CONCAT(a, b) MOLE_PROFILE_CONCAT_(a, b)
+
+#ifdef MOLE_ENABLE_PROFILING
+#define MOLE_PROFILE_SCOPE(name)                                               \
+  ::mole::profiling::ScopedTimer MOLE_PROFILE_CONCAT(mole_profile_, __LINE__)( \
+      name)
+#define MOLE_PROFILE_COUNT(name, value)                                        \
+  ::mole::profiling::count(name, static_cast<double>(value))
+#else
+#define MOLE_PROFILE_SCOPE(name) ((void)0)
+#define MOLE_PROFILE_COUNT(name, value) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file projection.cpp
+ *
+ * @brief Pressure projection of face velocities onto divergence-free fields
+ *
+ * @date 2026/10/19
+ */
+
+#include "projection.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mole {
+
+namespace {
+
+Real maxAbs(const vec &v) { return v.is_empty() ? 0.0 : abs(v).max(); }
+
+} // namespace
+
+Projection::Projection(const sp_mat &D, const sp_mat &G, const sp_mat &BC,
+                       const ProjectionOptions &opts)
+    : D(D), G(G), BC(BC), opts(opts), gauge(D.n_rows) {
+  MOLE_PROFILE_SCOPE("Projection");
+  const uword n = D.n_rows;
+  if (G.n_rows != D.n_cols || G.n_cols != n || BC.n_rows != n ||
+      BC.n_cols != n)
+    throw std::invalid_argument(
+        "MOLE: projection needs D (" + std::to_string(D.n_rows) + " x " +
+        std::to_string(D.n_cols) + "), G of its transposed size and a square "
+        "BC of D's rows; got G " + std::to_string(G.n_rows) + " x " +
+        std::to_string(G.n_cols) + " and BC " + std::to_string(BC.n_rows) +
+        " x " + std::to_string(BC.n_cols));
+
+  // diag(D G): row i of D (column i of D') against column i of G, both
+  // sorted by face
+  diagonal.zeros(n);
+  for (sp_mat::const_iterator it = BC.begin(); it != BC.end(); ++it)
+    if (it.row() == it.col())
+      diagonal(it.row()) += *it;
+  const sp_mat Dt = D.t();
+  G.sync();
+  for (uword i = 0; i < n; ++i) {
+    uword a = Dt.col_ptrs[i], b = G.col_ptrs[i];
+    while (a < Dt.col_ptrs[i + 1] && b < G.col_ptrs[i + 1]) {
+      if (Dt.row_indices[a] < G.row_indices[b])
+        ++a;
+      else if (Dt.row_indices[a] > G.row_indices[b])
+        ++b;
+      else
+        diagonal(i) += Dt.values[a++] * G.values[b++];
+    }
+    if (diagonal(i) == 0.0)
+      diagonal(i) = 1.0;
+  }
+
+  // Only Neumann conditions: constants are in the null space, fix the
+  // pressure on a boundary row whose point G uses
+  vec product;
+  schur(vec(n, fill::ones), product);
+  if (maxAbs(product) <= 1e-8 * maxAbs(diagonal)) {
+    std::vector<bool> boundary(n, false);
+    for (sp_mat::const_iterator it = BC.begin(); it != BC.end(); ++it)
+      boundary[it.row()] = true;
+    for (uword r = 0; r < n && gauge == n; ++r)
+      if (boundary[r] && G.col_ptrs[r + 1] > G.col_ptrs[r])
+        gauge = r;
+    for (uword r = 0; r < n && gauge == n; ++r)
+      if (G.col_ptrs[r + 1] > G.col_ptrs[r])
+        gauge = r;
+    if (gauge < n)
+      diagonal(gauge) = 1.0;
+  }
+
+  if (opts.solver == PressureSolve::Direct) {
+    sp_mat A = D * G + BC;
+    if (gauge < n) {
+      A.row(gauge).zeros();
+      A(gauge, gauge) = 1.0;
+    }
+    direct.reset(new LinearSolver(A));
+  }
+}
+
+void Projection::schur(const vec &p, vec &out) const {
+  mole::apply(G, p, faceWork);
+  mole::apply(D, faceWork, out);
+  mole::apply_add(BC, 1.0, p, 1.0, out);
+  if (gauge < D.n_rows)
+    out(gauge) = p(gauge);
+}
+
+ProjectionReport Projection::project(vec &u, vec &p, Real scale) const {
+  MOLE_PROFILE_SCOPE("Projection::project");
+  if (u.n_elem != faces())
+    throw std::invalid_argument("MOLE: expected " + std::to_string(faces()) +
+                                " face velocities");
+  if (scale == 0.0 || !std::isfinite(scale))
+    throw std::invalid_argument("MOLE: projection scale must be finite and "
+                                "nonzero");
+  if (p.n_elem != centers())
+    p.zeros(centers());
+
+  ProjectionReport report;
+  mole::apply(D, u, rhs);
+  report.divergenceBefore = maxAbs(rhs);
+  if (gauge < centers())
+    rhs(gauge) = 0.0;
+
+  if (direct) {
+    direct->solve(phi, rhs);
+  } else {
+    phi = scale * p;
+    solveIterative(rhs, phi, report);
+  }
+
+  // Velocity correction in place
+  mole::apply_add(G, -1.0, phi, 1.0, u);
+  p = phi / scale;
+
+  mole::apply(D, u, rhs);
+  report.divergenceAfter = maxAbs(rhs);
+  return report;
+}
+
+// Right-preconditioned BiCGSTAB; x holds the initial guess
+void Projection::solveIterative(const vec &b, vec &x,
+                                ProjectionReport &report) const {
+  const Real target = opts.tolerance * norm(b);
+  vec r, v;
+  schur(x, r);
+  r = b - r;
+  if (norm(r) <= target)
+    return;
+
+  const vec rhat = r;
+  vec p(r.n_elem, fill::zeros), s, t, phat, shat;
+  v.zeros(r.n_elem);
+  Real rho = 1.0, alpha = 1.0, omega = 1.0;
+  report.converged = false;
+
+  for (uword it = 1; it <= opts.maxIterations; ++it) {
+    report.iterations = it;
+    const Real rhoNext = dot(rhat, r);
+    if (rhoNext == 0.0)
+      return; // breakdown
+    p = r + (rhoNext / rho) * (alpha / omega) * (p - omega * v);
+    rho = rhoNext;
+
+    phat = p / diagonal;
+    schur(phat, v);
+    alpha = rho / dot(rhat, v);
+    s = r - alpha * v;
+    if (norm(s) <= target) {
+      x += alpha * phat;
+      report.converged = true;
+      return;
+    }
+
+    shat = s / diagonal;
+    schur(shat, t);
+    omega = dot(t, s) / dot(t, t);
+    x += alpha * phat + omega * shat;
+    r = s - omega * t;
+    if (norm(r) <= target) {
+      report.converged = true;
+      return;
+    }
+  }
+}
+
+} // namespace mole
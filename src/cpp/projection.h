@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file projection.h
+ *
+ * @brief Pressure projection of face velocities onto divergence-free fields
+ *
+ * The saddle-point system of an incompressible step,
+ *
+ *   [ I  G ] [ u   ]   [ u* ]
+ *   [ D  0 ] [ phi ] = [ 0  ],
+ *
+ * reduces to the pressure Schur complement (D G + BC) phi = D u*, followed
+ * by u = u* - G phi. With phi = (dt / rho) p this is the projection step of
+ * lock_exchange.cpp and cylinder_flow_2D.cpp.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef PROJECTION_H
+#define PROJECTION_H
+
+#include "solver.h"
+#include "utils.h"
+#include <memory>
+
+namespace mole {
+
+/**
+ * @brief How the pressure system is solved
+ *
+ * Direct factorizes D G + BC once and reuses it for every step. Iterative
+ * never assembles it: BiCGSTAB applies D and G in turn, with a Jacobi
+ * preconditioner and the previous pressure as the initial guess.
+ */
+enum class PressureSolve { Direct, Iterative };
+
+struct ProjectionOptions {
+  PressureSolve solver = PressureSolve::Direct;
+  Real tolerance = 1e-10;    // relative residual, Iterative only
+  uword maxIterations = 1000; // Iterative only
+};
+
+/**
+ * @brief Diagnostics of one projection
+ */
+struct ProjectionReport {
+  Real divergenceBefore = 0.0; // max |D u| of the input
+  Real divergenceAfter = 0.0;  // max |D u| of the projected field
+  uword iterations = 0;        // 0 for the direct solve
+  bool converged = true;
+};
+
+/**
+ * @brief Cached pressure projection for a fixed grid and boundary
+ *
+ * @code
+ *   const mole::Projection projection(Divergence(k, m, n, dx, dy),
+ *                                     Gradient(k, m, n, dx, dy),
+ *                                     RobinBC(k, m, dx, n, dy, 0, 1));
+ *   for (...) {
+ *     // u: predicted x- then y-face velocities
+ *     const auto report = projection.project(u, p, dt / rho);
+ *   }
+ * @endcode
+ *
+ * With only Neumann conditions D G + BC annihilates constants. The
+ * pressure is then fixed by replacing the first boundary condition row
+ * that couples to the interior with p = 0 (gaugeRow()).
+ *
+ * project() reuses internal buffers, so one Projection should not be used
+ * from two threads at once.
+ */
+class Projection {
+public:
+  /**
+   * @param D  Divergence, centers (with boundary) x faces
+   * @param G  Gradient, faces x centers (with boundary)
+   * @param BC Boundary rows of the pressure operator, e.g. RobinBC
+   *
+   * @throws std::invalid_argument if the sizes do not match
+   * @throws std::runtime_error if the direct factorization fails
+   */
+  Projection(const sp_mat &D, const sp_mat &G, const sp_mat &BC,
+             const ProjectionOptions &opts = ProjectionOptions());
+
+  Projection(const Projection &) = delete;
+  Projection &operator=(const Projection &) = delete;
+
+  uword faces() const { return D.n_cols; }
+  uword centers() const { return D.n_rows; }
+
+  /**
+   * @brief Row replaced by p = 0, or centers() if the system is regular
+   */
+  uword gaugeRow() const { return gauge; }
+
+  /**
+   * @brief Removes the divergent part of u in place
+   *
+   * Solves (D G + BC) phi = D u and sets u -= G phi.
+   *
+   * @param u     Face velocities, faces() entries
+   * @param p     Pressure phi / scale; its old value starts the iterative
+   *              solve, and it is resized if it has not centers() entries
+   * @param scale dt / rho, so that p is the physical pressure
+   * @throws std::invalid_argument if u has not faces() entries
+   */
+  ProjectionReport project(vec &u, vec &p, Real scale = 1.0) const;
+
+  /**
+   * @brief out = (D G + BC) p without assembling the product
+   */
+  void schur(const vec &p, vec &out) const;
+
+private:
+  void solveIterative(const vec &b, vec &x, ProjectionReport &report) const;
+
+  sp_mat D, G, BC;
+  ProjectionOptions opts;
+  uword gauge;
+  vec diagonal; // Jacobi preconditioner, diag(D G + BC)
+  std::unique_ptr<LinearSolver> direct;
+  mutable vec faceWork, rhs, phi;
+};
+
+} // namespace mole
+
+#endif // PROJECTION_H
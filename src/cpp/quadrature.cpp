@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file quadrature.cpp
+ *
+ * @brief Trapezoidal and mimetic quadrature of 1-D, 2-D and 3-D fields
+ *
+ * @date 2026/10/19
+ */
+
+#include "quadrature.h"
+#include "weights.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace mole {
+
+namespace {
+
+// Trapezoidal weights of one axis; a single tick has no extent
+vec trapzWeights(const vec &x) {
+  if (x.is_empty())
+    throw std::invalid_argument("MOLE: a quadrature needs ticks on every "
+                                "axis");
+  const uword n = x.n_elem;
+  vec w(n, fill::zeros);
+  for (uword i = 0; i + 1 < n; ++i) {
+    const Real half = 0.5 * (x(i + 1) - x(i));
+    w(i) += half;
+    w(i + 1) += half;
+  }
+  return w;
+}
+
+} // anonymous namespace
+
+constexpr uword Quadrature::chunk;
+
+Quadrature::Quadrature(const vec &x) { add(trapzWeights(x)); }
+
+Quadrature::Quadrature(const vec &x, const vec &y) {
+  add(trapzWeights(x), trapzWeights(y));
+}
+
+Quadrature::Quadrature(const vec &x, const vec &y, const vec &z) {
+  add(trapzWeights(x), trapzWeights(y), trapzWeights(z));
+}
+
+Quadrature::Quadrature(const MeshGrid &grid) {
+  if (grid.dims() == 2)
+    add(trapzWeights(grid.ticksOf(0)), trapzWeights(grid.ticksOf(1)));
+  else
+    add(trapzWeights(grid.ticksOf(0)), trapzWeights(grid.ticksOf(1)),
+        trapzWeights(grid.ticksOf(2)));
+}
+
+Quadrature Quadrature::centers(u16 k, const std::vector<u32> &cells,
+                               const std::vector<Real> &spacing,
+                               bool boundary) {
+  const uword dims = cells.size();
+  if (dims < 1 || dims > 3 || spacing.size() != dims)
+    throw std::invalid_argument("MOLE: expected 1 to 3 axes with a spacing "
+                                "each");
+  std::array<vec, 3> axes{{vec{1.0}, vec{1.0}, vec{1.0}}};
+  for (uword d = 0; d < dims; ++d) {
+    axes[d] = weightsQ(k, cells[d], spacing[d]);
+    if (!boundary)
+      axes[d](0) = axes[d](axes[d].n_elem - 1) = 0.0;
+  }
+  Quadrature rule;
+  rule.add(axes[0], axes[1], axes[2]);
+  return rule;
+}
+
+// One block per face orientation, as weightsP lays them out
+Quadrature Quadrature::faces(u16 k, const std::vector<u32> &cells,
+                             const std::vector<Real> &spacing) {
+  const uword dims = cells.size();
+  if (dims < 1 || dims > 3 || spacing.size() != dims)
+    throw std::invalid_argument("MOLE: expected 1 to 3 axes with a spacing "
+                                "each");
+  Quadrature rule;
+  for (uword d = 0; d < dims; ++d) {
+    std::array<vec, 3> axes{{vec{1.0}, vec{1.0}, vec{1.0}}};
+    for (uword e = 0; e < dims; ++e)
+      axes[e] = e == d ? weightsP(k, cells[e], spacing[e])
+                       : vec(cells[e], fill::ones);
+    rule.add(axes[0], axes[1], axes[2]);
+  }
+  return rule;
+}
+
+void Quadrature::add(const vec &x, const vec &y, const vec &z) {
+  blocks.push_back({{{x, y, z}}, total});
+  total += x.n_elem * y.n_elem * z.n_elem;
+}
+
+// Every line of a block is cut into chunks; the chunk sums go into one
+// array in a fixed order, so the threads only change who computes them.
+// Neumaier's summation over that array needs strict IEEE arithmetic, as
+// the build asks of every compiler (-fp-model=precise for icx).
+template <typename F> Real Quadrature::reduce(F &&value) const {
+  std::vector<Real> partial;
+  for (const Block &block : blocks) {
+    const Real *wx = block.axes[0].memptr(), *wy = block.axes[1].memptr(),
+               *wz = block.axes[2].memptr();
+    const uword nx = block.axes[0].n_elem, ny = block.axes[1].n_elem;
+    const uword perLine = (nx + chunk - 1) / chunk;
+    const uword pieces = perLine * ny * block.axes[2].n_elem;
+    const uword first = partial.size();
+    partial.resize(first + pieces);
+    Real *out = partial.data() + first;
+    const uword offset = block.offset;
+    const bool parallel = pieces > 1 && nx * ny * block.axes[2].n_elem >=
+                                            MeshGrid::minParallelPoints;
+
+#pragma omp parallel for schedule(static) if (parallel)
+    for (uword p = 0; p < pieces; ++p) {
+      const uword line = p / perLine, begin = (p % perLine) * chunk;
+      const uword end = std::min(nx, begin + chunk);
+      const uword base = offset + nx * line;
+      Real s = 0.0;
+#pragma omp simd reduction(+ : s)
+      for (uword i = begin; i < end; ++i)
+        s += wx[i] * value(base + i);
+      out[p] = wy[line % ny] * wz[line / ny] * s;
+    }
+  }
+
+  Real sum = 0.0, c = 0.0;
+  for (const Real x : partial) {
+    const Real t = sum + x;
+    c += std::abs(sum) >= std::abs(x) ? (sum - t) + x : (x - t) + sum;
+    sum = t;
+  }
+  return sum + c;
+}
+
+Real Quadrature::operator()(const vec &f) const {
+  MOLE_PROFILE_SCOPE("Quadrature");
+  if (f.n_elem != total)
+    throw std::invalid_argument("MOLE: expected a field of " +
+                                std::to_string(total) + " entries");
+  const Real *a = f.memptr();
+  return reduce([a](uword i) { return a[i]; });
+}
+
+Real Quadrature::dot(const vec &u, const vec &v) const {
+  MOLE_PROFILE_SCOPE("Quadrature::dot");
+  if (u.n_elem != total || v.n_elem != total)
+    throw std::invalid_argument("MOLE: expected fields of " +
+                                std::to_string(total) + " entries");
+  const Real *a = u.memptr(), *b = v.memptr();
+  return reduce([a, b](uword i) { return a[i] * b[i]; });
+}
+
+vec Quadrature::weights() const {
+  vec w(total);
+  for (const Block &block : blocks) {
+    const vec &x = block.axes[0], &y = block.axes[1], &z = block.axes[2];
+    uword p = block.offset;
+    for (uword l = 0; l < z.n_elem; ++l)
+      for (uword j = 0; j < y.n_elem; ++j)
+        for (uword i = 0; i < x.n_elem; ++i)
+          w(p++) = z(l) * y(j) * x(i);
+  }
+  return w;
+}
+
+} // namespace mole
@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file quadrature.h
+ *
+ * @brief Trapezoidal and mimetic quadrature of 1-D, 2-D and 3-D fields
+ *
+ * A Quadrature keeps its weights as tensor products of 1-D weights, so a
+ * 3-D rule costs three short vectors and not one weight per point. Sums
+ * are split into fixed chunks: each chunk is a SIMD reduction, the chunks
+ * run on the OpenMP threads, and the chunk sums are added with Neumaier's
+ * compensated summation. The result does not depend on the thread count.
+ *
+ * Built once per grid, a Quadrature makes a conservation check a single
+ * pass over the field. Without the boundary centers, the rule integrates
+ * over the cells:
+ *
+ * @code
+ *   const mole::Quadrature Q = mole::Quadrature::centers(
+ *       k, {m, n, o}, {dx, dy, dz}, false);
+ *   const Real mass0 = Q(u);
+ *   for (...) {
+ *     ...
+ *     const Real drift = Q(u) - mass0;
+ *   }
+ * @endcode
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef QUADRATURE_H
+#define QUADRATURE_H
+
+#include "meshgrid.h"
+#include <array>
+#include <vector>
+
+namespace mole {
+
+/**
+ * @brief Weighted sums sum_i w_i f_i over a field, x fastest
+ */
+class Quadrature {
+public:
+  /**
+   * @brief Trapezoidal rule on the tensor grid of the ticks
+   *
+   * @throws std::invalid_argument if an axis has no ticks
+   */
+  explicit Quadrature(const vec &x);
+  Quadrature(const vec &x, const vec &y);
+  Quadrature(const vec &x, const vec &y, const vec &z);
+  explicit Quadrature(const MeshGrid &grid);
+
+  /**
+   * @brief Mimetic rule on the centers, the weights of weightsQ
+   *
+   * @param k        Order of accuracy
+   * @param cells    Cells per axis, x first (1 to 3 axes)
+   * @param spacing  Cell width per axis
+   * @param boundary If false, the boundary centers get no weight and the
+   *                 rule covers the cells alone (weightsQ gives them 1)
+   */
+  static Quadrature centers(u16 k, const std::vector<u32> &cells,
+                            const std::vector<Real> &spacing,
+                            bool boundary = true);
+
+  /**
+   * @brief Mimetic rule on the faces, the weights of weightsP
+   */
+  static Quadrature faces(u16 k, const std::vector<u32> &cells,
+                          const std::vector<Real> &spacing);
+
+  /**
+   * @brief Number of points the rule expects
+   */
+  uword size() const { return total; }
+
+  /**
+   * @brief sum_i w_i f_i
+   *
+   * @throws std::invalid_argument if f has not size() entries
+   */
+  Real operator()(const vec &f) const;
+
+  /**
+   * @brief sum_i w_i u_i v_i, e.g. the energy <u, Q u>
+   */
+  Real dot(const vec &u, const vec &v) const;
+
+  /**
+   * @brief The weights as one vector, for inspection
+   */
+  vec weights() const;
+
+  /**
+   * @brief Entries summed as one SIMD chunk
+   */
+  static constexpr uword chunk = 512;
+
+private:
+  // w(offset + i + nx (j + ny l)) = axes[0](i) axes[1](j) axes[2](l)
+  struct Block {
+    std::array<vec, 3> axes;
+    uword offset;
+  };
+
+  Quadrature() = default;
+  void add(const vec &x, const vec &y = vec{1.0}, const vec &z = vec{1.0});
+
+  template <typename F> Real reduce(F &&value) const;
+
+  uword total = 0;
+  std::vector<Block> blocks;
+};
+
+} // namespace mole
+
+#endif // QUADRATURE_H
@@ -20,7 +20,7 @@
  * @brief Mimetic Robin Boundary Condition operator
  *
  */
-class RobinBC : public sp_mat {
+class RobinBC : public mole::Operator {
 
 public:
   using sp_mat::operator=;
@@ -48,7 +48,7 @@ public:
   * @param a Coefficient of the Dirichlet function
   * @param b Coefficient of the Neumann function
   * 
-  * @note Uses 1-D Robin to build the 2-D operator
+  * @note Assembled from the 1-D boundary rows (mole::robinRows)
   *
   */
   RobinBC(u16 k, u32 m, Real dx, u32 n, Real dy, Real a, Real b);
@@ -67,7 +67,7 @@ public:
   * @param a Coefficient of the Dirichlet function
   * @param b Coefficient of the Neumann function
   *
-  * @note Uses 1-D Robin to build the 3-D operator
+  * @note Assembled from the 1-D boundary rows (mole::robinRows)
   */
   RobinBC(u16 k, u32 m, Real dx, u32 n, Real dy, u32 o, Real dz, Real a,
           Real b);
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file sidedNodal.cpp
+ *
+ * @brief Sided first derivatives on periodic nodal grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "sidedNodal.h"
+#include <cassert>
+
+SidedNodal::SidedNodal(u32 m, Real dx, Type type)
+    : mole::Operator(m + 1, m + 1) {
+  MOLE_PROFILE_SCOPE("SidedNodal");
+  mole::check_spacing(dx, "dx");
+  assert(m > 1);
+
+  switch (type) {
+  case Type::Backward:
+    at(0, 0) = 1.0;
+    at(0, m - 1) = -1.0;
+    for (u32 i = 1; i <= m; ++i) {
+      at(i, i - 1) = -1.0;
+      at(i, i) = 1.0;
+    }
+    *this /= dx;
+    break;
+
+  case Type::Forward:
+    for (u32 i = 0; i < m; ++i) {
+      at(i, i) = -1.0;
+      at(i, i + 1) = 1.0;
+    }
+    at(m, 1) = 1.0;
+    at(m, m) = -1.0;
+    *this /= dx;
+    break;
+
+  case Type::Centered:
+    at(0, 1) = 1.0;
+    at(0, m - 1) = -1.0;
+    for (u32 i = 1; i < m; ++i) {
+      at(i, i - 1) = -1.0;
+      at(i, i + 1) = 1.0;
+    }
+    at(m, 1) = 1.0;
+    at(m, m - 1) = -1.0;
+    *this /= 2.0 * dx;
+    break;
+  }
+  MOLE_PROFILE_COUNT("nnz", n_nonzero);
+}
+
+void SidedNodal::applyStencil(Type type, Real dx, const vec &u, vec &out) {
+  mole::check_spacing(dx, "dx");
+  assert(u.n_elem > 2);
+  const uword m = u.n_elem - 1;
+  out.set_size(m + 1);
+  const Real *x = u.memptr();
+  Real *y = out.memptr();
+
+  switch (type) {
+  case Type::Backward: {
+    const Real s = 1.0 / dx;
+    y[0] = s * (x[0] - x[m - 1]);
+#pragma omp simd
+    for (uword i = 1; i <= m; ++i)
+      y[i] = s * (x[i] - x[i - 1]);
+    break;
+  }
+  case Type::Forward: {
+    const Real s = 1.0 / dx;
+#pragma omp simd
+    for (uword i = 0; i < m; ++i)
+      y[i] = s * (x[i + 1] - x[i]);
+    y[m] = s * (x[1] - x[m]);
+    break;
+  }
+  case Type::Centered: {
+    const Real s = 0.5 / dx;
+    y[0] = s * (x[1] - x[m - 1]);
+#pragma omp simd
+    for (uword i = 1; i < m; ++i)
+      y[i] = s * (x[i + 1] - x[i - 1]);
+    y[m] = s * (x[1] - x[m - 1]);
+    break;
+  }
+  }
+}
@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file sidedNodal.h
+ *
+ * @brief Sided first derivatives on periodic nodal grids
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef SIDEDNODAL_H
+#define SIDEDNODAL_H
+
+#include "utils.h"
+
+/**
+ * @brief One-dimensional sided approximation (sidedNodal)
+ *
+ * (m+1) x (m+1) operator on the nodes of m cells. The first and last
+ * nodes are the same periodic point, so the end rows wrap around to the
+ * other side of it. Handy for advective terms.
+ */
+class SidedNodal : public mole::Operator {
+public:
+  using sp_mat::operator=;
+
+  enum class Type { Backward, Forward, Centered };
+
+  /**
+   * @brief 1-D Sided Nodal Operator Constructor
+   *
+   * @param m    Number of cells
+   * @param dx   Step size
+   * @param type Backward, forward or centered differences
+   */
+  SidedNodal(u32 m, Real dx, Type type);
+
+  /**
+   * @brief out = S * u, without assembling S
+   *
+   * @param u Values at the m+1 nodes
+   */
+  static void applyStencil(Type type, Real dx, const vec &u, vec &out);
+};
+
+#endif // SIDEDNODAL_H
@@ -0,0 +1,227 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file snapshot.cpp
+ *
+ * @brief Asynchronous binary snapshot writer for simulation output
+ *
+ * @date 2026/10/19
+ */
+
+#include "snapshot.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace mole {
+
+namespace {
+
+bool hostIsLittleEndian() {
+  const std::uint16_t probe = 1;
+  unsigned char first;
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+// Bytes of the values in little-endian order, reversing each value on a
+// big-endian host
+std::vector<char> littleEndianBytes(const std::vector<Real> &values) {
+  std::vector<char> bytes(values.size() * sizeof(Real));
+  std::memcpy(bytes.data(), values.data(), bytes.size());
+  for (size_t i = 0; i < bytes.size(); i += sizeof(Real)) {
+    std::reverse(bytes.begin() + i, bytes.begin() + i + sizeof(Real));
+  }
+  return bytes;
+}
+
+void writeShape(std::ostream &out, const std::vector<uword> &shape) {
+  out << '[';
+  for (size_t i = 0; i < shape.size(); ++i) {
+    out << (i ? ", " : "") << shape[i];
+  }
+  out << ']';
+}
+
+} // anonymous namespace
+
+SnapshotWriter::SnapshotWriter(const std::string &directory,
+                               const std::string &prefix)
+    : directory(directory), prefix(prefix) {
+  if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+    throw std::runtime_error("MOLE: cannot create snapshot directory " +
+                             directory + ": " + std::strerror(errno));
+  }
+  worker = std::thread(&SnapshotWriter::run, this);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  ready.notify_one();
+  worker.join();
+
+  try {
+    writeSeries();
+  } catch (...) {
+    // Destructors must not throw; the per-frame files are already on disk.
+  }
+}
+
+void SnapshotWriter::write(const vec &field, Real time,
+                           const std::vector<uword> &shape) {
+  submit(field.memptr(), field.n_elem, time, shape);
+}
+
+void SnapshotWriter::write(const mat &field, Real time) {
+  submit(field.memptr(), field.n_elem, time, {field.n_rows, field.n_cols});
+}
+
+void SnapshotWriter::write(const cube &field, Real time) {
+  submit(field.memptr(), field.n_elem, time,
+         {field.n_rows, field.n_cols, field.n_slices});
+}
+
+void SnapshotWriter::flush() {
+  std::unique_lock<std::mutex> guard(lock);
+  drained.wait(guard, [this] { return !pending && !busy; });
+  rethrow();
+  writeSeries();
+}
+
+uword SnapshotWriter::frames() const {
+  std::lock_guard<std::mutex> guard(lock);
+  return next_index;
+}
+
+// Copies the caller's data into the staging buffer. Only waits when the
+// previous frame has not yet been picked up by the worker.
+void SnapshotWriter::submit(const Real *data, uword n_elem, Real time,
+                            const std::vector<uword> &shape) {
+  std::unique_lock<std::mutex> guard(lock);
+  drained.wait(guard, [this] { return !pending || !error.empty(); });
+  rethrow();
+
+  staging.data.assign(data, data + n_elem);
+  staging.shape = shape.empty() ? std::vector<uword>{n_elem} : shape;
+  staging.time = time;
+  staging.index = next_index++;
+  times.push_back(time);
+  pending = true;
+
+  guard.unlock();
+  ready.notify_one();
+}
+
+// Worker loop: swap the staging buffer into flight, release the lock and
+// write it out. Swapping keeps both buffers' capacity alive across frames.
+void SnapshotWriter::run() {
+  for (;;) {
+    std::unique_lock<std::mutex> guard(lock);
+    ready.wait(guard, [this] { return pending || stopping; });
+    if (!pending) {
+      break;
+    }
+
+    std::swap(staging, inflight);
+    pending = false;
+    busy = true;
+    guard.unlock();
+    drained.notify_all();
+
+    std::string failure;
+    try {
+      writeFrame(inflight);
+    } catch (const std::exception &e) {
+      failure = e.what();
+    }
+
+    guard.lock();
+    busy = false;
+    if (!failure.empty() && error.empty()) {
+      error = failure;
+    }
+    guard.unlock();
+    drained.notify_all();
+  }
+}
+
+void SnapshotWriter::writeFrame(const Frame &frame) const {
+  const std::string base = frameName(frame.index);
+
+  std::ofstream raw(directory + "/" + base + ".bin", std::ios::binary);
+  const std::streamsize size =
+      static_cast<std::streamsize>(frame.data.size() * sizeof(Real));
+  if (hostIsLittleEndian()) {
+    raw.write(reinterpret_cast<const char *>(frame.data.data()), size);
+  } else {
+    raw.write(littleEndianBytes(frame.data).data(), size);
+  }
+  if (!raw) {
+    throw std::runtime_error("MOLE: failed to write snapshot " + base +
+                             ".bin");
+  }
+
+  std::ofstream meta(directory + "/" + base + ".json");
+  meta << std::setprecision(17);
+  meta << "{\n"
+       << "  \"format\": \"mole-snapshot\",\n"
+       << "  \"file\": \"" << base << ".bin\",\n"
+       << "  \"dtype\": \"float64\",\n"
+       << "  \"endian\": \"little\",\n"
+       << "  \"order\": \"column-major\",\n"
+       << "  \"shape\": ";
+  writeShape(meta, frame.shape);
+  meta << ",\n"
+       << "  \"time\": " << frame.time << ",\n"
+       << "  \"index\": " << frame.index << "\n"
+       << "}\n";
+  if (!meta) {
+    throw std::runtime_error("MOLE: failed to write snapshot " + base +
+                             ".json");
+  }
+}
+
+// Called with the lock held (or after the worker has been joined).
+void SnapshotWriter::writeSeries() const {
+  std::ofstream out(directory + "/" + prefix + ".series.json");
+  out << std::setprecision(17);
+  out << "{\n  \"prefix\": \"" << prefix << "\",\n  \"frames\": [";
+  for (uword i = 0; i < times.size(); ++i) {
+    out << (i ? ",\n" : "\n") << "    {\"index\": " << i << ", \"time\": "
+        << times[i] << ", \"file\": \"" << frameName(i) << ".bin\"}";
+  }
+  out << "\n  ]\n}\n";
+  if (!out) {
+    throw std::runtime_error("MOLE: failed to write snapshot series index");
+  }
+}
+
+std::string SnapshotWriter::frameName(uword index) const {
+  std::ostringstream name;
+  name << prefix << '_' << std::setw(5) << std::setfill('0') << index;
+  return name.str();
+}
+
+// Called with the lock held; surfaces a worker-side failure exactly once.
+void SnapshotWriter::rethrow() {
+  if (!error.empty()) {
+    std::string message = error;
+    error.clear();
+    throw std::runtime_error(message);
+  }
+}
+
+} // namespace mole
@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file snapshot.h
+ *
+ * @brief Asynchronous binary snapshot writer for simulation output
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "utils.h"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mole {
+
+/**
+ * @brief Double-buffered snapshot writer backed by a background I/O thread
+ *
+ * Each call to write() copies the field into a staging buffer and returns
+ * immediately; a worker thread drains the buffer to disk while the time loop
+ * keeps running. At most one frame is queued behind the one being written,
+ * so write() only blocks when frames are produced faster than the disk can
+ * absorb them.
+ *
+ * Every frame produces two files in the output directory:
+ *  - <prefix>_<index>.bin  : raw little-endian float64 values, column-major
+ *                            (byte-swapped on big-endian hosts)
+ *  - <prefix>_<index>.json : sidecar with shape, time, dtype and byte order
+ *
+ * A <prefix>.series.json index listing every frame is rewritten by flush()
+ * and by the destructor.
+ *
+ * @note I/O errors raised on the worker thread are rethrown as
+ *       std::runtime_error from the next write() or flush().
+ */
+class SnapshotWriter {
+public:
+  /**
+   * @brief Starts the writer thread
+   *
+   * @param directory Output directory (created if it does not exist)
+   * @param prefix    File name prefix for every frame
+   */
+  explicit SnapshotWriter(const std::string &directory,
+                          const std::string &prefix = "frame");
+
+  /**
+   * @brief Drains pending frames, writes the series index and joins
+   */
+  ~SnapshotWriter();
+
+  SnapshotWriter(const SnapshotWriter &) = delete;
+  SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+  /**
+   * @brief Hands off a flat field
+   *
+   * @param field Field values (copied before returning)
+   * @param time  Simulation time stored in the sidecar
+   * @param shape Logical shape recorded in the sidecar, e.g. {m+2, n+2}.
+   *              Defaults to {field.n_elem}.
+   */
+  void write(const vec &field, Real time,
+             const std::vector<uword> &shape = std::vector<uword>());
+
+  /**
+   * @brief Hands off a 2-D field; the shape is {n_rows, n_cols}
+   */
+  void write(const mat &field, Real time);
+
+  /**
+   * @brief Hands off a 3-D field; the shape is {n_rows, n_cols, n_slices}
+   */
+  void write(const cube &field, Real time);
+
+  /**
+   * @brief Blocks until every handed-off frame is on disk
+   */
+  void flush();
+
+  /**
+   * @brief Number of frames handed off so far
+   */
+  uword frames() const;
+
+private:
+  struct Frame {
+    std::vector<Real> data;
+    std::vector<uword> shape;
+    Real time = 0.0;
+    uword index = 0;
+  };
+
+  std::string directory;
+  std::string prefix;
+
+  Frame staging;  // filled by the caller
+  Frame inflight; // drained by the worker
+  bool pending = false;
+  bool busy = false;
+  bool stopping = false;
+  uword next_index = 0;
+  std::vector<Real> times;
+  std::string error;
+
+  mutable std::mutex lock;
+  std::condition_variable ready;
+  std::condition_variable drained;
+  std::thread worker;
+
+  void submit(const Real *data, uword n_elem, Real time,
+              const std::vector<uword> &shape);
+  void run();
+  void writeFrame(const Frame &frame) const;
+  void writeSeries() const;
+  std::string frameName(uword index) const;
+  void rethrow();
+};
+
+} // namespace mole
+
+#endif // SNAPSHOT_H
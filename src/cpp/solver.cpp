@@ -0,0 +1,61 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file solver.cpp
+ *
+ * @brief Direct solver with a cached factorization
+ *
+ * @date 2026/10/19
+ */
+
+#include "solver.h"
+#include <stdexcept>
+#include <string>
+
+namespace mole {
+
+LinearSolver::LinearSolver(const sp_mat &A) : n(A.n_rows) {
+  MOLE_PROFILE_SCOPE("LinearSolver factorization");
+  MOLE_PROFILE_COUNT("nnz", A.n_nonzero);
+  if (A.n_rows != A.n_cols || A.n_rows == 0)
+    throw std::invalid_argument("MOLE: LinearSolver needs a square operator");
+  if (!factor.factorise(A))
+    throw std::runtime_error("MOLE: LinearSolver could not factorize the "
+                             "operator; it may be singular");
+}
+
+void LinearSolver::solve(mat &X, const mat &B) const {
+  MOLE_PROFILE_SCOPE("LinearSolver::solve");
+  if (B.n_rows != n)
+    throw std::invalid_argument("MOLE: expected right-hand sides with " +
+                                std::to_string(n) + " rows");
+  if (!factor.solve(X, B))
+    throw std::runtime_error("MOLE: LinearSolver solve failed");
+}
+
+void LinearSolver::solve(vec &x, const vec &b) const {
+  MOLE_PROFILE_SCOPE("LinearSolver::solve");
+  if (b.n_elem != n)
+    throw std::invalid_argument("MOLE: expected a vector of length " +
+                                std::to_string(n));
+  if (!factor.solve(x, b))
+    throw std::runtime_error("MOLE: LinearSolver solve failed");
+}
+
+vec LinearSolver::solve(const vec &b) const {
+  vec x;
+  solve(x, b);
+  return x;
+}
+
+mat LinearSolver::solve(const mat &B) const {
+  mat X;
+  solve(X, B);
+  return X;
+}
+
+} // namespace mole
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file solver.h
+ *
+ * @brief Direct solver with a cached factorization
+ *
+ * spsolve() factorizes A on every call. Ensembles and parameter sweeps
+ * solve the same system for many right-hand sides, so LinearSolver
+ * factorizes once and then only runs the triangular solves, for one vector
+ * or for all columns of a batch at once.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "utils.h"
+
+namespace mole {
+
+/**
+ * @brief LU factorization of a square operator, reused by every solve
+ *
+ * @code
+ *   mole::LinearSolver solver(A);  // A with its boundary rows
+ *   mat U = solver.solve(B);       // one column per ensemble member
+ * @endcode
+ *
+ * SuperLU keeps work arrays in the factorization that every solve writes
+ * to, so the solves are const only in effect: one LinearSolver must not be
+ * used from two threads at once. Give each thread its own solver, or
+ * solve all right-hand sides in one batched call.
+ */
+class LinearSolver {
+public:
+  /**
+   * @throws std::invalid_argument if A is not square
+   * @throws std::runtime_error if A cannot be factorized (singular)
+   */
+  explicit LinearSolver(const sp_mat &A);
+
+  LinearSolver(const LinearSolver &) = delete;
+  LinearSolver &operator=(const LinearSolver &) = delete;
+
+  uword size() const { return n; }
+
+  /**
+   * @brief Reciprocal condition number estimate of A
+   */
+  Real rcond() const { return factor.rcond(); }
+
+  /**
+   * @brief Solves A x = b
+   *
+   * @throws std::invalid_argument if b has not size() entries
+   * @throws std::runtime_error if the triangular solves fail
+   */
+  void solve(vec &x, const vec &b) const;
+  vec solve(const vec &b) const;
+
+  /**
+   * @brief Solves A X = B for all columns of B in one pass
+   */
+  void solve(mat &X, const mat &B) const;
+  mat solve(const mat &B) const;
+
+private:
+  uword n;
+  mutable spsolve_factoriser factor; // solve() is non-const in Armadillo
+};
+
+} // namespace mole
+
+#endif // SOLVER_H
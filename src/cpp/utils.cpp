@@ -16,6 +16,10 @@
  */
 
 #include "utils.h"
+#include "footprint.h"
+#include "meshgrid.h"
+#include "quadrature.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
@@ -25,6 +29,8 @@
 #include <eigen3/Eigen/SparseLU>
 
 vec Utils::spsolve_eigen(const sp_mat &A, const vec &b) {
+  MOLE_PROFILE_SCOPE("spsolve_eigen");
+  MOLE_PROFILE_COUNT("nnz", A.n_nonzero);
   Eigen::SparseMatrix<Real> eigen_A(A.n_rows, A.n_cols);
   std::vector<Eigen::Triplet<Real>> triplets;
   Eigen::SparseLU<Eigen::SparseMatrix<Real>, Eigen::COLAMDOrdering<int>> solver;
@@ -71,6 +77,7 @@ sp_mat Utils::spkron(const sp_mat &A, const sp_mat &B)
 */
 
 sp_mat Utils::spkron(const sp_mat &A, const sp_mat &B) {
+  MOLE_PROFILE_SCOPE("spkron");
   sp_mat::const_iterator itA = A.begin();
   sp_mat::const_iterator endA = A.end();
   sp_mat::const_iterator itB = B.begin();
@@ -82,6 +89,7 @@ sp_mat Utils::spkron(const sp_mat &A, const sp_mat &B) {
 
   umat locations(2, a.n_elem * b.n_elem);
   vec values(a.n_elem * b.n_elem);
+  mole::memory::Temporary triplets(mole::memory::tripletBytes(values.n_elem));
 
   while (itA != endA) {
     while (itB != endB) {
@@ -98,12 +106,15 @@ sp_mat Utils::spkron(const sp_mat &A, const sp_mat &B) {
 
   sp_mat result(locations, values, A.n_rows * B.n_rows, A.n_cols * B.n_cols,
                 true);
+  MOLE_PROFILE_COUNT("nnz", result.n_nonzero);
+  MOLE_PROFILE_COUNT("bytes", values.n_elem * (sizeof(Real) + 2 * sizeof(uword)));
 
   return result;
 }
 
 
 sp_mat Utils::spjoin_rows(const sp_mat &A, const sp_mat &B) {
+  MOLE_PROFILE_SCOPE("spjoin_rows");
   sp_mat::const_iterator itA = A.begin();
   sp_mat::const_iterator endA = A.end();
   sp_mat::const_iterator itB = B.begin();
@@ -115,6 +126,7 @@ sp_mat Utils::spjoin_rows(const sp_mat &A, const sp_mat &B) {
 
   umat locations(2, a.n_elem + b.n_elem);
   vec values(a.n_elem + b.n_elem);
+  mole::memory::Temporary triplets(mole::memory::tripletBytes(values.n_elem));
 
   while (itA != endA) {
     locations(0, j) = itA.row();
@@ -139,6 +151,7 @@ sp_mat Utils::spjoin_rows(const sp_mat &A, const sp_mat &B) {
 
 
 sp_mat Utils::spjoin_cols(const sp_mat &A, const sp_mat &B) {
+  MOLE_PROFILE_SCOPE("spjoin_cols");
   sp_mat::const_iterator itA = A.begin();
   sp_mat::const_iterator endA = A.end();
   sp_mat::const_iterator itB = B.begin();
@@ -150,6 +163,7 @@ sp_mat Utils::spjoin_cols(const sp_mat &A, const sp_mat &B) {
 
   umat locations(2, a.n_elem + b.n_elem);
   vec values(a.n_elem + b.n_elem);
+  mole::memory::Temporary triplets(mole::memory::tripletBytes(values.n_elem));
 
   while (itA != endA) {
     locations(0, j) = itA.row();
@@ -174,77 +188,35 @@ sp_mat Utils::spjoin_cols(const sp_mat &A, const sp_mat &B) {
 
 
 void Utils::meshgrid(const vec &x, const vec &y, mat &X, mat &Y) {
-  int m = x.n_elem;
-  int n = y.n_elem;
-
-  assert(m > 0);
-  assert(n > 0);
-
-  // Build X
-  vec t(n, fill::ones);
-
-  X.zeros(n, m);
-  Y.zeros(n, m);
-
-  for (int ii = 0; ii < m; ++ii) {
-    X.col(ii) = x(ii) * t;
-    t.ones();
-  }
-
-  for (int ii = 0; ii < m; ++ii)
-    Y.col(ii) = y;
+  assert(x.n_elem > 0);
+  assert(y.n_elem > 0);
+
+  // Filled in parallel from the ticks; see mole::MeshGrid for grids that
+  // never need the dense copies
+  const mole::MeshGrid grid(x, y);
+  grid.X().copyTo(X);
+  grid.Y().copyTo(Y);
 }
 
 
 void Utils::meshgrid(const vec &x, const vec &y, const vec &z, cube &X, cube &Y,
                      cube &Z) {
-  int m = x.n_elem;
-  int n = y.n_elem;
-  int o = z.n_elem;
-
-  assert(m > 0);
-  assert(n > 0);
-  assert(o > 0);
-
-  // Temporary Holder of sheet of cube
-  mat sheet(m, n, fill::zeros);
-
-  // Build X
-  vec t(n, fill::ones);
-
-  X.zeros(m, n, o);
-  Y.zeros(m, n, o);
-  Z.zeros(m, n, o);
-
-  // Sheet that repeats each slice
-  for (int ii = 0; ii < m; ++ii) {
-    sheet.row(ii) = x(ii) * t.t();
-    t.ones();
-  }
-
-  for (int kk = 0; kk < o; ++kk)
-    X.slice(kk) = sheet;
-
-  // Y Cube, repeats same sheet as well
-  for (int ii = 0; ii < m; ++ii)
-    sheet.row(ii) = y.t();
-
-  for (int kk = 0; kk < o; ++kk)
-    Y.slice(kk) = sheet;
-
-  // Z cube goes by slices each with same value
-  for (int kk = 0; kk < o; ++kk)
-    Z.slice(kk).fill(z(kk));
+  assert(x.n_elem > 0);
+  assert(y.n_elem > 0);
+  assert(z.n_elem > 0);
+
+  const mole::MeshGrid grid(x, y, z);
+  grid.X().copyTo(X);
+  grid.Y().copyTo(Y);
+  grid.Z().copyTo(Z);
 }
 
 // Trapezoidal rule (trapz) for 1D integration
 double Utils::trapz(const vec &x, const vec &y) {
   assert(x.n_elem == y.n_elem);
-  double sum = 0.0;
-  for (uword i = 0; i < x.n_elem - 1; ++i) {
-    sum += (x(i+1) - x(i)) * (y(i) + y(i+1));
-  }
-  return 0.5 * sum;
+  if (x.is_empty())
+    return 0.0;
+  return mole::Quadrature(x)(y);
 }
 
 // Spacing validation shared across every operator entry point.
@@ -256,3 +228,100 @@ void mole::check_spacing(Real h, const char* name) {
   }
 }
 
+void mole::apply(const sp_mat &A, const vec &in, vec &out) {
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  out.set_size(A.n_rows);
+  apply_add(A, 1.0, in, 0.0, out);
+}
+
+void mole::apply_add(const sp_mat &A, Real alpha, const vec &in, Real beta,
+                     vec &out) {
+  if (in.n_elem != A.n_cols || out.n_elem != A.n_rows)
+    throw std::invalid_argument(
+        "MOLE: operator is " + std::to_string(A.n_rows) + " x " +
+        std::to_string(A.n_cols) + ", got in of length " +
+        std::to_string(in.n_elem) + " and out of length " +
+        std::to_string(out.n_elem));
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply_add needs distinct in and out");
+
+  // Armadillo guards this with a lock when the element cache is dirty
+  A.sync();
+  const uword *ptr = A.col_ptrs;
+  const uword *row = A.row_indices;
+  const Real *val = A.values;
+  const Real *x = in.memptr();
+  Real *y = out.memptr();
+
+  if (beta == 0.0)
+    std::fill(y, y + A.n_rows, 0.0);
+  else if (beta != 1.0)
+    for (uword r = 0; r < A.n_rows; ++r)
+      y[r] *= beta;
+  if (alpha == 0.0)
+    return;
+
+  for (uword c = 0; c < A.n_cols; ++c) {
+    const Real xc = alpha * x[c];
+    for (uword p = ptr[c]; p < ptr[c + 1]; ++p)
+      y[row[p]] += val[p] * xc;
+  }
+}
+
+void mole::apply(const sp_mat &A, const mat &in, mat &out) {
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply needs distinct in and out");
+  out.set_size(A.n_rows, in.n_cols);
+  apply_add(A, 1.0, in, 0.0, out);
+}
+
+void mole::apply_add(const sp_mat &A, Real alpha, const mat &in, Real beta,
+                     mat &out) {
+  MOLE_PROFILE_SCOPE("apply_add batch");
+  if (in.n_rows != A.n_cols || out.n_rows != A.n_rows ||
+      out.n_cols != in.n_cols)
+    throw std::invalid_argument(
+        "MOLE: operator is " + std::to_string(A.n_rows) + " x " +
+        std::to_string(A.n_cols) + ", got in of " +
+        std::to_string(in.n_rows) + " x " + std::to_string(in.n_cols) +
+        " and out of " + std::to_string(out.n_rows) + " x " +
+        std::to_string(out.n_cols));
+  if (&in == &out)
+    throw std::invalid_argument("MOLE: apply_add needs distinct in and out");
+
+  A.sync();
+  const uword *ptr = A.col_ptrs;
+  const uword *row = A.row_indices;
+  const Real *val = A.values;
+  const uword rows = A.n_rows, cols = A.n_cols;
+  const uword blocks = (in.n_cols + rhsBlock - 1) / rhsBlock;
+
+#pragma omp parallel for schedule(static) if (blocks > 1)
+  for (uword b = 0; b < blocks; ++b) {
+    const uword first = b * rhsBlock;
+    const uword count = std::min(rhsBlock, in.n_cols - first);
+    const Real *x = in.colptr(first);
+    Real *y = out.colptr(first);
+
+    if (beta == 0.0)
+      std::fill(y, y + count * rows, 0.0);
+    else if (beta != 1.0)
+      for (uword i = 0; i < count * rows; ++i)
+        y[i] *= beta;
+    if (alpha == 0.0)
+      continue;
+
+    // One pass over A for the whole block
+    Real xc[rhsBlock];
+    for (uword c = 0; c < cols; ++c) {
+      for (uword j = 0; j < count; ++j)
+        xc[j] = alpha * x[j * cols + c];
+      for (uword p = ptr[c]; p < ptr[c + 1]; ++p) {
+        Real *yr = y + row[p];
+        for (uword j = 0; j < count; ++j)
+          yr[j * rows] += val[p] * xc[j];
+      }
+    }
+  }
+}
@@ -17,6 +17,7 @@
 #define UTILS_H
 
 #include <armadillo>
+#include "profiler.h"
 
 using Real = double;
 using namespace arma;
@@ -100,6 +101,8 @@ public:
   * @param Y a sparse matrix, will be filled by the function
   * @param Z a sparse matrix, will be filled by the function
   *
+  * @note To evaluate a field once, mole::MeshGrid and mole::evaluate avoid
+  * the three dense cubes
   */
   void meshgrid(const vec &x, const vec &y, const vec &z, cube &X, cube &Y,
                 cube &Z);
@@ -111,7 +114,11 @@ public:
   *
   * @param x Vector of x-coordinates
   * @param y Vector of y-values at corresponding x
-  * @return Estimated area under the curve
+  * @return Estimated area under the curve, 0 for empty input as in
+  *         MATLAB's trapz
+  *
+  * @note Sums with mole::Quadrature; build one of those to integrate 2-D
+  * and 3-D fields, or the same grid every step
   */
   static double trapz(const vec &x, const vec &y);
 };
@@ -133,6 +140,69 @@ namespace mole {
  */
 void check_spacing(Real h, const char* name);
 
+/**
+ * @brief out = A * in, into a caller-owned buffer.
+ *
+ * Reads A in place (operators are not copied to an sp_mat first) and
+ * allocates only if out does not have A.n_rows entries yet. Several
+ * threads may apply the same operator at once, each with its own out.
+ * Operator exposes this and the forms below as members.
+ *
+ * @throws std::invalid_argument if in has not A.n_cols entries, or if in
+ *         and out are the same vector.
+ */
+void apply(const sp_mat &A, const vec &in, vec &out);
+
+/**
+ * @brief out = alpha * A * in + beta * out, without temporaries.
+ *
+ * As in BLAS, beta = 0 overwrites out, so it may hold garbage (NaN).
+ *
+ * @throws std::invalid_argument if in or out has the wrong size, or if
+ *         they are the same vector.
+ */
+void apply_add(const sp_mat &A, Real alpha, const vec &in, Real beta,
+               vec &out);
+
+/**
+ * @brief Columns of a batch that share one pass over the matrix
+ */
+constexpr uword rhsBlock = 8;
+
+/**
+ * @brief Batched apply: every column of in is one input vector.
+ *
+ * The columns are taken in blocks of rhsBlock, and each block streams A
+ * once instead of once per column. Blocks are split over the OpenMP
+ * threads.
+ *
+ * @throws std::invalid_argument as for the vector form.
+ */
+void apply(const sp_mat &A, const mat &in, mat &out);
+void apply_add(const sp_mat &A, Real alpha, const mat &in, Real beta,
+               mat &out);
+
+/**
+ * @brief Base of the operator classes (Gradient, Divergence, BCs, ...)
+ *
+ * An sp_mat with apply() and apply_add() as members, for a single vector
+ * or a batch; they forward to the free functions above.
+ */
+class Operator : public sp_mat {
+public:
+  using sp_mat::sp_mat;
+  using sp_mat::operator=;
+
+  void apply(const vec &in, vec &out) const { mole::apply(*this, in, out); }
+  void apply_add(Real alpha, const vec &in, Real beta, vec &out) const {
+    mole::apply_add(*this, alpha, in, beta, out);
+  }
+  void apply(const mat &in, mat &out) const { mole::apply(*this, in, out); }
+  void apply_add(Real alpha, const mat &in, Real beta, mat &out) const {
+    mole::apply_add(*this, alpha, in, beta, out);
+  }
+};
+
 } // namespace mole
 
 #endif // UTILS_H
@@ -0,0 +1,325 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file vtkwriter.cpp
+ *
+ * @brief VTK and XDMF output for staggered mimetic fields
+ *
+ * @date 2026/10/19
+ */
+
+#include "vtkwriter.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace mole {
+
+namespace {
+
+bool hostIsLittleEndian() {
+  const std::uint16_t probe = 1;
+  unsigned char first;
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+}
+
+// File name without its directory, for references inside .vtm/.xmf files.
+std::string leafName(const std::string &path) {
+  const size_t slash = path.find_last_of('/');
+  return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+void openOrThrow(std::ofstream &out, const std::string &path,
+                 std::ios::openmode mode = std::ios::out) {
+  out.open(path, mode);
+  if (!out) {
+    throw std::runtime_error("MOLE: cannot open " + path + " for writing");
+  }
+}
+
+void appendBlock(std::ofstream &out, const Real *data, uword n) {
+  const std::uint64_t bytes = n * sizeof(Real);
+  out.write(reinterpret_cast<const char *>(&bytes), sizeof(bytes));
+  out.write(reinterpret_cast<const char *>(data),
+            static_cast<std::streamsize>(bytes));
+}
+
+} // anonymous namespace
+
+VTKWriter::VTKWriter(u32 m, u32 n, Real dx, Real dy)
+    : dim(2), cells{m, n, 0}, spacing{dx, dy, 1.0}, origin{0.0, 0.0, 0.0} {
+  check_spacing(dx, "dx");
+  check_spacing(dy, "dy");
+}
+
+VTKWriter::VTKWriter(u32 m, u32 n, u32 o, Real dx, Real dy, Real dz)
+    : dim(3), cells{m, n, o}, spacing{dx, dy, dz}, origin{0.0, 0.0, 0.0} {
+  check_spacing(dx, "dx");
+  check_spacing(dy, "dy");
+  check_spacing(dz, "dz");
+}
+
+void VTKWriter::setOrigin(Real x0, Real y0, Real z0) {
+  origin[0] = x0;
+  origin[1] = y0;
+  origin[2] = (dim == 3) ? z0 : 0.0;
+}
+
+void VTKWriter::addField(const std::string &name, const vec &field,
+                         FieldLocation location) {
+  if (field.n_elem != expectedSize(location)) {
+    throw std::invalid_argument("MOLE: field '" + name + "' has " +
+                                std::to_string(field.n_elem) +
+                                " entries, expected " +
+                                std::to_string(expectedSize(location)));
+  }
+  fields.push_back({name, location, field});
+}
+
+void VTKWriter::clear() { fields.clear(); }
+
+uword VTKWriter::expectedSize(FieldLocation location) const {
+  const uword m = cells[0], n = cells[1], o = (dim == 3) ? cells[2] : 0;
+  switch (location) {
+  case FieldLocation::Cells:
+    return (dim == 2) ? (m + 2) * (n + 2) : (m + 2) * (n + 2) * (o + 2);
+  case FieldLocation::Nodes:
+    return (dim == 2) ? (m + 1) * (n + 1) : (m + 1) * (n + 1) * (o + 1);
+  case FieldLocation::Faces:
+    return (dim == 2) ? 2 * m * n + m + n
+                      : 3 * m * n * o + m * n + m * o + n * o;
+  }
+  return 0;
+}
+
+// Cell centers plus the two boundary points: x0, x0+dx/2, ..., x0+m*dx.
+vec VTKWriter::cellTicks(u32 axis) const {
+  const u32 c = cells[axis];
+  vec t(c + 2);
+  t(0) = origin[axis];
+  for (u32 i = 0; i < c; ++i)
+    t(i + 1) = origin[axis] + (i + 0.5) * spacing[axis];
+  t(c + 1) = origin[axis] + c * spacing[axis];
+  return t;
+}
+
+// Cell faces / nodes: x0, x0+dx, ..., x0+m*dx.
+vec VTKWriter::nodeTicks(u32 axis) const {
+  const u32 c = cells[axis];
+  vec t(c + 1);
+  for (u32 i = 0; i <= c; ++i)
+    t(i) = origin[axis] + i * spacing[axis];
+  return t;
+}
+
+// Interior cell centers only, the tangential positions of face values.
+vec VTKWriter::centerTicks(u32 axis) const {
+  const u32 c = cells[axis];
+  vec t(c);
+  for (u32 i = 0; i < c; ++i)
+    t(i) = origin[axis] + (i + 0.5) * spacing[axis];
+  return t;
+}
+
+uword VTKWriter::Block::points() const {
+  return ticks[0].n_elem * ticks[1].n_elem * ticks[2].n_elem;
+}
+
+// Groups the fields into one block per staggered location. Face fields are
+// split into their x, y[, z] components, each on its own grid.
+std::vector<VTKWriter::Block> VTKWriter::blocks() const {
+  const vec flat = {origin[2]};
+
+  Block cellBlock, nodeBlock, faceBlock[3];
+  cellBlock.suffix = "cells";
+  nodeBlock.suffix = "nodes";
+  const char *faceSuffix[3] = {"faces_x", "faces_y", "faces_z"};
+  for (u32 a = 0; a < 3; ++a) {
+    cellBlock.ticks[a] = (a < dim) ? cellTicks(a) : flat;
+    nodeBlock.ticks[a] = (a < dim) ? nodeTicks(a) : flat;
+    faceBlock[a].suffix = faceSuffix[a];
+    for (u32 b = 0; b < 3; ++b) {
+      if (b >= dim)
+        faceBlock[a].ticks[b] = flat;
+      else
+        faceBlock[a].ticks[b] = (a == b) ? nodeTicks(b) : centerTicks(b);
+    }
+  }
+
+  for (const Field &f : fields) {
+    switch (f.location) {
+    case FieldLocation::Cells:
+      cellBlock.names.push_back(f.name);
+      cellBlock.arrays.push_back(f.data.memptr());
+      break;
+    case FieldLocation::Nodes:
+      nodeBlock.names.push_back(f.name);
+      nodeBlock.arrays.push_back(f.data.memptr());
+      break;
+    case FieldLocation::Faces: {
+      uword offset = 0;
+      for (u32 a = 0; a < dim; ++a) {
+        faceBlock[a].names.push_back(f.name);
+        faceBlock[a].arrays.push_back(f.data.memptr() + offset);
+        offset += faceBlock[a].points();
+      }
+      break;
+    }
+    }
+  }
+
+  std::vector<Block> out;
+  if (!cellBlock.names.empty())
+    out.push_back(cellBlock);
+  if (!nodeBlock.names.empty())
+    out.push_back(nodeBlock);
+  for (u32 a = 0; a < dim; ++a) {
+    if (!faceBlock[a].names.empty())
+      out.push_back(faceBlock[a]);
+  }
+  return out;
+}
+
+void VTKWriter::writeVTK(const std::string &basename) const {
+  const std::vector<Block> parts = blocks();
+  const char *byteOrder = hostIsLittleEndian() ? "LittleEndian" : "BigEndian";
+
+  for (const Block &b : parts) {
+    const std::string path = basename + "_" + b.suffix + ".vtr";
+    std::ofstream out;
+    openOrThrow(out, path, std::ios::out | std::ios::binary);
+
+    std::ostringstream extent;
+    extent << "0 " << b.ticks[0].n_elem - 1 << " 0 " << b.ticks[1].n_elem - 1
+           << " 0 " << b.ticks[2].n_elem - 1;
+
+    // Appended layout: every array, then the x, y, z ticks, each preceded
+    // by a UInt64 byte count.
+    std::uint64_t offset = 0;
+    const std::uint64_t header = sizeof(std::uint64_t);
+
+    out << "<?xml version=\"1.0\"?>\n"
+        << "<VTKFile type=\"RectilinearGrid\" version=\"1.0\" byte_order=\""
+        << byteOrder << "\" header_type=\"UInt64\">\n"
+        << "  <RectilinearGrid WholeExtent=\"" << extent.str() << "\">\n"
+        << "    <Piece Extent=\"" << extent.str() << "\">\n"
+        << "      <PointData Scalars=\"" << b.names[0] << "\">\n";
+    for (size_t f = 0; f < b.names.size(); ++f) {
+      out << "        <DataArray type=\"Float64\" Name=\"" << b.names[f]
+          << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+      offset += header + b.points() * sizeof(Real);
+    }
+    out << "      </PointData>\n"
+        << "      <Coordinates>\n";
+    const char *axisName[3] = {"x", "y", "z"};
+    for (u32 a = 0; a < 3; ++a) {
+      out << "        <DataArray type=\"Float64\" Name=\"" << axisName[a]
+          << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+      offset += header + b.ticks[a].n_elem * sizeof(Real);
+    }
+    out << "      </Coordinates>\n"
+        << "    </Piece>\n"
+        << "  </RectilinearGrid>\n"
+        << "  <AppendedData encoding=\"raw\">\n_";
+    for (const Real *array : b.arrays)
+      appendBlock(out, array, b.points());
+    for (u32 a = 0; a < 3; ++a)
+      appendBlock(out, b.ticks[a].memptr(), b.ticks[a].n_elem);
+    out << "\n  </AppendedData>\n</VTKFile>\n";
+
+    if (!out) {
+      throw std::runtime_error("MOLE: failed to write " + path);
+    }
+  }
+
+  const std::string path = basename + ".vtm";
+  std::ofstream out;
+  openOrThrow(out, path);
+  out << "<?xml version=\"1.0\"?>\n"
+      << "<VTKFile type=\"vtkMultiBlockDataSet\" version=\"1.0\">\n"
+      << "  <vtkMultiBlockDataSet>\n";
+  for (size_t i = 0; i < parts.size(); ++i) {
+    out << "    <DataSet index=\"" << i << "\" name=\"" << parts[i].suffix
+        << "\" file=\"" << leafName(basename) << "_" << parts[i].suffix
+        << ".vtr\"/>\n";
+  }
+  out << "  </vtkMultiBlockDataSet>\n</VTKFile>\n";
+  if (!out) {
+    throw std::runtime_error("MOLE: failed to write " + path);
+  }
+}
+
+void VTKWriter::writeXDMF(const std::string &basename, Real time) const {
+  const std::vector<Block> parts = blocks();
+  const char *endian = hostIsLittleEndian() ? "Little" : "Big";
+
+  const std::string path = basename + ".xmf";
+  std::ofstream xmf;
+  openOrThrow(xmf, path);
+  xmf << std::setprecision(17);
+  xmf << "<?xml version=\"1.0\" ?>\n"
+      << "<Xdmf Version=\"2.0\">\n"
+      << "  <Domain>\n"
+      << "    <Grid Name=\"mole\" GridType=\"Collection\" "
+         "CollectionType=\"Spatial\">\n"
+      << "      <Time Value=\"" << time << "\"/>\n";
+
+  for (const Block &b : parts) {
+    // XDMF lists dimensions slowest first.
+    std::ostringstream dims;
+    if (dim == 3)
+      dims << b.ticks[2].n_elem << ' ';
+    dims << b.ticks[1].n_elem << ' ' << b.ticks[0].n_elem;
+
+    xmf << "      <Grid Name=\"" << b.suffix << "\" GridType=\"Uniform\">\n"
+        << "        <Topology TopologyType=\"" << dim
+        << "DRectMesh\" Dimensions=\"" << dims.str() << "\"/>\n"
+        << "        <Geometry GeometryType=\"" << (dim == 3 ? "VXVYVZ" : "VXVY")
+        << "\">\n";
+    for (u32 a = 0; a < dim; ++a) {
+      xmf << "          <DataItem Dimensions=\"" << b.ticks[a].n_elem
+          << "\" NumberType=\"Float\" Precision=\"8\" Format=\"XML\">";
+      for (uword i = 0; i < b.ticks[a].n_elem; ++i)
+        xmf << (i ? " " : "") << b.ticks[a](i);
+      xmf << "</DataItem>\n";
+    }
+    xmf << "        </Geometry>\n";
+
+    for (size_t f = 0; f < b.names.size(); ++f) {
+      const std::string raw = basename + "_" + b.suffix + "_" + b.names[f];
+      std::ofstream bin;
+      openOrThrow(bin, raw + ".bin", std::ios::out | std::ios::binary);
+      bin.write(reinterpret_cast<const char *>(b.arrays[f]),
+                static_cast<std::streamsize>(b.points() * sizeof(Real)));
+      if (!bin) {
+        throw std::runtime_error("MOLE: failed to write " + raw + ".bin");
+      }
+
+      xmf << "        <Attribute Name=\"" << b.names[f]
+          << "\" AttributeType=\"Scalar\" Center=\"Node\">\n"
+          << "          <DataItem Dimensions=\"" << dims.str()
+          << "\" NumberType=\"Float\" Precision=\"8\" Format=\"Binary\" "
+             "Endian=\""
+          << endian << "\">" << leafName(raw) << ".bin</DataItem>\n"
+          << "        </Attribute>\n";
+    }
+    xmf << "      </Grid>\n";
+  }
+
+  xmf << "    </Grid>\n"
+      << "  </Domain>\n"
+      << "</Xdmf>\n";
+  if (!xmf) {
+    throw std::runtime_error("MOLE: failed to write " + path);
+  }
+}
+
+} // namespace mole
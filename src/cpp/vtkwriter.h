@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file vtkwriter.h
+ *
+ * @brief VTK and XDMF output for staggered mimetic fields
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef VTKWRITER_H
+#define VTKWRITER_H
+
+#include "utils.h"
+#include <string>
+#include <vector>
+
+namespace mole {
+
+/**
+ * @brief Where a field lives on the staggered grid
+ *
+ * - Cells: cell centers plus boundary values, (m+2)(n+2)[(o+2)] entries, the
+ *          layout used by Laplacian, Divergence and the BC operators.
+ * - Faces: normal components on faces, stacked x, y[, z] as returned by
+ *          the non-periodic Gradient.
+ * - Nodes: cell corners, (m+1)(n+1)[(o+1)] entries, as returned by
+ *          InterpolCtoN.
+ */
+enum class FieldLocation { Cells, Faces, Nodes };
+
+/**
+ * @brief Writes mimetic fields on a uniform Cartesian grid to ParaView
+ *
+ * Every field is placed at its true staggered position. Each location (and
+ * each face component) becomes its own RectilinearGrid whose point data are
+ * the field values, so nothing is averaged or moved before plotting:
+ *  - writeVTK()  emits one binary-appended .vtr per block plus a .vtm
+ *                multiblock file that groups them.
+ *  - writeXDMF() emits raw float64 binaries plus one .xmf description.
+ *
+ * The point ordering of both formats is x fastest, then y, then z, which
+ * matches MOLE's vectorized field ordering, so no data are permuted.
+ */
+class VTKWriter {
+public:
+  /**
+   * @brief 2-D grid description
+   *
+   * @param m  Number of cells in x-direction
+   * @param n  Number of cells in y-direction
+   * @param dx Cell width in x-direction
+   * @param dy Cell width in y-direction
+   */
+  VTKWriter(u32 m, u32 n, Real dx, Real dy);
+
+  /**
+   * @brief 3-D grid description
+   *
+   * @param m  Number of cells in x-direction
+   * @param n  Number of cells in y-direction
+   * @param o  Number of cells in z-direction
+   * @param dx Cell width in x-direction
+   * @param dy Cell width in y-direction
+   * @param dz Cell width in z-direction
+   */
+  VTKWriter(u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Moves the grid so its west/south/front corner sits at (x0,y0,z0)
+   *
+   * The domain starts at the origin by default; z0 is ignored in 2-D.
+   */
+  void setOrigin(Real x0, Real y0, Real z0 = 0.0);
+
+  /**
+   * @brief Adds a field to the next write
+   *
+   * @param name     Array name shown in ParaView
+   * @param field    Field values in MOLE ordering (copied)
+   * @param location Staggered location of the values
+   *
+   * @throws std::invalid_argument if the length does not match the layout
+   */
+  void addField(const std::string &name, const vec &field,
+                FieldLocation location = FieldLocation::Cells);
+
+  /**
+   * @brief Removes every field, keeping the grid description
+   */
+  void clear();
+
+  /**
+   * @brief Writes <basename>_<block>.vtr files and <basename>.vtm
+   */
+  void writeVTK(const std::string &basename) const;
+
+  /**
+   * @brief Writes <basename>_<block>_<field>.bin files and <basename>.xmf
+   *
+   * @param basename Output path without extension
+   * @param time     Time value recorded in the XDMF grid
+   */
+  void writeXDMF(const std::string &basename, Real time = 0.0) const;
+
+private:
+  struct Field {
+    std::string name;
+    FieldLocation location;
+    vec data;
+  };
+
+  // One RectilinearGrid: a set of ticks and slices of field data on it.
+  struct Block {
+    std::string suffix;
+    vec ticks[3];
+    std::vector<std::string> names;
+    std::vector<const Real *> arrays;
+    uword points() const;
+  };
+
+  u32 dim;
+  u32 cells[3];
+  Real spacing[3];
+  Real origin[3];
+  std::vector<Field> fields;
+
+  uword expectedSize(FieldLocation location) const;
+  vec cellTicks(u32 axis) const;
+  vec nodeTicks(u32 axis) const;
+  vec centerTicks(u32 axis) const;
+  std::vector<Block> blocks() const;
+};
+
+} // namespace mole
+
+#endif // VTKWRITER_H
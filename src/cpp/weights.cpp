@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file weights.cpp
+ *
+ * @brief Mimetic quadrature weights and the inner products they induce
+ *
+ * @date 2026/10/19
+ */
+
+#include "weights.h"
+#include "divergence.h"
+#include "gradient.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace mole {
+
+namespace {
+
+// Solves A' w = [-1; 0; ...; 0; 1] for an operator A whose rows annihilate
+// constants. Then ones is the only left null vector of A', so the first
+// equation follows from the others and dropping it leaves a square,
+// nonsingular banded system.
+vec boundaryWeights(const sp_mat &A) {
+  const sp_mat At = A.t();
+  const sp_mat S = At.rows(1, At.n_rows - 1);
+  vec rhs(S.n_rows, fill::zeros);
+  rhs(S.n_rows - 1) = 1.0;
+
+  vec w;
+  if (!spsolve(w, S, rhs))
+    throw std::runtime_error("MOLE: could not solve for the mimetic weights");
+  return w;
+}
+
+// kron(c, b, a) of vectors, a varying fastest
+vec tensor(const vec &a, const vec &b, const vec &c = vec{1.0}) {
+  vec t(a.n_elem * b.n_elem * c.n_elem);
+  uword p = 0;
+  for (uword l = 0; l < c.n_elem; ++l)
+    for (uword j = 0; j < b.n_elem; ++j)
+      for (uword i = 0; i < a.n_elem; ++i)
+        t(p++) = c(l) * b(j) * a(i);
+  return t;
+}
+
+} // anonymous namespace
+
+vec weightsP(u16 k, u32 m, Real dx) {
+  MOLE_PROFILE_SCOPE("weightsP");
+  return boundaryWeights(Gradient(k, m, dx));
+}
+
+vec weightsP(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  const vec Pm = weightsP(k, m, dx), Pn = weightsP(k, n, dy);
+  return join_cols(tensor(Pm, vec(n, fill::ones)),
+                   tensor(vec(m, fill::ones), Pn));
+}
+
+vec weightsP(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  const vec Pm = weightsP(k, m, dx), Pn = weightsP(k, n, dy),
+            Po = weightsP(k, o, dz);
+  const vec Im(m, fill::ones), In(n, fill::ones), Io(o, fill::ones);
+  return join_cols(join_cols(tensor(Pm, In, Io), tensor(Im, Pn, Io)),
+                   tensor(Im, In, Po));
+}
+
+vec weightsQ(u16 k, u32 m, Real dx) {
+  MOLE_PROFILE_SCOPE("weightsQ");
+  const sp_mat D = Divergence(k, m, dx);
+  const vec q = boundaryWeights(D.rows(1, m));
+  vec Q(m + 2);
+  Q(0) = 1.0;
+  Q.subvec(1, m) = q;
+  Q(m + 1) = 1.0;
+  return Q;
+}
+
+vec weightsQ(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  return tensor(weightsQ(k, m, dx), weightsQ(k, n, dy));
+}
+
+vec weightsQ(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  return tensor(weightsQ(k, m, dx), weightsQ(k, n, dy), weightsQ(k, o, dz));
+}
+
+Real weightedDot(const vec &u, const vec &w, const vec &v) {
+  if (u.n_elem != w.n_elem || v.n_elem != w.n_elem)
+    throw std::invalid_argument("MOLE: u, w, and v must have the same length");
+  const Real *a = u.memptr(), *b = w.memptr(), *c = v.memptr();
+  const uword N = w.n_elem;
+  Real sum = 0.0;
+#pragma omp parallel for simd reduction(+ : sum) schedule(static)
+  for (uword i = 0; i < N; ++i)
+    sum += a[i] * b[i] * c[i];
+  return sum;
+}
+
+Real weightedNorm(const vec &u, const vec &w) {
+  return std::sqrt(weightedDot(u, w, u));
+}
+
+EnergyFunctional::EnergyFunctional(const sp_mat &A, const vec &w)
+    : byRows(A.t()), w(w) {
+  if (w.n_elem != A.n_rows)
+    throw std::invalid_argument("MOLE: expected " + std::to_string(A.n_rows) +
+                                " weights");
+}
+
+Real EnergyFunctional::operator()(const vec &u) const {
+  MOLE_PROFILE_SCOPE("EnergyFunctional");
+  if (u.n_elem != byRows.n_rows)
+    throw std::invalid_argument("MOLE: expected a vector of length " +
+                                std::to_string(byRows.n_rows));
+  const uword *ptr = byRows.col_ptrs;
+  const uword *col = byRows.row_indices;
+  const Real *val = byRows.values;
+  const Real *x = u.memptr();
+  const Real *weight = w.memptr();
+
+  Real energy = 0.0;
+#pragma omp parallel for reduction(+ : energy) schedule(static)
+  for (uword r = 0; r < byRows.n_cols; ++r) {
+    Real Au = 0.0;
+    for (uword p = ptr[r]; p < ptr[r + 1]; ++p)
+      Au += val[p] * x[col[p]];
+    energy += weight[r] * Au * Au;
+  }
+  return energy;
+}
+
+} // namespace mole
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file weights.h
+ *
+ * @brief Mimetic quadrature weights and the inner products they induce
+ *
+ * P weighs values on the faces and Q values on the centers, such that
+ * <D v, f>_Q + <v, G f>_P = [v f] on the boundary (weightsP.m, weightsQ.m).
+ * Gradient::getP() and Divergence::getQ() only return the weights for the
+ * smallest grid of each order; these functions compute them for any m.
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef WEIGHTS_H
+#define WEIGHTS_H
+
+#include "utils.h"
+
+namespace mole {
+
+/**
+ * @brief Face weights P of the non-periodic Gradient (weightsP, weightsP2D)
+ *
+ * Solves G' P = [-1; 0; ...; 0; 1]. The 2-D and 3-D weights repeat the
+ * 1-D weights of each axis over its face block, as weightsP2D.m does.
+ *
+ * @param k  Order of accuracy
+ * @param m  Number of cells in x-direction
+ * @param dx Step size in x-direction
+ * @return m+1 weights in 1-D, one per face of the Gradient layout otherwise
+ */
+vec weightsP(u16 k, u32 m, Real dx);
+vec weightsP(u16 k, u32 m, u32 n, Real dx, Real dy);
+vec weightsP(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+/**
+ * @brief Center weights Q of the non-periodic Divergence (weightsQ)
+ *
+ * Solves D(2:end-1, :)' q = [-1; 0; ...; 0; 1] and adds unit weights for
+ * the boundary centers. The 2-D and 3-D weights are tensor products of
+ * the 1-D weights, in place of the constant weightsQ2D.m returns.
+ *
+ * @return m+2 weights in 1-D, one per center (x fastest) otherwise
+ */
+vec weightsQ(u16 k, u32 m, Real dx);
+vec weightsQ(u16 k, u32 m, u32 n, Real dx, Real dy);
+vec weightsQ(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+/**
+ * @brief <u, W v> = sum_i u_i w_i v_i, without forming diag(w)
+ */
+Real weightedDot(const vec &u, const vec &w, const vec &v);
+
+/**
+ * @brief sqrt(<u, W u>)
+ */
+Real weightedNorm(const vec &u, const vec &w);
+
+/**
+ * @brief Energy functional <A u, W A u>, e.g. <G u, P G u>
+ *
+ * Keeps A by rows and evaluates every row of A u inside the reduction, so
+ * no vector the size of A u is allocated. Meant to be built once and
+ * evaluated every time step.
+ */
+class EnergyFunctional {
+public:
+  /**
+   * @param A Operator, e.g. a Gradient
+   * @param w Weights, one per row of A (e.g. weightsP)
+   */
+  EnergyFunctional(const sp_mat &A, const vec &w);
+
+  Real operator()(const vec &u) const;
+
+private:
+  sp_mat byRows; // A^T: its columns are the rows of A
+  vec w;
+};
+
+} // namespace mole
+
+#endif // WEIGHTS_H
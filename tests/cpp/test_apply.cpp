@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_apply.cpp
+ *
+ * @brief Checks apply()/apply_add() of the operator classes against the
+ *        sparse products, including concurrent calls.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <class Op> void expectApplies(const Op &A) {
+  const sp_mat &S = A;
+  const vec x = randu<vec>(S.n_cols);
+  const vec Sx = S * x;
+
+  vec out(3); // wrong size, apply resizes it
+  A.apply(x, out);
+  EXPECT_LT(max(abs(out - Sx)), 1e-10);
+
+  vec acc = randu<vec>(S.n_rows);
+  const vec expected = 2.0 * Sx - 0.5 * acc;
+  A.apply_add(2.0, x, -0.5, acc);
+  EXPECT_LT(max(abs(acc - expected)), 1e-10);
+
+  // beta = 0 ignores what out held
+  vec garbage(S.n_rows);
+  garbage.fill(datum::nan);
+  A.apply_add(1.0, x, 0.0, garbage);
+  EXPECT_LT(max(abs(garbage - Sx)), 1e-10);
+}
+
+} // namespace
+
+TEST(ApplyTests, EveryOperatorClass) {
+  expectApplies(Gradient(4, 20, 1.0 / 20));
+  expectApplies(Gradient(2, 10, 12, 0.1, 0.2));
+  expectApplies(Divergence(2, 8, 9, 7, 1.0, 1.0, 1.0));
+  expectApplies(Laplacian(2, 16, 12, 0.1, 0.1));
+  expectApplies(Interpol(10, 12, 0.5, 0.5));
+  expectApplies(Interpol(true, 10, 0.5));
+  expectApplies(InterpolCtoF(2, 10, ivec{1, 1}, ivec{0, 0}));
+  expectApplies(MixedBC(2, 20, 0.05, "Dirichlet", {1.0}, "Neumann", {1.0}));
+  expectApplies(RobinBC(2, 20, 0.05, 1.0, 1.0));
+  expectApplies(Curl(2, 10, 11, 0.1, 0.1));
+  expectApplies(Nodal(4, 12, 0.5));
+  expectApplies(SidedNodal(12, 0.5, SidedNodal::Type::Centered));
+}
+
+TEST(ApplyTests, ConcurrentApplies) {
+  const Laplacian L(4, 40, 40, 0.025, 0.025);
+  const vec x = randu<vec>(L.n_cols);
+  const vec Lx = static_cast<const sp_mat &>(L) * x;
+
+  std::vector<vec> out(8);
+  std::vector<std::thread> threads;
+  for (vec &o : out)
+    threads.emplace_back([&L, &x, &o] {
+      for (int i = 0; i < 20; ++i)
+        L.apply(x, o);
+    });
+  for (std::thread &t : threads)
+    t.join();
+  for (const vec &o : out)
+    EXPECT_LT(max(abs(o - Lx)), 1e-10);
+}
+
+TEST(ApplyTests, RejectsBadBuffers) {
+  const Gradient G(2, 10, 0.1);
+  vec x(G.n_cols, fill::ones), out(G.n_rows);
+  EXPECT_THROW(G.apply(vec(G.n_cols + 1), out), std::invalid_argument);
+  EXPECT_THROW(G.apply_add(1.0, x, 1.0, x), std::invalid_argument);
+
+  const Laplacian L(2, 10, 0.1);
+  vec u(L.n_cols, fill::ones);
+  EXPECT_THROW(L.apply(u, u), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
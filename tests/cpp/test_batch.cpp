@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_batch.cpp
+ *
+ * @brief Checks the batched applies and the cached-factorization solver
+ *        against one column at a time.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Every column of A * X, one product at a time
+mat byColumns(const sp_mat &A, const mat &X) {
+  mat Y(A.n_rows, X.n_cols);
+  for (uword j = 0; j < X.n_cols; ++j)
+    Y.col(j) = A * vec(X.col(j));
+  return Y;
+}
+
+} // namespace
+
+TEST(BatchTests, OperatorApplies) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  const Laplacian L(4, 30, 25, 0.1, 0.1);
+  const sp_mat &S = L;
+  // 19 columns: two full blocks and a partial one
+  const mat X = randu<mat>(S.n_cols, 2 * mole::rhsBlock + 3);
+  const mat expected = byColumns(S, X);
+
+  mat Y(1, 1); // wrong size, apply resizes it
+  L.apply(X, Y);
+  EXPECT_LT(abs(Y - expected).max(), 1e-9);
+
+  mat acc = randu<mat>(S.n_rows, X.n_cols);
+  const mat sum = 2.0 * expected - 0.5 * acc;
+  L.apply_add(2.0, X, -0.5, acc);
+  EXPECT_LT(abs(acc - sum).max(), 1e-9);
+
+  mat garbage(S.n_rows, X.n_cols);
+  garbage.fill(datum::nan);
+  L.apply_add(1.0, X, 0.0, garbage);
+  EXPECT_LT(abs(garbage - expected).max(), 1e-9);
+
+  EXPECT_THROW(L.apply(mat(S.n_cols + 1, 2), Y), std::invalid_argument);
+  mat narrow(S.n_rows, 2);
+  EXPECT_THROW(mole::apply_add(S, 1.0, X, 1.0, narrow), std::invalid_argument);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+TEST(BatchTests, MirrorsAndFactors) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  const sp_mat G = Gradient(2, 40, 30, 20, 1.0, 1.0, 1.0);
+  const mat X = randu<mat>(G.n_cols, 11);
+  const mat expected = byColumns(G, X);
+
+  EXPECT_LT(abs(mole::CSR(G) * X - expected).max(), 1e-9);
+
+  const auto K = mole::KronOperator::gradient(2, 40, 30, 20, 1.0, 1.0, 1.0);
+  mat Y;
+  K.apply(X, Y);
+  EXPECT_LT(abs(Y - expected).max(), 1e-9);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+TEST(BatchTests, CachedFactorization) {
+  const u32 m = 40;
+  const Real dx = 1.0 / m;
+  sp_mat A = Laplacian(2, m, dx);
+  vec b(m + 2, fill::zeros);
+  AddScalarBC::BC1D bc;
+  bc.dc = {1.0, 1.0};
+  bc.nc = {0.0, 0.0};
+  bc.v = {0.0, 0.0};
+  AddScalarBC::addScalarBC(A, b, 2, m, dx, bc);
+
+  // Ensemble members that differ only in their boundary values
+  mat B = randu<mat>(m + 2, 6);
+  B.row(0) = linspace<rowvec>(0.0, 1.0, 6);
+  B.row(m + 1) = linspace<rowvec>(1.0, 2.0, 6);
+
+  const mole::LinearSolver solver(A);
+  EXPECT_EQ(solver.size(), A.n_rows);
+  const mat X = solver.solve(B);
+  for (uword j = 0; j < B.n_cols; ++j) {
+    const vec x = spsolve(A, vec(B.col(j)));
+    EXPECT_LT(max(abs(X.col(j) - x)), 1e-9);
+    EXPECT_LT(max(abs(solver.solve(vec(B.col(j))) - x)), 1e-9);
+  }
+
+  EXPECT_THROW(solver.solve(vec(m)), std::invalid_argument);
+  EXPECT_THROW(mole::LinearSolver(sp_mat(3, 4)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
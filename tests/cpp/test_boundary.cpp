@@ -0,0 +1,193 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_boundary.cpp
+ *
+ * @brief Checks the boundary rows assembled from triplets against the
+ *        gradient rows and Kronecker products they replace, and the typed
+ *        face conditions, reusable plans and time-dependent data.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// a on the boundary diagonal, -b and b times the first and last gradient rows
+sp_mat fromGradient(u16 k, u32 m, Real dx, Real a0, Real b0, Real a1,
+                    Real b1) {
+  const Gradient G(k, m, dx);
+  sp_mat B(m + 2, m + 2);
+  B(0, 0) = a0;
+  B(m + 1, m + 1) = a1;
+  for (uword j = 0; j < m + 2; ++j) {
+    B(0, j) += -b0 * G(0, j);
+    B(m + 1, j) += b1 * G(m, j);
+  }
+  return B;
+}
+
+sp_mat trimmed(uword s) {
+  sp_mat I = speye<sp_mat>(s, s);
+  I(0, 0) = 0;
+  I(s - 1, s - 1) = 0;
+  return I;
+}
+
+} // namespace
+
+TEST(BoundaryTests, WeightsMatchGradient) {
+  for (u16 k : {2, 4, 6, 8}) {
+    const u32 m = 2 * k + 3;
+    const Gradient G(k, m, 1.0);
+    const Real *w = Gradient::boundaryWeights(k);
+    for (u16 j = 0; j <= k; ++j) {
+      EXPECT_EQ(G(0, j), w[j]);
+      EXPECT_EQ(G(m, m + 1 - j), -w[j]);
+    }
+  }
+}
+
+TEST(BoundaryTests, OneDimensional) {
+  for (u16 k : {2, 4, 6, 8}) {
+    const u32 m = 2 * k + 1;
+    EXPECT_LT(abs(sp_mat(RobinBC(k, m, 0.1, 2.0, 3.0)) -
+                  fromGradient(k, m, 0.1, 2.0, 3.0, 2.0, 3.0))
+                  .max(),
+              1e-12);
+    const MixedBC mixed(k, m, 0.1, "Neumann", {4.0}, "Robin", {1.0, -2.0});
+    EXPECT_LT(abs(sp_mat(mixed) -
+                  fromGradient(k, m, 0.1, 0.0, 4.0, 1.0, -2.0))
+                  .max(),
+              1e-12);
+  }
+  EXPECT_THROW(MixedBC(2, 10, 0.1, "Periodic", {1.0}, "Dirichlet", {1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(MixedBC(2, 10, 0.1, "Robin", {1.0}, "Dirichlet", {1.0}),
+               std::invalid_argument);
+  EXPECT_THROW(mole::faceBC("Neumann", {}), std::invalid_argument);
+}
+
+TEST(BoundaryTests, MultiDimensionalLayout) {
+  const u16 k = 4;
+  const u32 m = 9, n = 10, o = 8;
+  const Real dx = 0.1, dy = 0.2, dz = 0.3;
+  const sp_mat Bm = fromGradient(k, m, dx, 1.0, 2.0, 1.0, 2.0);
+  const sp_mat Bn = fromGradient(k, n, dy, 1.0, 2.0, 1.0, 2.0);
+  const sp_mat Bo = fromGradient(k, o, dz, 1.0, 2.0, 1.0, 2.0);
+  const sp_mat Im = speye<sp_mat>(m + 2, m + 2);
+  const sp_mat In = speye<sp_mat>(n + 2, n + 2);
+
+  const sp_mat B2 = Utils::spkron(trimmed(n + 2), Bm) + Utils::spkron(Bn, Im);
+  EXPECT_LT(abs(sp_mat(RobinBC(k, m, dx, n, dy, 1.0, 2.0)) - B2).max(),
+            1e-10);
+
+  const sp_mat B3 =
+      Utils::spkron(Utils::spkron(trimmed(o + 2), trimmed(n + 2)), Bm) +
+      Utils::spkron(Utils::spkron(trimmed(o + 2), Bn), Im) +
+      Utils::spkron(Utils::spkron(Bo, In), Im);
+  const sp_mat R3 = RobinBC(k, m, dx, n, dy, o, dz, 1.0, 2.0);
+  EXPECT_LT(abs(R3 - B3).max(), 1e-10);
+  EXPECT_EQ(R3.n_nonzero, B3.n_nonzero);
+}
+
+TEST(BoundaryTests, TypedFaces) {
+  static_assert(mole::neumann(2.0).robinCoeffs().b == 2.0, "");
+  static_assert(mole::dirichlet().robinCoeffs().a == 1.0, "");
+  static_assert(mole::periodic().robinCoeffs().a == 0.0, "");
+
+  const MixedBC named(2, 12, 0.1, 10, 0.2, "Dirichlet", {2.0}, "Neumann",
+                      {1.0}, "Robin", {1.0, 3.0}, "Dirichlet", {1.0});
+  const MixedBC typed(2, 12, 0.1, 10, 0.2,
+                      {{mole::dirichlet(2.0), mole::neumann(1.0),
+                        mole::robin(1.0, 3.0), mole::dirichlet(1.0)}});
+  EXPECT_EQ(abs(sp_mat(named) - sp_mat(typed)).max(), 0.0);
+
+  const AddScalarBC::BC2D bc(std::array<mole::FaceBC, 4>{
+      {mole::dirichlet(2.0), mole::neumann(1.0), mole::periodic(),
+       mole::periodic()}});
+  EXPECT_EQ(bc.dc(0), 2.0);
+  EXPECT_EQ(bc.nc(1), 1.0);
+  EXPECT_EQ(bc.dc(2) + bc.nc(2) + bc.dc(3) + bc.nc(3), 0.0);
+}
+
+TEST(BoundaryTests, PlanReuse) {
+  const u16 k = 2;
+  const u32 m = 8, n = 7, o = 6;
+  const mole::BoundaryPlan plan(k, {m, n, o}, {0.1, 0.2, 0.3});
+  EXPECT_EQ(plan.size(), (m + 2) * (n + 2) * (o + 2));
+  EXPECT_EQ(plan.faces(), 6u);
+  EXPECT_EQ(plan.faceRows(0).n_elem, n * o);
+  EXPECT_EQ(plan.faceRows(5).n_elem, (m + 2) * (n + 2));
+
+  // One plan, many coefficients
+  for (Real a : {0.0, 0.5, 2.0}) {
+    const sp_mat B = plan.build(std::array<mole::FaceBC, 6>{
+        {mole::robin(a, 1.0), mole::neumann(), mole::robin(a, 1.0),
+         mole::neumann(), mole::robin(a, 1.0), mole::neumann()}});
+    const MixedBC expected(k, m, 0.1, n, 0.2, o, 0.3, "Robin", {a, 1.0},
+                           "Neumann", {1.0}, "Robin", {a, 1.0}, "Neumann",
+                           {1.0}, "Robin", {a, 1.0}, "Neumann", {1.0});
+    EXPECT_EQ(abs(B - sp_mat(expected)).max(), 0.0);
+    EXPECT_EQ(B.n_nonzero, expected.n_nonzero);
+  }
+
+  // Only the rows of the Dirichlet faces remain
+  const sp_mat D = plan.build(
+      std::vector<mole::FaceBC>(6, mole::dirichlet(3.0)));
+  EXPECT_EQ(D.n_nonzero, 2 * (n * o + (m + 2) * o + (m + 2) * (n + 2)));
+  EXPECT_THROW(plan.build(std::array<mole::FaceBC, 4>{}),
+               std::invalid_argument);
+
+  // Periodic axes have no boundary points to put rows on
+  std::vector<mole::FaceBC> faces(6, mole::dirichlet());
+  faces[2] = faces[3] = mole::periodic();
+  EXPECT_THROW(plan.build(faces), std::invalid_argument);
+  EXPECT_THROW(mole::BoundaryPlan(k, {m, n}, {0.1, 0.0}),
+               std::invalid_argument);
+  EXPECT_THROW(mole::BoundaryPlan(k, {m, n}, {0.1}), std::invalid_argument);
+}
+
+TEST(BoundaryTests, TimeDependentData) {
+  const u32 m = 6, n = 5;
+  const mole::BoundaryPlan plan(2, {m, n}, {0.5, 0.2});
+  const mole::BoundaryData data(plan, {-1.0, 0.0});
+
+  // Left face: x = -1, y at the cell centers; top face: y = 1
+  EXPECT_EQ(max(abs(data.x(0) + 1.0)), 0.0);
+  EXPECT_NEAR(data.y(0)(0), 0.1, 1e-15);
+  EXPECT_NEAR(max(abs(data.y(3) - 1.0)), 0.0, 1e-15);
+  EXPECT_NEAR(data.x(3)(m + 1), 2.0, 1e-15);
+
+  vec b(plan.size(), fill::zeros);
+  const auto g = [](uword face, const vec &x, const vec &y, const vec &,
+                    Real t) -> vec {
+    if (face == 0)
+      return t * y;
+    if (face == 3)
+      return x + t;
+    if (face == 1)
+      return {7.0};
+    return {};
+  };
+  data.apply(b, 2.0, g);
+  EXPECT_EQ(max(abs(b(plan.faceRows(0)) - 2.0 * data.y(0))), 0.0);
+  EXPECT_EQ(max(abs(b(plan.faceRows(3)) - (data.x(3) + 2.0))), 0.0);
+  EXPECT_EQ(min(vec(b(plan.faceRows(1)))), 7.0);
+  EXPECT_EQ(max(abs(vec(b(plan.faceRows(2))))), 0.0);
+
+  vec small(3);
+  EXPECT_THROW(data.apply(small, 0.0, g), std::invalid_argument);
+  const auto wrong = [](uword, const vec &, const vec &, const vec &,
+                        Real) -> vec { return vec(2, fill::ones); };
+  EXPECT_THROW(data.apply(b, 0.0, wrong), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
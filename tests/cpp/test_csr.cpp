@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_csr.cpp
+ *
+ * @brief Checks the row-major mirror and its parallel product against
+ *        Armadillo.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using mole::CSR;
+
+TEST(CSRTests, MirrorsOperator) {
+  const sp_mat G = Gradient(4, 12, 9, 0.1, 0.2);
+  const CSR rows(G);
+  ASSERT_EQ(rows.rows(), G.n_rows);
+  ASSERT_EQ(rows.cols(), G.n_cols);
+  ASSERT_EQ(rows.nnz(), G.n_nonzero);
+
+  const sp_mat back(rows.columns(), rows.rowPointers(), rows.values(),
+                    G.n_cols, G.n_rows);
+  EXPECT_EQ(abs(back.t() - G).max(), 0.0);
+}
+
+TEST(CSRTests, ProductMatchesArmadillo) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  for (const sp_mat &A :
+       {sp_mat(Laplacian(4, 200, 150, 0.01, 0.01)),
+        sp_mat(Divergence(2, 30, 20, 10, 1.0, 1.0, 1.0)),
+        sp_mat(Interpol(40, 0.5))}) {
+    const vec x = randu<vec>(A.n_cols);
+    EXPECT_LT(max(abs(CSR(A) * x - A * x)), 1e-9);
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+TEST(CSRTests, BalancedParts) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  const sp_mat L = Laplacian(2, 300, 300, 1.0, 1.0);
+  const CSR rows(L);
+  ASSERT_GE(rows.parts(), 1u);
+  EXPECT_EQ(rows.first(0), 0u);
+  EXPECT_EQ(rows.first(rows.parts()), L.n_rows);
+
+  const uvec &ptr = rows.rowPointers();
+  for (uword p = 0; p < rows.parts(); ++p) {
+    const uword nnz = ptr(rows.first(p + 1)) - ptr(rows.first(p));
+    EXPECT_NEAR(static_cast<Real>(nnz),
+                static_cast<Real>(L.n_nonzero) / rows.parts(),
+                0.01 * L.n_nonzero);
+  }
+
+  // Small operators stay in one piece
+  EXPECT_EQ(CSR(Gradient(2, 10, 1.0)).parts(), 1u);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+TEST(CSRTests, EmptyRowsAndSizeCheck) {
+  sp_mat A(5, 3);
+  A(1, 2) = 2.0;
+  A(3, 0) = -1.0;
+  const CSR rows(A);
+  const vec y = rows * vec{1.0, 2.0, 3.0};
+  EXPECT_EQ(y(0), 0.0);
+  EXPECT_EQ(y(1), 6.0);
+  EXPECT_EQ(y(3), -1.0);
+  EXPECT_EQ(y(4), 0.0);
+  EXPECT_THROW(rows * vec(4), std::invalid_argument);
+
+  // In place would overwrite x while later rows still read it
+  const CSR square(Laplacian(2, 10, 1.0));
+  vec x = randu<vec>(square.cols());
+  EXPECT_THROW(square.apply(x, x), std::invalid_argument);
+  EXPECT_THROW(square.view().apply(x, x), std::invalid_argument);
+}
+
+TEST(CSRTests, ConversionsAndTransposedView) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  const sp_mat D = Divergence(2, 40, 30, 20, 1.0, 1.0, 1.0);
+  const CSR rows(D);
+  EXPECT_EQ(abs(rows.toSparse() - D).max(), 0.0);
+  EXPECT_EQ(abs(rows.transposeSparse() - D.t()).max(), 0.0);
+
+  const sp_mat Dt = D.t();
+  const CSR fromT = CSR::fromTransposed(Dt);
+  EXPECT_EQ(abs(fromT.toSparse() - D).max(), 0.0);
+
+  // Rows of D^T straight from the columns of D
+  const vec f = randu<vec>(D.n_rows);
+  EXPECT_LT(max(abs(mole::CSRView::transposeOf(D) * f - Dt * f)), 1e-12);
+  const vec u = randu<vec>(D.n_cols);
+  EXPECT_LT(max(abs(rows.view() * u - D * u)), 1e-12);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+TEST(CSRTests, RowEdits) {
+  const sp_mat L = Laplacian(2, 20, 0.05);
+  CSR rows(L);
+  rows.zeroRow(1);
+  rows.scaleRow(5, -2.0);
+  EXPECT_EQ(rows.nnz(), L.n_nonzero); // pattern kept
+
+  sp_mat expected = L;
+  expected.row(1).zeros();
+  expected.row(5) *= -2.0;
+  const sp_mat edited = rows.toSparse();
+  EXPECT_EQ(abs(edited - expected).max(), 0.0);
+  EXPECT_EQ(edited.n_nonzero, expected.n_nonzero); // zeros dropped
+
+  EXPECT_THROW(rows.zeroRow(L.n_rows), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_curl.cpp
+ *
+ * @brief Checks the curl operators against curl2D, the identity
+ *        div(curl) = 0, and their matrix-free application.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// Interior rows of the 1-D divergence, as in curl2D.m
+sp_mat interiorDivergence(u16 k, u32 m, Real dx) {
+  const sp_mat D = Divergence(k, m, dx);
+  return D.rows(1, m);
+}
+
+} // namespace
+
+TEST(CurlTests, MatchesCurl2D) {
+  const u16 k = 4;
+  const u32 m = 11, n = 9;
+  const Real dx = 0.5, dy = 0.25;
+  const sp_mat Dx = interiorDivergence(k, m, dx);
+  const sp_mat Dy = interiorDivergence(k, n, dy);
+
+  const uword U = m * (n + 1), V = (m + 1) * n, W = (m + 1) * (n + 1);
+  const sp_mat C1 = Utils::spjoin_rows(sp_mat(V, U + V),
+                                       Utils::spkron(Dy, speye(m + 1, m + 1)));
+  const sp_mat C2 = Utils::spjoin_rows(
+      sp_mat(U, U + V), -Utils::spkron(speye(n + 1, n + 1), Dx));
+  const sp_mat C3 = Utils::spjoin_rows(
+      Utils::spjoin_rows(-Utils::spkron(Dy, speye(m, m)),
+                         Utils::spkron(speye(n, n), Dx)),
+      sp_mat(m * n, W));
+  const sp_mat expected = Utils::spjoin_cols(Utils::spjoin_cols(C1, C2), C3);
+
+  const sp_mat C = Curl(k, m, n, dx, dy);
+  ASSERT_EQ(C.n_rows, expected.n_rows);
+  ASSERT_EQ(C.n_cols, expected.n_cols);
+  EXPECT_LT(abs(C - expected).max(), 1e-12);
+}
+
+TEST(CurlTests, DivergenceOfCurlVanishes) {
+  const Curl C2(2, 12, 10, 0.1, 0.2);
+  const Divergence D2(2, 12, 10, 0.1, 0.2);
+  const vec c2 = C2 * randu<vec>(C2.n_cols);
+  EXPECT_LT(max(abs(D2 * c2.head(D2.n_cols))), 1e-9);
+
+  const Curl C3(4, 9, 10, 11, 0.1, 0.2, 0.3);
+  const Divergence D3(4, 9, 10, 11, 0.1, 0.2, 0.3);
+  ASSERT_EQ(C3.n_rows, D3.n_cols);
+  EXPECT_LT(max(abs(D3 * (C3 * randu<vec>(C3.n_cols)))), 1e-8);
+}
+
+TEST(CurlTests, VorticityOfRotation) {
+  const u32 m = 20, n = 16;
+  const Real dx = 0.5, dy = 0.25;
+  const CurlKernel kernel(2, m, n, dx, dy);
+
+  // u = -y on the horizontal faces, v = x on the vertical faces
+  vec u(m * (n + 1)), v((m + 1) * n);
+  for (u32 j = 0; j <= n; ++j)
+    for (u32 i = 0; i < m; ++i)
+      u(j * m + i) = -(j * dy);
+  for (u32 j = 0; j < n; ++j)
+    for (u32 i = 0; i <= m; ++i)
+      v(j * (m + 1) + i) = i * dx;
+
+  vec omega;
+  kernel.vorticity(u, v, omega);
+  ASSERT_EQ(omega.n_elem, m * n);
+  EXPECT_LT(max(abs(omega - 2.0)), 1e-10);
+}
+
+TEST(CurlTests, VorticityOfGradientLayout) {
+  const u32 m = 12, n = 10, o = 8;
+  const Real dx = 0.5, dy = 0.25, dz = 0.2;
+
+  // u = -y on the x-faces, v = x on the y-faces: the layout of G * p
+  vec faces((m + 1) * n + m * (n + 1));
+  uword p = 0;
+  for (u32 j = 0; j < n; ++j)
+    for (u32 i = 0; i <= m; ++i)
+      faces(p++) = -((j + 0.5) * dy);
+  for (u32 j = 0; j <= n; ++j)
+    for (u32 i = 0; i < m; ++i)
+      faces(p++) = (i + 0.5) * dx;
+  ASSERT_EQ(faces.n_elem, Gradient(2, m, n, dx, dy).n_rows);
+
+  vec omega;
+  CurlKernel(2, m, n, dx, dy).vorticity(faces, omega);
+  ASSERT_EQ(omega.n_elem, m * n);
+  EXPECT_LT(max(abs(omega - 2.0)), 1e-10);
+  EXPECT_THROW(CurlKernel(2, m, n, dx, dy).vorticity(vec(5), omega),
+               std::invalid_argument);
+
+  // The same rotation about z in 3-D, w = 0
+  vec faces3((m + 1) * n * o + m * (n + 1) * o + m * n * (o + 1),
+             fill::zeros);
+  p = 0;
+  for (u32 l = 0; l < o; ++l)
+    for (u32 j = 0; j < n; ++j)
+      for (u32 i = 0; i <= m; ++i)
+        faces3(p++) = -((j + 0.5) * dy);
+  for (u32 l = 0; l < o; ++l)
+    for (u32 j = 0; j <= n; ++j)
+      for (u32 i = 0; i < m; ++i)
+        faces3(p++) = (i + 0.5) * dx;
+  ASSERT_EQ(faces3.n_elem, Gradient(2, m, n, o, dx, dy, dz).n_rows);
+
+  CurlKernel(2, m, n, o, dx, dy, dz).vorticity(faces3, omega);
+  const uword zfaces = m * n * (o + 1);
+  ASSERT_EQ(omega.n_elem, faces3.n_elem);
+  EXPECT_LT(max(abs(omega.head(omega.n_elem - zfaces))), 1e-10);
+  EXPECT_LT(max(abs(omega.tail(zfaces) - 2.0)), 1e-10);
+}
+
+TEST(CurlTests, KernelMatchesAssembled) {
+  const CurlKernel k2(4, 13, 12, 0.1, 0.3);
+  const vec in2 = randu<vec>(k2.cols());
+  EXPECT_LT(max(abs(k2.apply(in2) - Curl(k2) * in2)), 1e-9);
+
+  const CurlKernel k3(2, 7, 8, 9, 0.1, 0.2, 0.3);
+  const Curl C3(k3);
+  const uword U = 7 * 9 * 10, V = 8 * 8 * 10, W = 8 * 9 * 9;
+  ASSERT_EQ(C3.n_cols, U + V + W);
+  const vec in3 = randu<vec>(C3.n_cols);
+  vec omega;
+  k3.vorticity(in3.head(U), in3.subvec(U, U + V - 1), in3.tail(W), omega);
+  EXPECT_LT(max(abs(omega - C3 * in3)), 1e-9);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_curvilinear.cpp
+ *
+ * @brief Checks curvilinear metrics, gradients and divergences on mapped
+ *        grids where the mimetic operators are exact.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+// Cell centers plus the two boundary points on [0, 1]
+vec centers(u32 m) {
+  vec x(m + 2);
+  x(0) = 0.0;
+  x(m + 1) = 1.0;
+  for (u32 i = 1; i <= m; ++i)
+    x(i) = (i - 0.5) / m;
+  return x;
+}
+
+const ivec dc2 = {1, 1, 1, 1};
+const ivec nc2 = {0, 0, 0, 0};
+const ivec dc3 = {1, 1, 1, 1, 1, 1};
+const ivec nc3 = {0, 0, 0, 0, 0, 0};
+
+// Centers numbered x fastest, matching the operators
+vec flatten(const mat &X) { return vectorise(X.t()); }
+
+} // namespace
+
+TEST(CurvilinearTests, CartesianJacobian) {
+  Utils utils;
+  mat X, Y;
+  utils.meshgrid(centers(12), centers(10), X, Y);
+  X *= 3.0;
+  Y *= 2.0;
+
+  const CurvilinearMetrics metrics(2, X, Y, dc2, nc2);
+  EXPECT_EQ(metrics.size(), 14u * 12u);
+  EXPECT_LT(max(abs(metrics.jacobian() - 6.0)), 1e-10);
+  EXPECT_LT(max(abs(metrics.contravariant().col(0) - 1.0 / 3.0)), 1e-10);
+  EXPECT_LT(max(abs(metrics.contravariant().col(1))), 1e-10);
+}
+
+TEST(CurvilinearTests, GradientExactForLinearOnDistortedGrid) {
+  for (u16 k : {2, 4}) {
+    Utils utils;
+    mat Xi, Eta;
+    utils.meshgrid(centers(16), centers(14), Xi, Eta);
+    const mat X = Xi + 0.05 * sin(M_PI * Xi) % sin(M_PI * Eta);
+    const mat Y = Eta - 0.04 * sin(M_PI * Xi) % sin(2 * M_PI * Eta);
+
+    const CurvilinearMetrics metrics(k, X, Y, dc2, nc2);
+    const GradientCurv G(metrics);
+
+    const vec f = 2.0 * flatten(X) - 3.0 * flatten(Y);
+    const vec g = G * f;
+    const uword nx = 17 * 16; // (m+1)(n+2) extended x-faces
+    ASSERT_EQ(g.n_elem, nx + 18 * 15);
+    EXPECT_LT(max(abs(g.head(nx) - 2.0)), 1e-9);
+    EXPECT_LT(max(abs(g.tail(g.n_elem - nx) + 3.0)), 1e-9);
+  }
+}
+
+TEST(CurvilinearTests, DivergenceOfPositionOnAffineGrid) {
+  Utils utils;
+  mat Xi, Eta;
+  const u32 m = 12, n = 11;
+  utils.meshgrid(centers(m), centers(n), Xi, Eta);
+  const mat X = 2.0 * Xi + 0.5 * Eta;
+  const mat Y = 0.3 * Xi + 1.5 * Eta;
+
+  const CurvilinearMetrics metrics(2, X, Y, dc2, nc2);
+  const DivergenceCurv D(metrics);
+  EXPECT_EQ(D.n_rows, (m + 2) * (n + 2));
+
+  // u = (x, y) on the extended faces, div u = 2
+  const vec ux = metrics.expand(0, metrics.axis(0).ICF) * flatten(X);
+  const vec uy = metrics.expand(1, metrics.axis(1).ICF) * flatten(Y);
+  const vec div = D * join_cols(ux, uy);
+
+  for (u32 j = 0; j < n + 2; ++j) {
+    for (u32 i = 0; i < m + 2; ++i) {
+      const bool boundary = i == 0 || j == 0 || i == m + 1 || j == n + 1;
+      EXPECT_NEAR(div(j * (m + 2) + i), boundary ? 0.0 : 2.0, 1e-9);
+    }
+  }
+}
+
+TEST(CurvilinearTests, Gradient3DExactForLinear) {
+  Utils utils;
+  cube Xi, Eta, Zeta;
+  utils.meshgrid(centers(9), centers(10), centers(11), Xi, Eta, Zeta);
+  cube X = Xi, Y = Eta, Z = Zeta;
+  for (uword c = 0; c < X.n_elem; ++c) {
+    const Real bump = std::sin(M_PI * Xi(c)) * std::sin(M_PI * Eta(c)) *
+                      std::sin(M_PI * Zeta(c));
+    X(c) += 0.04 * bump;
+    Y(c) -= 0.03 * bump;
+    Z(c) += 0.02 * bump;
+  }
+
+  const CurvilinearMetrics metrics(2, X, Y, Z, dc3, nc3);
+  const GradientCurv G(metrics);
+  const vec g = G * (vectorise(X) + 2.0 * vectorise(Y) - vectorise(Z));
+
+  const uword nx = 10 * 12 * 13, ny = 11 * 11 * 13, nz = 11 * 12 * 12;
+  ASSERT_EQ(g.n_elem, nx + ny + nz);
+  EXPECT_LT(max(abs(g.subvec(0, nx - 1) - 1.0)), 1e-9);
+  EXPECT_LT(max(abs(g.subvec(nx, nx + ny - 1) - 2.0)), 1e-9);
+  EXPECT_LT(max(abs(g.tail(nz) + 1.0)), 1e-9);
+}
+
+TEST(CurvilinearTests, RejectsDegenerateGrid) {
+  Utils utils;
+  mat X, Y;
+  utils.meshgrid(centers(10), centers(10), X, Y);
+  EXPECT_THROW(CurvilinearMetrics(2, X, X, dc2, nc2), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
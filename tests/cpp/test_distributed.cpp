@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_distributed.cpp
+ *
+ * @brief Checks that the local rows of every rank reproduce the global
+ *        operators, and the partition of the grid.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+using mole::Decomposition;
+using mole::DistributedOperator;
+
+namespace {
+
+// Every rank's rows, applied to the owned and ghost entries of x, give its
+// rows of A x; together the ranks own every row and entry exactly once
+void expectSameRows(const sp_mat &A,
+                    const std::vector<DistributedOperator> &parts) {
+  const vec x = randu<vec>(A.n_cols);
+  const vec Ax = A * x;
+  uvec rows(A.n_rows, fill::zeros), cols(A.n_cols, fill::zeros);
+  for (const DistributedOperator &part : parts) {
+    const uvec in = join_cols(part.colIndices(), part.ghostIndices());
+    const vec xin = x.elem(in);
+    const vec y = part.local() * xin;
+    EXPECT_LT(max(abs(y - Ax.elem(part.rowIndices()))), 1e-9);
+    rows.elem(part.rowIndices()) += 1;
+    cols.elem(part.colIndices()) += 1;
+  }
+  EXPECT_TRUE(all(rows == 1));
+  EXPECT_TRUE(all(cols == 1));
+}
+
+template <class Build>
+std::vector<DistributedOperator> onRanks(int size, u32 m, u32 n, Build build) {
+  std::vector<DistributedOperator> parts;
+  for (int rank = 0; rank < size; ++rank)
+    parts.push_back(build(Decomposition(rank, size, m, n)));
+  return parts;
+}
+
+template <class Build>
+std::vector<DistributedOperator> onRanks(int size, u32 m, u32 n, u32 o,
+                                         Build build) {
+  std::vector<DistributedOperator> parts;
+  for (int rank = 0; rank < size; ++rank)
+    parts.push_back(build(Decomposition(rank, size, m, n, o)));
+  return parts;
+}
+
+} // namespace
+
+TEST(DistributedTests, SingleRankMatchesGlobalOperators) {
+  const mole::Communicator serial;
+  const u16 k = 4;
+  const u32 m = 12, n = 10;
+  const Decomposition d(serial, m, n);
+  const DistributedOperator L = DistributedOperator::laplacian(k, d, 0.1, 0.2);
+  const sp_mat global = Laplacian(k, m, n, 0.1, 0.2);
+  EXPECT_LT(abs(L.local() - global).max(), 1e-10);
+  EXPECT_EQ(L.ghostIndices().n_elem, 0u);
+  EXPECT_EQ(L.interiorRows(), global.n_rows);
+
+  const vec x = randu<vec>(global.n_cols);
+  EXPECT_LT(max(abs(L.apply(x) - global * x)), 1e-9);
+}
+
+TEST(DistributedTests, RanksReproduce2DOperators) {
+  const u16 k = 2;
+  const u32 m = 11, n = 9;
+  const Real dx = 0.3, dy = 0.2;
+  for (int size : {2, 4, 6}) {
+    expectSameRows(Gradient(k, m, n, dx, dy),
+                   onRanks(size, m, n, [&](const Decomposition &d) {
+                     return DistributedOperator::gradient(k, d, dx, dy);
+                   }));
+    expectSameRows(Divergence(k, m, n, dx, dy),
+                   onRanks(size, m, n, [&](const Decomposition &d) {
+                     return DistributedOperator::divergence(k, d, dx, dy);
+                   }));
+    expectSameRows(Laplacian(k, m, n, dx, dy),
+                   onRanks(size, m, n, [&](const Decomposition &d) {
+                     return DistributedOperator::laplacian(k, d, dx, dy);
+                   }));
+    expectSameRows(Interpol(m, n, 0.5, 0.5),
+                   onRanks(size, m, n, [&](const Decomposition &d) {
+                     return DistributedOperator::interpol(d, 0.5, 0.5);
+                   }));
+    expectSameRows(Interpol(true, m, n, 0.5, 0.5),
+                   onRanks(size, m, n, [&](const Decomposition &d) {
+                     return DistributedOperator::interpol(true, d, 0.5, 0.5);
+                   }));
+  }
+}
+
+TEST(DistributedTests, RanksReproduce3DOperators) {
+  const u16 k = 4;
+  const u32 m = 10, n = 9, o = 11;
+  for (int size : {3, 8}) {
+    expectSameRows(Gradient(k, m, n, o, 1.0, 1.0, 1.0),
+                   onRanks(size, m, n, o, [&](const Decomposition &d) {
+                     return DistributedOperator::gradient(k, d, 1.0, 1.0, 1.0);
+                   }));
+    expectSameRows(Laplacian(k, m, n, o, 1.0, 1.0, 1.0),
+                   onRanks(size, m, n, o, [&](const Decomposition &d) {
+                     return DistributedOperator::laplacian(k, d, 1.0, 1.0,
+                                                           1.0);
+                   }));
+  }
+}
+
+TEST(DistributedTests, Partition) {
+  // 24 ranks on a 48 x 48 x 24 grid: boxes of 12 x 12 x 12
+  const Decomposition d(5, 24, 48, 48, 24);
+  EXPECT_EQ(d.ranks(0), 4);
+  EXPECT_EQ(d.ranks(1), 4);
+  EXPECT_EQ(d.ranks(2), 2);
+  EXPECT_EQ(d.coord(0), 1);
+  EXPECT_EQ(d.coord(1), 1);
+  EXPECT_EQ(d.begin(0), 12u);
+  EXPECT_EQ(d.end(0), 24u);
+
+  // Boundary centers go to the boundary ranks, the last face to the last
+  const Decomposition first(0, 2, 10, 4), last(1, 2, 10, 4);
+  EXPECT_EQ(first.pointsBegin(0, 2), 0u);
+  EXPECT_EQ(first.pointsEnd(0, 2), 6u);
+  EXPECT_EQ(last.pointsEnd(0, 2), 12u);
+  EXPECT_EQ(first.pointsEnd(0, 1), 5u);
+  EXPECT_EQ(last.pointsEnd(0, 1), 11u);
+
+  EXPECT_THROW(Decomposition(0, 7, 4, 4), std::invalid_argument);
+}
+
+TEST(DistributedTests, HaloNeedsCommunicator) {
+  const Decomposition d(0, 4, 12, 12);
+  const DistributedOperator G = DistributedOperator::gradient(2, d, 1.0, 1.0);
+  EXPECT_GT(G.ghostIndices().n_elem, 0u);
+  EXPECT_LT(G.interiorRows(), G.rowIndices().n_elem);
+  EXPECT_THROW(G.apply(vec(G.colIndices().n_elem, fill::ones)),
+               std::runtime_error);
+  EXPECT_THROW(DistributedOperator::gradient(2, d, 1.0, 1.0, 1.0),
+               std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+#ifdef MOLE_USE_MPI
+  MPI_Init(&argc, &argv);
+#endif
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+#ifdef MOLE_USE_MPI
+  MPI_Finalize();
+#endif
+  return result;
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_distributed_mpi.cpp
+ *
+ * @brief Runs the halo exchange across MPI ranks: the received ghosts and
+ *        every rank's output rows must match the serial operators. Built
+ *        with MOLE_USE_MPI only and run under mpiexec with 2 and 4 ranks.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using mole::Communicator;
+using mole::Decomposition;
+using mole::DistributedOperator;
+
+namespace {
+
+// The same global vector on every rank, without a shared random state
+vec globalVector(uword n) {
+  vec x(n);
+  for (uword i = 0; i < n; ++i)
+    x(i) = std::sin(0.37 * i) + 0.01 * i;
+  return x;
+}
+
+// Applies the local rows to this rank's entries of a global x and checks
+// the ghosts that arrived and the rows that came out
+void expectMatchesSerial(const sp_mat &A, const DistributedOperator &part) {
+  const vec x = globalVector(A.n_cols);
+  const vec Ax = A * x;
+  const vec in = x.elem(part.colIndices());
+
+  vec out;
+  part.apply(in, out);
+  ASSERT_EQ(out.n_elem, part.rowIndices().n_elem);
+  EXPECT_LT(max(abs(out - Ax.elem(part.rowIndices()))), 1e-9);
+
+  ASSERT_EQ(part.ghosts().n_elem, part.ghostIndices().n_elem);
+  if (!part.ghostIndices().is_empty()) {
+    EXPECT_EQ(max(abs(part.ghosts() - x.elem(part.ghostIndices()))), 0.0);
+  }
+
+  // The owned rows cover the output exactly once across the ranks
+  const Communicator world;
+  EXPECT_EQ(world.sum(Real(part.rowIndices().n_elem)), Real(A.n_rows));
+  EXPECT_NEAR(world.sum(accu(square(out))), accu(square(Ax)),
+              1e-9 * accu(square(Ax)));
+}
+
+} // namespace
+
+TEST(DistributedMPITests, HaloExchange2D) {
+  const Communicator world;
+  ASSERT_GT(world.size(), 1);
+  const u16 k = 2;
+  const u32 m = 12, n = 10;
+  const Real dx = 0.3, dy = 0.2;
+  const Decomposition d(world, m, n);
+
+  const DistributedOperator G = DistributedOperator::gradient(k, d, dx, dy);
+  EXPECT_GT(G.ghostIndices().n_elem, 0u);
+  expectMatchesSerial(Gradient(k, m, n, dx, dy), G);
+  expectMatchesSerial(Divergence(k, m, n, dx, dy),
+                      DistributedOperator::divergence(k, d, dx, dy));
+  expectMatchesSerial(Laplacian(k, m, n, dx, dy),
+                      DistributedOperator::laplacian(k, d, dx, dy));
+  expectMatchesSerial(Interpol(true, m, n, 0.5, 0.5),
+                      DistributedOperator::interpol(true, d, 0.5, 0.5));
+}
+
+TEST(DistributedMPITests, HaloExchange3D) {
+  const Communicator world;
+  const u16 k = 4;
+  const u32 m = 10, n = 9, o = 11;
+  const Decomposition d(world, m, n, o);
+  expectMatchesSerial(Laplacian(k, m, n, o, 1.0, 0.5, 0.25),
+                      DistributedOperator::laplacian(k, d, 1.0, 0.5, 0.25));
+  expectMatchesSerial(Gradient(k, m, n, o, 1.0, 0.5, 0.25),
+                      DistributedOperator::gradient(k, d, 1.0, 0.5, 0.25));
+}
+
+TEST(DistributedMPITests, RepeatedApplies) {
+  // The requests and buffers are reused from one apply to the next
+  const Communicator world;
+  const u32 m = 12, n = 12;
+  const Decomposition d(world, m, n);
+  const DistributedOperator L = DistributedOperator::laplacian(2, d, 0.1, 0.1);
+  const sp_mat A = Laplacian(2, m, n, 0.1, 0.1);
+  for (int step = 0; step < 3; ++step) {
+    const vec x = (step + 1.0) * globalVector(A.n_cols);
+    const vec y = L.apply(vec(x.elem(L.colIndices())));
+    EXPECT_LT(max(abs(y - vec(A * x).elem(L.rowIndices()))), 1e-8);
+  }
+}
+
+int main(int argc, char **argv) {
+  MPI_Init(&argc, &argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+  return result;
+}
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_eigs.cpp
+ *
+ * @brief Checks mole::eigs against closed-form spectra and a dense
+ *        eigensolver on a mimetic Hamiltonian.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using mole::EigsTarget;
+
+namespace {
+
+// Second-difference matrix tridiag(-1, 2, -1), eigenvalues 2 - 2cos(j*pi/(n+1))
+sp_mat secondDifference(uword n) {
+  sp_mat T(n, n);
+  for (uword i = 0; i < n; ++i) {
+    T(i, i) = 2.0;
+    if (i > 0) {
+      T(i, i - 1) = -1.0;
+      T(i - 1, i) = -1.0;
+    }
+  }
+  return T;
+}
+
+Real exact(uword j, uword n) { return 2.0 - 2.0 * std::cos(j * M_PI / (n + 1)); }
+
+} // namespace
+
+TEST(EigsTests, LowestOfSecondDifference) {
+  const uword n = 200;
+  const mole::EigsResult r = mole::eigs(secondDifference(n), 4);
+  ASSERT_TRUE(r.converged);
+  for (uword j = 0; j < 4; ++j) {
+    EXPECT_NEAR(r.values(j).real(), exact(j + 1, n), 1e-9);
+    EXPECT_NEAR(r.values(j).imag(), 0.0, 1e-9);
+  }
+}
+
+TEST(EigsTests, LargestMagnitude) {
+  const uword n = 100;
+  const mole::EigsResult r =
+      mole::eigs(secondDifference(n), 2, EigsTarget::LargestMagnitude);
+  ASSERT_TRUE(r.converged);
+  EXPECT_NEAR(r.values(0).real(), exact(n, n), 1e-8);
+  EXPECT_NEAR(r.values(1).real(), exact(n - 1, n), 1e-8);
+}
+
+TEST(EigsTests, GeneralizedAndEigenvectors) {
+  const uword n = 150;
+  const sp_mat A = secondDifference(n);
+  const sp_mat B = 2.0 * speye<sp_mat>(n, n);
+  const mole::EigsResult r = mole::eigs(A, B, 3);
+  ASSERT_TRUE(r.converged);
+  for (uword j = 0; j < 3; ++j) {
+    EXPECT_NEAR(r.values(j).real(), 0.5 * exact(j + 1, n), 1e-9);
+    const vec x = real(r.vectors.col(j));
+    EXPECT_LT(norm(A * x - r.values(j).real() * (B * x)), 1e-6);
+  }
+
+  sp_mat C = B;
+  C(0, 1) = 0.1;
+  EXPECT_THROW(mole::eigs(A, C, 3), std::invalid_argument);
+  EXPECT_NO_THROW(mole::eigs(A, C, 3, EigsTarget::Nearest, 0.0));
+}
+
+TEST(EigsTests, RepeatedEigenvaluesIn2D) {
+  const uword m = 20;
+  const sp_mat T = secondDifference(m);
+  const sp_mat I = speye<sp_mat>(m, m);
+  const sp_mat A = kron(T, I) + kron(I, T);
+
+  std::vector<Real> expected;
+  for (uword i = 1; i <= m; ++i)
+    for (uword j = 1; j <= m; ++j)
+      expected.push_back(exact(i, m) + exact(j, m));
+  std::sort(expected.begin(), expected.end());
+
+  const mole::EigsResult r = mole::eigs(A, 5);
+  ASSERT_TRUE(r.converged);
+  for (uword j = 0; j < 5; ++j)
+    EXPECT_NEAR(r.values(j).real(), expected[j], 1e-9);
+}
+
+TEST(EigsTests, MimeticHamiltonianMatchesDense) {
+  const u16 k = 4;
+  const u32 m = 60;
+  const Real dx = 10.0 / m;
+  const Laplacian L(k, m, dx);
+
+  vec x(m + 2);
+  x(0) = -5.0;
+  x(m + 1) = 5.0;
+  for (u32 i = 1; i <= m; ++i)
+    x(i) = -5.0 + (i - 0.5) * dx;
+  sp_mat V(m + 2, m + 2);
+  V.diag() = x % x;
+  const sp_mat H = -0.5 * static_cast<const sp_mat &>(L) + V;
+
+  cx_vec dense;
+  eig_gen(dense, mat(H));
+  vec lowest = sort(real(dense));
+
+  // min(V) = 0 bounds the spectrum from below
+  mole::Eigensolver solver(H, EigsTarget::Lowest, 0.0);
+  const mole::EigsResult r = solver.solve(4);
+  ASSERT_TRUE(r.converged);
+  for (uword j = 0; j < 4; ++j)
+    EXPECT_NEAR(r.values(j).real(), lowest(j), 1e-8 * lowest(3));
+
+  // The cached factorization is reused for a larger request
+  const mole::EigsResult more = solver.solve(6);
+  ASSERT_TRUE(more.converged);
+  EXPECT_NEAR(more.values(5).real(), lowest(5), 1e-8 * lowest(5));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_expression.cpp
+ *
+ * @brief Checks lazy operator expressions against the eager sparse
+ *        arithmetic, applied and materialized.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+using mole::identity;
+using mole::lazy;
+
+TEST(ExpressionTests, DivergenceTimesGradient) {
+  const u16 k = 4;
+  const u32 m = 20, n = 15;
+  const Divergence D(k, m, n, 0.05, 0.05);
+  const Gradient G(k, m, n, 0.05, 0.05);
+  const sp_mat L = Laplacian(k, m, n, 0.05, 0.05);
+
+  const auto DG = lazy(D) * lazy(G);
+  ASSERT_EQ(DG.rows(), L.n_rows);
+  ASSERT_EQ(DG.cols(), L.n_cols);
+
+  const vec x = randu<vec>(L.n_cols);
+  EXPECT_LT(max(abs(DG * x - L * x)), 1e-8);
+  EXPECT_LT(abs(DG.materialize() - L).max(), 1e-8);
+
+  // Operators mix in without lazy()
+  EXPECT_LT(max(abs(lazy(D) * G * x - L * x)), 1e-8);
+}
+
+TEST(ExpressionTests, ImplicitStepMatrix) {
+  const Laplacian L(2, 50, 0.02);
+  const Real c = 0.5 * 1e-3 * 0.1;
+  const sp_mat I = speye<sp_mat>(L.n_rows, L.n_cols);
+  const sp_mat eager = I - c * static_cast<const sp_mat &>(L);
+
+  const auto M = identity(L.n_rows) - c * lazy(L);
+  const vec u = randu<vec>(L.n_cols);
+  vec out;
+  M.apply(u, out);
+  EXPECT_LT(max(abs(out - eager * u)), 1e-12);
+
+  const sp_mat A = M.materialize();
+  EXPECT_EQ(A.n_nonzero, eager.n_nonzero);
+  EXPECT_LT(abs(A - eager).max(), 1e-14);
+
+  // Solvers materialize once
+  const vec b = eager * u;
+  vec x;
+  ASSERT_TRUE(spsolve(x, M, b));
+  EXPECT_LT(max(abs(x - u)), 1e-8);
+}
+
+TEST(ExpressionTests, OperatorPlusBoundary) {
+  const Laplacian L(4, 30, 1.0 / 30);
+  const RobinBC BC(4, 30, 1.0 / 30, 1.0, 1.0);
+  const sp_mat eager = L + BC;
+  const auto lazySum = lazy(L) + BC;
+  const vec x = randu<vec>(eager.n_cols);
+  EXPECT_LT(max(abs(lazySum * x - eager * x)), 1e-10);
+  EXPECT_LT(abs(lazySum.materialize() - eager).max(), 1e-12);
+
+  // apply_add folds the scalars into one pass over each operator
+  vec acc = randu<vec>(eager.n_rows);
+  const vec expected = 2.0 * (eager * x) + acc;
+  (2.0 * lazySum).apply_add(1.0, x, 1.0, acc);
+  EXPECT_LT(max(abs(acc - expected)), 1e-9);
+}
+
+TEST(ExpressionTests, SizeMismatch) {
+  const Gradient G(2, 10, 0.1);
+  const Divergence D(2, 12, 0.1);
+  EXPECT_THROW(lazy(D) * lazy(G), std::invalid_argument);
+  EXPECT_THROW(lazy(G) + lazy(D), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_footprint.cpp
+ *
+ * @brief Compares analytic operator footprints with assembled operators and
+ *        checks live-temporary accounting.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+using namespace mole::memory;
+
+namespace {
+
+void expectMatches(const Estimate &e, const sp_mat &A) {
+  EXPECT_EQ(e.result.rows, A.n_rows);
+  EXPECT_EQ(e.result.cols, A.n_cols);
+  EXPECT_EQ(e.result.nnz, A.n_nonzero);
+  EXPECT_EQ(e.result.bytes, footprint(A).bytes);
+  EXPECT_GE(e.peak_bytes, e.result.bytes);
+}
+
+} // namespace
+
+TEST(FootprintTests, GradientAndDivergenceAreExact) {
+  for (u16 k : {2, 4, 6}) {
+    expectMatches(estimateGradient(k, 20), Gradient(k, 20, 0.1));
+    expectMatches(estimateGradient(k, 14, 17), Gradient(k, 14, 17, 0.1, 0.1));
+    expectMatches(estimateGradient(k, 13, 13, 13),
+                  Gradient(k, 13, 13, 13, 0.1, 0.1, 0.1));
+    expectMatches(estimateDivergence(k, 20), Divergence(k, 20, 0.1));
+    expectMatches(estimateDivergence(k, 14, 17),
+                  Divergence(k, 14, 17, 0.1, 0.1));
+    expectMatches(estimateDivergence(k, 13, 14, 15),
+                  Divergence(k, 13, 14, 15, 0.1, 0.1, 0.1));
+  }
+}
+
+TEST(FootprintTests, LaplacianBoundsAssembledOperator) {
+  for (u16 k : {2, 4}) {
+    const Estimate e2 = estimateLaplacian(k, 15, 16);
+    const Laplacian L2(k, 15, 16, 0.1, 0.1);
+    EXPECT_EQ(e2.result.rows, L2.n_rows);
+    EXPECT_GE(e2.result.nnz, L2.n_nonzero);
+    EXPECT_LE(e2.result.nnz, L2.n_nonzero + 2 * L2.n_rows);
+
+    const Estimate e3 = estimateLaplacian(k, 12, 12, 12);
+    const Laplacian L3(k, 12, 12, 12, 0.1, 0.1, 0.1);
+    EXPECT_GE(e3.result.nnz, L3.n_nonzero);
+    EXPECT_LE(e3.result.nnz, L3.n_nonzero + 3 * L3.n_rows);
+  }
+}
+
+TEST(FootprintTests, TracksLiveTemporaries) {
+  const uword before = liveBytes();
+  resetPeak();
+  {
+    Temporary held(1000);
+    EXPECT_EQ(liveBytes(), before + 1000);
+  }
+  EXPECT_EQ(liveBytes(), before);
+  EXPECT_EQ(peakBytes(), before + 1000);
+
+  resetPeak();
+  Gradient G(4, 16, 16, 16, 0.1, 0.1, 0.1);
+  const uword measured = peakBytes() - before;
+  EXPECT_GT(measured, footprint(G).bytes / 2);
+  EXPECT_LE(measured, estimateGradient(4, 16, 16, 16).peak_bytes);
+  EXPECT_EQ(liveBytes(), before);
+}
+
+TEST(FootprintTests, RejectsOversizedBuild) {
+  const Estimate e = estimateLaplacian(2, 40, 40, 40);
+  EXPECT_THROW(checkBudget(e, e.peak_bytes / 2, "Laplacian"),
+               std::runtime_error);
+  EXPECT_NO_THROW(checkBudget(e, e.peak_bytes));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
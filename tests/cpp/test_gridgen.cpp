@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_gridgen.cpp
+ *
+ * @brief Checks transfinite-interpolation and elliptic grids and the metrics
+ *        they share with the curvilinear operators.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using Curve = CurvilinearGrid::Curve;
+using Location = CurvilinearGrid::Location;
+
+// Quarter annulus, radii 1 to 2: xi is radial, eta is angular
+const Curve bottom = [](Real t) { return std::array<Real, 2>{1 + t, 0.0}; };
+const Curve top = [](Real t) { return std::array<Real, 2>{0.0, 1 + t}; };
+const Curve left = [](Real t) {
+  return std::array<Real, 2>{std::cos(M_PI_2 * t), std::sin(M_PI_2 * t)};
+};
+const Curve right = [](Real t) {
+  return std::array<Real, 2>{2 * std::cos(M_PI_2 * t),
+                             2 * std::sin(M_PI_2 * t)};
+};
+
+} // namespace
+
+TEST(GridGenTests, UnitSquareIsUniform) {
+  const u32 m = 8, n = 5;
+  const CurvilinearGrid grid = CurvilinearGrid::tfi(
+      m, n, [](Real t) { return std::array<Real, 2>{t, 0.0}; },
+      [](Real t) { return std::array<Real, 2>{t, 1.0}; },
+      [](Real t) { return std::array<Real, 2>{0.0, t}; },
+      [](Real t) { return std::array<Real, 2>{1.0, t}; });
+
+  const mat &X = grid.x(Location::Nodes), &Y = grid.y(Location::Nodes);
+  ASSERT_EQ(X.n_rows, n + 1);
+  ASSERT_EQ(X.n_cols, m + 1);
+  for (u32 j = 0; j <= n; ++j) {
+    for (u32 i = 0; i <= m; ++i) {
+      EXPECT_NEAR(X(j, i), Real(i) / m, 1e-14);
+      EXPECT_NEAR(Y(j, i), Real(j) / n, 1e-14);
+    }
+  }
+
+  const mat &Xf = grid.x(Location::XFaces), &Yf = grid.y(Location::XFaces);
+  ASSERT_EQ(Xf.n_rows, n);
+  ASSERT_EQ(Xf.n_cols, m + 1);
+  EXPECT_NEAR(Xf(2, 3), 3.0 / m, 1e-14);
+  EXPECT_NEAR(Yf(2, 3), 2.5 / n, 1e-14);
+
+  const mat &Xc = grid.x(Location::Centers);
+  ASSERT_EQ(Xc.n_rows, n + 2);
+  ASSERT_EQ(Xc.n_cols, m + 2);
+  EXPECT_EQ(Xc(0, 0), 0.0);
+  EXPECT_NEAR(Xc(1, 1), 0.5 / m, 1e-14);
+  EXPECT_EQ(Xc(n + 1, m + 1), 1.0);
+  EXPECT_EQ(grid.y(Location::YFaces).n_cols, m);
+}
+
+TEST(GridGenTests, ReproducesBoundaryCurves) {
+  const u32 m = 10, n = 12;
+  const CurvilinearGrid grid = CurvilinearGrid::tfi(m, n, bottom, top, left,
+                                                    right);
+  const mat &X = grid.x(Location::Nodes), &Y = grid.y(Location::Nodes);
+  for (u32 j = 0; j <= n; ++j) {
+    const Real t = Real(j) / n;
+    EXPECT_NEAR(X(j, 0), left(t)[0], 1e-13);
+    EXPECT_NEAR(Y(j, 0), left(t)[1], 1e-13);
+    EXPECT_NEAR(X(j, m), right(t)[0], 1e-13);
+    EXPECT_NEAR(Y(j, m), right(t)[1], 1e-13);
+  }
+  for (u32 i = 0; i <= m; ++i) {
+    const Real t = Real(i) / m;
+    EXPECT_NEAR(X(0, i), bottom(t)[0], 1e-13);
+    EXPECT_NEAR(Y(n, i), top(t)[1], 1e-13);
+  }
+}
+
+TEST(GridGenTests, MetricsAreSharedByOperators) {
+  const u32 m = 16, n = 14;
+  const CurvilinearGrid grid = CurvilinearGrid::tfi(m, n, bottom, top, left,
+                                                    right);
+  const ivec dc = {1, 1, 1, 1};
+  const ivec nc = {0, 0, 0, 0};
+  const CurvilinearMetrics &metrics = grid.metrics(2, dc, nc);
+  EXPECT_EQ(&metrics, &grid.metrics(2, dc, nc));
+  EXPECT_NE(&metrics, &grid.metrics(4, dc, nc));
+  EXPECT_GT(min(metrics.jacobian()), 0.0);
+
+  // Copies share the cache, and concurrent first requests build it once
+  const CurvilinearGrid copy = grid;
+  EXPECT_EQ(&metrics, &copy.metrics(2, dc, nc));
+  std::vector<const CurvilinearMetrics *> seen(8);
+#pragma omp parallel for
+  for (int i = 0; i < 8; ++i)
+    seen[i] = &copy.metrics(6, dc, nc);
+  for (const CurvilinearMetrics *p : seen)
+    EXPECT_EQ(p, &grid.metrics(6, dc, nc));
+
+  // Gradient of 2x - 3y is exact on the annulus
+  const GradientCurv G(metrics);
+  const vec f = 2.0 * vectorise(grid.x(Location::Centers).t()) -
+                3.0 * vectorise(grid.y(Location::Centers).t());
+  const vec g = G * f;
+  const uword nx = (m + 1) * (n + 2);
+  EXPECT_LT(max(abs(g.head(nx) - 2.0)), 1e-9);
+  EXPECT_LT(max(abs(g.tail(g.n_elem - nx) + 3.0)), 1e-9);
+}
+
+TEST(GridGenTests, EllipticGrid) {
+  const u32 m = 16, n = 14;
+  const CurvilinearGrid tfi = CurvilinearGrid::tfi(m, n, bottom, top, left,
+                                                   right);
+  const CurvilinearGrid ttm = CurvilinearGrid::ttm(m, n, bottom, top, left,
+                                                   right, 5000);
+  const mat &X = ttm.x(Location::Nodes), &Y = ttm.y(Location::Nodes);
+  ASSERT_EQ(X.n_rows, n + 1);
+  ASSERT_EQ(X.n_cols, m + 1);
+  for (u32 j = 0; j <= n; ++j) {
+    const Real t = Real(j) / n;
+    EXPECT_NEAR(X(j, m), right(t)[0], 1e-13);
+    EXPECT_NEAR(Y(j, m), right(t)[1], 1e-13);
+  }
+
+  // The sweeps start from the TFI grid and move the interior away from it
+  const CurvilinearGrid start = CurvilinearGrid::ttm(m, n, bottom, top, left,
+                                                     right, 0);
+  EXPECT_LT(abs(start.x(Location::Nodes) - tfi.x(Location::Nodes)).max(),
+            1e-14);
+  EXPECT_GT(abs(X - tfi.x(Location::Nodes)).max(), 1e-2);
+  for (Location where : {Location::Centers, Location::XFaces,
+                         Location::YFaces}) {
+    EXPECT_EQ(ttm.x(where).n_rows, tfi.x(where).n_rows);
+    EXPECT_EQ(ttm.x(where).n_cols, tfi.x(where).n_cols);
+  }
+  EXPECT_NEAR(ttm.x(Location::Centers)(0, 0), 1.0, 1e-13);
+
+  const ivec dc = {1, 1, 1, 1};
+  const ivec nc = {0, 0, 0, 0};
+  EXPECT_GT(min(ttm.metrics(2, dc, nc).jacobian()), 0.0);
+}
+
+TEST(GridGenTests, RejectsEmptyGrid) {
+  EXPECT_THROW(CurvilinearGrid::tfi(0, 4, bottom, top, left, right),
+               std::invalid_argument);
+  EXPECT_THROW(CurvilinearGrid::ttm(4, 0, bottom, top, left, right, 10),
+               std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
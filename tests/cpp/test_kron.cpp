@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_kron.cpp
+ *
+ * @brief Checks the Kronecker-factored operators against the assembled
+ *        ones.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using mole::KronOperator;
+
+namespace {
+
+void expectSame(const KronOperator &K, const sp_mat &A) {
+  ASSERT_EQ(K.rows(), A.n_rows);
+  ASSERT_EQ(K.cols(), A.n_cols);
+  EXPECT_LT(abs(K.assemble() - A).max(), 1e-10);
+
+  const vec x = randu<vec>(A.n_cols);
+  const vec expected = A * x;
+  EXPECT_LT(max(abs(K * x - expected)), 1e-9 * (1.0 + max(abs(expected))));
+}
+
+} // namespace
+
+TEST(KronTests, TwoDimensional) {
+  for (u32 n : {12u, 15u}) {
+    expectSame(KronOperator::gradient(4, 12, n, 0.1, 0.2),
+               Gradient(4, 12, n, 0.1, 0.2));
+    expectSame(KronOperator::divergence(4, 12, n, 0.1, 0.2),
+               Divergence(4, 12, n, 0.1, 0.2));
+    expectSame(KronOperator::laplacian(4, 12, n, 0.1, 0.2),
+               Laplacian(4, 12, n, 0.1, 0.2));
+    expectSame(KronOperator::interpol(12, n, 0.5, 0.5),
+               Interpol(12, n, 0.5, 0.5));
+    expectSame(KronOperator::interpol(true, 12, n, 0.5, 0.5),
+               Interpol(true, 12, n, 0.5, 0.5));
+  }
+}
+
+TEST(KronTests, ThreeDimensional) {
+  for (u32 o : {8u, 11u}) {
+    expectSame(KronOperator::gradient(2, 8, 9, o, 1.0, 0.5, 0.25),
+               Gradient(2, 8, 9, o, 1.0, 0.5, 0.25));
+    expectSame(KronOperator::divergence(2, 8, 9, o, 1.0, 0.5, 0.25),
+               Divergence(2, 8, 9, o, 1.0, 0.5, 0.25));
+    expectSame(KronOperator::laplacian(2, 8, 9, o, 1.0, 0.5, 0.25),
+               Laplacian(2, 8, 9, o, 1.0, 0.5, 0.25));
+    expectSame(KronOperator::interpol(8, 9, o, 0.5, 0.5, 0.5),
+               Interpol(8, 9, o, 0.5, 0.5, 0.5));
+    expectSame(KronOperator::interpol(true, 8, 9, o, 0.5, 0.5, 0.5),
+               Interpol(true, 8, 9, o, 0.5, 0.5, 0.5));
+  }
+}
+
+TEST(KronTests, ParallelApplyAdd) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  const KronOperator K = KronOperator::laplacian(4, 60, 50, 40, 1, 1, 1);
+  const sp_mat L = Laplacian(4, 60, 50, 40, 1, 1, 1);
+  const vec x = randu<vec>(L.n_cols);
+  vec y = randu<vec>(L.n_rows);
+  const vec expected = 2.0 * (L * x) - 0.5 * y;
+
+  K.apply_add(2.0, x, -0.5, y);
+  EXPECT_LT(max(abs(y - expected)), 1e-8 * max(abs(expected)));
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+TEST(KronTests, FactorsOnly) {
+  const u32 m = 100;
+  const KronOperator K = KronOperator::laplacian(4, m, m, m, 1, 1, 1);
+  EXPECT_EQ(K.terms(), 3u);
+  // A few 1-D factors per axis instead of (m + 2)^3 rows of stencils
+  EXPECT_LT(K.bytes(), 100 * 1024u);
+}
+
+TEST(KronTests, BlockMustFit) {
+  KronOperator K(10, 10);
+  EXPECT_THROW(K.add(5, 0, {sp_mat(speye(3, 3)), sp_mat(speye(2, 2))}),
+               std::invalid_argument);
+  EXPECT_THROW(K.add(0, 0, {}), std::invalid_argument);
+
+  K.add(0, 0, {sp_mat(speye(5, 5)), sp_mat(speye(2, 2))}, 3.0);
+  const vec x = randu<vec>(10);
+  EXPECT_LT(max(abs(K * x - 3.0 * x)), 1e-14);
+  vec same = x;
+  EXPECT_THROW(K.apply_add(1.0, same, 1.0, same), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
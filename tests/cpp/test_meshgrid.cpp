@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_meshgrid.cpp
+ *
+ * @brief Checks the lazy coordinate views and the parallel evaluation of
+ *        fields against the dense meshgrid layout.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using mole::MeshGrid;
+
+TEST(MeshGridTests, DenseLayout) {
+  const vec x = linspace(0.0, 1.0, 5), y = linspace(2.0, 3.0, 4),
+            z = linspace(-1.0, 0.0, 3);
+  Utils utils;
+  mat X, Y;
+  utils.meshgrid(x, y, X, Y);
+  ASSERT_EQ(X.n_rows, y.n_elem);
+  ASSERT_EQ(X.n_cols, x.n_elem);
+  for (uword r = 0; r < y.n_elem; ++r)
+    for (uword c = 0; c < x.n_elem; ++c) {
+      EXPECT_EQ(X(r, c), x(c));
+      EXPECT_EQ(Y(r, c), y(r));
+    }
+
+  cube X3, Y3, Z3;
+  utils.meshgrid(x, y, z, X3, Y3, Z3);
+  ASSERT_EQ(X3.n_rows, x.n_elem);
+  ASSERT_EQ(X3.n_slices, z.n_elem);
+  const MeshGrid grid(x, y, z);
+  const mole::MeshView Z = grid.Z();
+  for (uword k = 0; k < z.n_elem; ++k)
+    for (uword j = 0; j < y.n_elem; ++j)
+      for (uword i = 0; i < x.n_elem; ++i) {
+        EXPECT_EQ(X3(i, j, k), x(i));
+        EXPECT_EQ(Y3(i, j, k), y(j));
+        EXPECT_EQ(Z3(i, j, k), z(k));
+        EXPECT_EQ(Z(i, j, k), z(k));
+      }
+  EXPECT_THROW(MeshGrid(x, y).Z(), std::invalid_argument);
+}
+
+TEST(MeshGridTests, EvaluateOrdersXFastest) {
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  // Large enough to run on several threads
+  const vec x = linspace(0.0, 1.0, 40), y = linspace(0.0, 2.0, 30),
+            z = linspace(0.0, 3.0, 20);
+  const vec u = mole::evaluate(MeshGrid(x, y, z), [](Real a, Real b, Real c) {
+    return a + 10.0 * b + 100.0 * c;
+  });
+  ASSERT_EQ(u.n_elem, x.n_elem * y.n_elem * z.n_elem);
+  for (uword k : {0u, 7u, 19u})
+    for (uword j : {0u, 13u, 29u})
+      for (uword i : {0u, 21u, 39u})
+        EXPECT_DOUBLE_EQ(u(i + x.n_elem * (j + y.n_elem * k)),
+                         x(i) + 10.0 * y(j) + 100.0 * z(k));
+
+  vec v;
+  mole::evaluate(MeshGrid(x, y), [](Real a, Real b) { return a * b; }, v);
+  EXPECT_DOUBLE_EQ(v(3 + x.n_elem * 5), x(3) * y(5));
+
+  EXPECT_THROW(mole::evaluate(MeshGrid(x, y),
+                              [](Real, Real, Real) { return 0.0; }),
+               std::invalid_argument);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
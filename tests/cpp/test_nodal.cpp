@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_nodal.cpp
+ *
+ * @brief Checks the nodal derivative operators, their stencil kernels and
+ *        the coupling with the centers-to-nodes interpolators.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+TEST(NodalTests, ExactForPolynomials) {
+  const u32 m = 15;
+  const Real dx = 0.1;
+  const vec x = dx * regspace<vec>(0, m - 1);
+  for (u16 k : {2, 4, 6}) {
+    const Nodal N(k, m, dx);
+    ASSERT_EQ(N.n_rows, m);
+    const vec f = pow(x, k);
+    const vec df = k * pow(x, k - 1);
+    EXPECT_LT(max(abs(N * f - df)), 1e-8) << "k = " << k;
+  }
+}
+
+TEST(NodalTests, MatchesKroneckerForm) {
+  const u32 m = 9, n = 7, o = 8;
+  const sp_mat Nx = Nodal(4, m, 0.5), Ny = Nodal(4, n, 0.25),
+               Nz = Nodal(4, o, 2.0);
+  const sp_mat Im = speye(m, m), In = speye(n, n), Io = speye(o, o);
+
+  const sp_mat N2 = Nodal(4, m, n, 0.5, 0.25);
+  const sp_mat K2 =
+      Utils::spjoin_cols(Utils::spkron(In, Nx), Utils::spkron(Ny, Im));
+  EXPECT_LT(abs(N2 - K2).max(), 1e-12);
+
+  const sp_mat N3 = Nodal(4, m, n, o, 0.5, 0.25, 2.0);
+  const sp_mat K3 = Utils::spjoin_cols(
+      Utils::spjoin_cols(Utils::spkron(Utils::spkron(Io, In), Nx),
+                         Utils::spkron(Utils::spkron(Io, Ny), Im)),
+      Utils::spkron(Utils::spkron(Nz, In), Im));
+  EXPECT_LT(abs(N3 - K3).max(), 1e-12);
+}
+
+TEST(NodalTests, KernelMatchesAssembled) {
+  const NodalKernel kernel(6, 13, 11, 9, 0.1, 0.2, 0.3);
+  const Nodal N(kernel);
+  const vec u = randu<vec>(kernel.size());
+  EXPECT_LT(max(abs(kernel.apply(u) - N * u)), 1e-10);
+}
+
+TEST(NodalTests, PeriodicNodesOfCells) {
+  const u32 m = 32, n = 12;
+  const Real dx = 2.0 * M_PI / m, dy = 1.0 / n;
+  const ivec dc = {0, 0, 1, 1};
+  const ivec nc = {0, 0, 0, 0};
+  const NodalKernel kernel = NodalKernel::onCells(4, m, n, dx, dy, dc, nc);
+  ASSERT_TRUE(kernel.periodic(0));
+  ASSERT_FALSE(kernel.periodic(1));
+  ASSERT_EQ(kernel.size(), m * (n + 1));
+
+  // sin(x) on the nodes, x fastest
+  vec u(kernel.size());
+  for (u32 j = 0; j <= n; ++j)
+    for (u32 i = 0; i < m; ++i)
+      u(j * m + i) = std::sin(i * dx);
+  const vec du = kernel.apply(u);
+  for (u32 i = 0; i < m; ++i)
+    EXPECT_NEAR(du(i), std::cos(i * dx), 1e-4);
+  EXPECT_LT(max(abs(du.tail(kernel.size()))), 1e-10);
+
+  const Nodal N(kernel);
+  EXPECT_LT(max(abs(du - N * u)), 1e-10);
+
+  const vec c = randu<vec>(kernel.centersToNodes().n_cols);
+  vec atNodes, atCenters;
+  kernel.applyCenters(c, atNodes);
+  EXPECT_LT(max(abs(atNodes - N * (kernel.centersToNodes() * c))), 1e-10);
+  kernel.applyCenters(c, atCenters, true);
+  EXPECT_EQ(atCenters.n_elem, 2 * kernel.nodesToCenters().n_rows);
+}
+
+TEST(NodalTests, SidedMatchesApply) {
+  const u32 m = 20;
+  const vec u = randu<vec>(m + 1);
+  for (auto type : {SidedNodal::Type::Backward, SidedNodal::Type::Forward,
+                    SidedNodal::Type::Centered}) {
+    const SidedNodal S(m, 0.1, type);
+    vec out;
+    SidedNodal::applyStencil(type, 0.1, u, out);
+    EXPECT_LT(max(abs(out - S * u)), 1e-12);
+  }
+}
+
+TEST(NodalTests, CentersNeedOnCells) {
+  const NodalKernel kernel(2, 10, 0.1);
+  vec out;
+  EXPECT_THROW(kernel.applyCenters(vec(12, fill::zeros), out),
+               std::runtime_error);
+  EXPECT_THROW(kernel.apply(vec(3, fill::zeros)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
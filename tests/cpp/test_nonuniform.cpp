@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_nonuniform.cpp
+ *
+ * @brief Checks the non-uniform operators against the uniform ones, linear
+ *        fields, and their matrix-free application.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+// Faces on [0, 1] clustered towards x = 0
+vec stretchedFaces(u32 m) {
+  vec x = linspace(0.0, 1.0, m + 1);
+  return x % x;
+}
+
+// Cell centers plus the two boundary points of the given faces
+vec centersOf(const vec &faces) {
+  const uword m = faces.n_elem - 1;
+  vec x(m + 2);
+  x(0) = faces(0);
+  x(m + 1) = faces(m);
+  for (uword i = 1; i <= m; ++i)
+    x(i) = 0.5 * (faces(i - 1) + faces(i));
+  return x;
+}
+
+} // namespace
+
+TEST(NonUniformTests, UniformTicksMatchUniformOperators) {
+  const u32 m = 20;
+  const Real dx = 0.25;
+  const vec faces = linspace(0.0, m * dx, m + 1);
+  for (u16 k : {2, 4, 6}) {
+    const sp_mat G = GradientNonUniform(k, centersOf(faces));
+    const sp_mat D = DivergenceNonUniform(k, faces);
+    const Gradient G0(k, m, dx);
+    const Divergence D0(k, m, dx);
+    EXPECT_LT(abs(G - static_cast<const sp_mat &>(G0)).max(), 1e-10)
+        << "k = " << k;
+    EXPECT_LT(abs(D - static_cast<const sp_mat &>(D0)).max(), 1e-10)
+        << "k = " << k;
+  }
+}
+
+TEST(NonUniformTests, ExactForLinearOnStretchedGrid) {
+  const u32 m = 24;
+  const vec faces = stretchedFaces(m);
+  const vec centers = centersOf(faces);
+  for (u16 k : {2, 4}) {
+    const vec g = GradientNonUniform(k, centers) * (3.0 * centers + 1.0);
+    EXPECT_LT(max(abs(g - 3.0)), 1e-9) << "k = " << k;
+
+    const vec div = DivergenceNonUniform(k, faces) * (2.0 * faces);
+    EXPECT_LT(max(abs(div.subvec(1, m) - 2.0)), 1e-9) << "k = " << k;
+    EXPECT_EQ(div(0), 0.0);
+    EXPECT_EQ(div(m + 1), 0.0);
+  }
+}
+
+TEST(NonUniformTests, Divergence2DOfPosition) {
+  const u32 m = 14, n = 11;
+  const vec xf = stretchedFaces(m), yf = 2.0 * stretchedFaces(n);
+
+  // u = (x, y): x-faces are (m+1) x n, y-faces are m x (n+1), x fastest
+  vec u((m + 1) * n + m * (n + 1));
+  uword p = 0;
+  for (u32 j = 0; j < n; ++j)
+    for (u32 i = 0; i <= m; ++i)
+      u(p++) = xf(i);
+  for (u32 j = 0; j <= n; ++j)
+    for (u32 i = 0; i < m; ++i)
+      u(p++) = yf(j);
+
+  const DivergenceNonUniform D(2, xf, yf);
+  ASSERT_EQ(D.n_cols, u.n_elem);
+  const vec div = D * u;
+  for (u32 j = 0; j < n + 2; ++j) {
+    for (u32 i = 0; i < m + 2; ++i) {
+      const bool boundary = i == 0 || j == 0 || i == m + 1 || j == n + 1;
+      EXPECT_NEAR(div(j * (m + 2) + i), boundary ? 0.0 : 2.0, 1e-9);
+    }
+  }
+}
+
+TEST(NonUniformTests, MatrixFreeMatchesAssembled) {
+  const vec xf = stretchedFaces(9), yf = stretchedFaces(8),
+            zf = stretchedFaces(10);
+  const vec xc = centersOf(xf), yc = centersOf(yf), zc = centersOf(zf);
+  using Kind = NonUniformKernel::Kind;
+
+  const GradientNonUniform G2(2, xc, yc);
+  const NonUniformKernel g2(Kind::Gradient, 2, xc, yc);
+  ASSERT_EQ(g2.rows(), G2.n_rows);
+  ASSERT_EQ(g2.cols(), G2.n_cols);
+  vec u = randu<vec>(G2.n_cols);
+  EXPECT_LT(max(abs(g2.apply(u) - G2 * u)), 1e-10);
+
+  const GradientNonUniform G3(4, xc, yc, zc);
+  const NonUniformKernel g3(Kind::Gradient, 4, xc, yc, zc);
+  u = randu<vec>(G3.n_cols);
+  EXPECT_LT(max(abs(g3.apply(u) - G3 * u)), 1e-9);
+
+  const DivergenceNonUniform D3(2, xf, yf, zf);
+  const NonUniformKernel d3(Kind::Divergence, 2, xf, yf, zf);
+  ASSERT_EQ(d3.rows(), D3.n_rows);
+  ASSERT_EQ(d3.cols(), D3.n_cols);
+  u = randu<vec>(D3.n_cols);
+  EXPECT_LT(max(abs(d3.apply(u) - D3 * u)), 1e-9);
+}
+
+TEST(NonUniformTests, RejectsInvalidTicks) {
+  vec ticks = linspace(0.0, 1.0, 12);
+  ticks(5) = ticks(4);
+  EXPECT_THROW(GradientNonUniform(2, ticks), std::invalid_argument);
+  EXPECT_THROW(DivergenceNonUniform(2, linspace(0.0, 1.0, 4)),
+               std::invalid_argument);
+
+  const NonUniformKernel kernel(NonUniformKernel::Kind::Gradient, 2,
+                                linspace(0.0, 1.0, 10));
+  EXPECT_THROW(kernel.apply(vec(3, fill::zeros)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
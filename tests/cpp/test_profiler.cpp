@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_profiler.cpp
+ *
+ * @brief Checks the profiling call tree, counters and trace output. Uses the
+ *        function API directly so it runs whether or not the macros are
+ *        compiled in.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(ProfilerTests, NestsScopesAndCounters) {
+  mole::profiling::reset();
+
+  for (int i = 0; i < 3; ++i) {
+    mole::profiling::ScopedTimer outer("outer");
+    {
+      mole::profiling::ScopedTimer inner("inner");
+      mole::profiling::count("nnz", 5);
+    }
+  }
+
+  std::ostringstream out;
+  mole::profiling::report(out);
+  const std::string text = out.str();
+
+  const size_t outer = text.find("outer");
+  const size_t inner = text.find("    inner");
+  ASSERT_NE(outer, std::string::npos);
+  ASSERT_NE(inner, std::string::npos);
+  EXPECT_LT(outer, inner);
+  EXPECT_NE(text.find("nnz=15"), std::string::npos);
+}
+
+TEST(ProfilerTests, WritesChromeTrace) {
+  mole::profiling::reset();
+  {
+    mole::profiling::ScopedTimer scope("traced");
+  }
+  mole::profiling::writeChromeTrace("profiler_test_trace.json");
+
+  std::ifstream in("profiler_test_trace.json");
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  EXPECT_NE(buffer.str().find("\"name\": \"traced\""), std::string::npos);
+  EXPECT_NE(buffer.str().find("\"ph\": \"X\""), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
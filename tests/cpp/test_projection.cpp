@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_projection.cpp
+ *
+ * @brief Checks that the pressure projection removes the divergence of face
+ *        velocities, with the direct and the iterative pressure solve.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+using mole::PressureSolve;
+using mole::Projection;
+using mole::ProjectionOptions;
+
+namespace {
+
+const u16 k = 2;
+const u32 m = 20, n = 16;
+const Real dx = 1.0 / m, dy = 1.0 / n;
+
+} // namespace
+
+TEST(ProjectionTests, NeumannDirect) {
+  const Projection projection(Divergence(k, m, n, dx, dy),
+                              Gradient(k, m, n, dx, dy),
+                              RobinBC(k, m, dx, n, dy, 0, 1));
+  // Constants are in the null space, so one boundary row fixes p
+  EXPECT_LT(projection.gaugeRow(), projection.centers());
+
+  vec u = randu<vec>(projection.faces());
+  vec p;
+  const auto report = projection.project(u, p, 0.01);
+  EXPECT_EQ(p.n_elem, projection.centers());
+  EXPECT_GT(report.divergenceBefore, 1.0);
+  EXPECT_LT(report.divergenceAfter, 1e-9 * report.divergenceBefore);
+  EXPECT_EQ(report.iterations, 0u);
+  EXPECT_NEAR(p(projection.gaugeRow()), 0.0, 1e-9);
+}
+
+TEST(ProjectionTests, IterativeMatchesDirect) {
+  const Divergence D(k, m, n, dx, dy);
+  const Gradient G(k, m, n, dx, dy);
+  const RobinBC BC(k, m, dx, n, dy, 0, 1);
+  ProjectionOptions opts;
+  opts.solver = PressureSolve::Iterative;
+  const Projection direct(D, G, BC);
+  const Projection iterative(D, G, BC, opts);
+
+  const vec u0 = randu<vec>(direct.faces());
+  vec u1 = u0, u2 = u0, p1, p2;
+  direct.project(u1, p1);
+  const auto report = iterative.project(u2, p2);
+  EXPECT_TRUE(report.converged);
+  EXPECT_GT(report.iterations, 0u);
+  EXPECT_LT(report.divergenceAfter, 1e-6 * report.divergenceBefore);
+  EXPECT_LT(max(abs(u2 - u1)), 1e-6);
+
+  // The previous pressure starts the next solve
+  vec u3 = u0;
+  const auto warm = iterative.project(u3, p2);
+  EXPECT_LT(warm.iterations, report.iterations / 4);
+  EXPECT_LT(max(abs(u3 - u2)), 1e-8);
+}
+
+TEST(ProjectionTests, DirichletNeedsNoGauge) {
+  const Projection projection(Divergence(k, m, n, dx, dy),
+                              Gradient(k, m, n, dx, dy),
+                              RobinBC(k, m, dx, n, dy, 1, 0));
+  EXPECT_EQ(projection.gaugeRow(), projection.centers());
+
+  vec u = randu<vec>(projection.faces()), p;
+  const vec before = u;
+  const auto report = projection.project(u, p);
+  EXPECT_LT(report.divergenceAfter, 1e-9 * report.divergenceBefore);
+
+  // The correction is a gradient: u - before = -G p
+  const vec correction = Gradient(k, m, n, dx, dy) * p;
+  EXPECT_LT(max(abs(u - before + correction)), 1e-9);
+}
+
+TEST(ProjectionTests, ThreeDimensional) {
+  const u32 o = 10;
+  const Projection projection(
+      Divergence(k, m, n, o, dx, dy, 0.1), Gradient(k, m, n, o, dx, dy, 0.1),
+      RobinBC(k, m, dx, n, dy, o, 0.1, 0, 1));
+  vec u = randu<vec>(projection.faces()), p;
+  const auto report = projection.project(u, p, 0.5);
+  EXPECT_LT(report.divergenceAfter, 1e-9 * report.divergenceBefore);
+}
+
+TEST(ProjectionTests, RejectsBadSizes) {
+  const Divergence D(k, m, n, dx, dy);
+  const Gradient G(k, m, n, dx, dy);
+  EXPECT_THROW(Projection(D, G, speye<sp_mat>(5, 5)), std::invalid_argument);
+
+  const Projection projection(D, G, RobinBC(k, m, dx, n, dy, 1, 0));
+  vec u(3), p;
+  EXPECT_THROW(projection.project(u, p), std::invalid_argument);
+  vec v(projection.faces(), fill::zeros);
+  EXPECT_THROW(projection.project(v, p, 0.0), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
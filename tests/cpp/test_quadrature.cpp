@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_quadrature.cpp
+ *
+ * @brief Checks the trapezoidal and mimetic quadratures against their dense
+ *        definitions, and the compensated, thread-independent sums.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using mole::Quadrature;
+
+TEST(QuadratureTests, TrapezoidalRule) {
+  const vec x = linspace(0.0, 2.0, 41), y = linspace(-1.0, 1.0, 31),
+            z = square(linspace(0.0, 1.0, 11));
+  const vec fx = exp(x);
+  EXPECT_NEAR(Quadrature(x)(fx), Utils::trapz(x, fx), 1e-12);
+
+  // Exact for x y, on a non-uniform z as well
+  const mole::MeshGrid grid(x, y, z);
+  const vec f = mole::evaluate(
+      grid, [](Real a, Real b, Real c) { return a * (b + 1.0) * c; });
+  EXPECT_NEAR(Quadrature(grid)(f), 2.0 * 2.0 * 0.5, 1e-12);
+  EXPECT_NEAR(Quadrature(x, y)(mole::evaluate(mole::MeshGrid(x, y),
+                                              [](Real a, Real) { return a; })),
+              4.0, 1e-12);
+
+  EXPECT_THROW(Quadrature(x)(y), std::invalid_argument);
+  EXPECT_THROW(Quadrature{vec()}, std::invalid_argument);
+  EXPECT_EQ(Utils::trapz(vec(), vec()), 0.0);
+}
+
+TEST(QuadratureTests, MimeticWeights) {
+  const u16 k = 4;
+  const u32 m = 12, n = 10, o = 9;
+  const Real dx = 0.1, dy = 0.2, dz = 0.3;
+
+  const Quadrature P2 = Quadrature::faces(k, {m, n}, {dx, dy});
+  const vec wP = mole::weightsP(k, m, n, dx, dy);
+  ASSERT_EQ(P2.size(), wP.n_elem);
+  EXPECT_LT(max(abs(P2.weights() - wP)), 1e-14);
+  const vec u = randu<vec>(wP.n_elem), v = randu<vec>(wP.n_elem);
+  EXPECT_NEAR(P2.dot(u, v), mole::weightedDot(u, wP, v), 1e-12);
+
+  const Quadrature Q3 = Quadrature::centers(k, {m, n, o}, {dx, dy, dz});
+  const vec wQ = mole::weightsQ(k, m, n, o, dx, dy, dz);
+  EXPECT_LT(max(abs(Q3.weights() - wQ)), 1e-14);
+  EXPECT_LT(max(abs(Quadrature::faces(k, {m, n, o}, {dx, dy, dz}).weights() -
+                    mole::weightsP(k, m, n, o, dx, dy, dz))),
+            1e-14);
+
+  // Without the boundary centers, constants integrate to the volume
+  const Quadrature cells = Quadrature::centers(k, {m, n, o}, {dx, dy, dz},
+                                               false);
+  EXPECT_NEAR(cells(vec(cells.size(), fill::ones)), m * dx * n * dy * o * dz,
+              1e-12);
+}
+
+TEST(QuadratureTests, CompensatedAndDeterministic) {
+  // A plain sum loses every 1e-16 added to the leading 1
+  const uword N = 1000000;
+  const vec x = regspace<vec>(0.0, Real(N - 1));
+  vec f(N);
+  f.fill(1e-16);
+  f(0) = 2.0;
+  const Quadrature rule(x);
+  EXPECT_NEAR(rule(f), 1.0 + (N - 1.5) * 1e-16, 1e-13);
+
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+  const vec g = randu<vec>(N);
+  omp_set_num_threads(1);
+  const Real serial = rule(g);
+  omp_set_num_threads(4);
+  EXPECT_EQ(rule(g), serial);
+  omp_set_num_threads(threads);
+#endif
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
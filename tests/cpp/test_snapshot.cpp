@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_snapshot.cpp
+ *
+ * @brief Round-trips fields through the asynchronous SnapshotWriter and
+ *        checks the raw payload and sidecar metadata.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace {
+
+vec readRaw(const std::string &path, uword n) {
+  vec data(n);
+  std::ifstream in(path, std::ios::binary);
+  in.read(reinterpret_cast<char *>(data.memptr()), n * sizeof(Real));
+  EXPECT_TRUE(static_cast<bool>(in)) << "could not read " << path;
+  return data;
+}
+
+std::string readText(const std::string &path) {
+  std::ifstream in(path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+} // namespace
+
+TEST(SnapshotTests, RoundTripsFrames) {
+  const std::string dir = "snapshot_test_output";
+  const u32 m = 7, n = 5;
+
+  mat U(m + 2, n + 2);
+  vec u(3 * m);
+  for (uword i = 0; i < U.n_elem; ++i)
+    U(i) = 0.5 * i;
+  for (uword i = 0; i < u.n_elem; ++i)
+    u(i) = -1.0 * i;
+
+  {
+    mole::SnapshotWriter writer(dir, "field");
+    writer.write(U, 0.0);
+    // Mutating the source right after the hand-off must not affect the frame.
+    U *= 2.0;
+    writer.write(U, 0.1);
+    writer.write(u, 0.2, {3, m});
+    writer.flush();
+    EXPECT_EQ(writer.frames(), 3u);
+  }
+
+  vec f0 = readRaw(dir + "/field_00000.bin", (m + 2) * (n + 2));
+  vec f1 = readRaw(dir + "/field_00001.bin", (m + 2) * (n + 2));
+  vec f2 = readRaw(dir + "/field_00002.bin", 3 * m);
+
+  EXPECT_NEAR(norm(f0 - 0.5 * vectorise(U)), 0.0, 1e-14);
+  EXPECT_NEAR(norm(f1 - vectorise(U)), 0.0, 1e-14);
+  EXPECT_NEAR(norm(f2 - u), 0.0, 1e-14);
+
+  const std::string meta = readText(dir + "/field_00002.json");
+  EXPECT_NE(meta.find("\"shape\": [3, 7]"), std::string::npos);
+  EXPECT_NE(meta.find("\"dtype\": \"float64\""), std::string::npos);
+  EXPECT_NE(meta.find("\"endian\": \"little\""), std::string::npos);
+
+  // The file is little-endian whatever the host: u(1) = -1.0 is the IEEE
+  // pattern 0xBFF0000000000000, stored low byte first
+  std::ifstream file(dir + "/field_00002.bin", std::ios::binary);
+  const std::string bytes((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+  ASSERT_EQ(bytes.size(), 3 * m * sizeof(Real));
+  EXPECT_EQ(static_cast<unsigned char>(bytes[2 * sizeof(Real) - 1]), 0xBFu);
+  EXPECT_EQ(static_cast<unsigned char>(bytes[2 * sizeof(Real) - 2]), 0xF0u);
+  EXPECT_EQ(static_cast<unsigned char>(bytes[sizeof(Real)]), 0x00u);
+
+  const std::string series = readText(dir + "/field.series.json");
+  EXPECT_NE(series.find("field_00002.bin"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -111,6 +111,39 @@ TEST(SpacingValidation, AddScalarBCRejectsZero) {
                  std::invalid_argument);
 }
 
+// ---------------------------------------------------------------------------
+// Nodal, NodalKernel and SidedNodal
+// ---------------------------------------------------------------------------
+
+TEST(SpacingValidation, NodalRejectsZero) {
+    EXPECT_THROW(Nodal(2, 10, 0.0), std::invalid_argument);
+}
+
+TEST(SpacingValidation, Nodal3DRejectsNaNDy) {
+    EXPECT_THROW(Nodal(2, 10, 10, 10, 0.1, NAN_D, 0.1),
+                 std::invalid_argument);
+}
+
+TEST(SpacingValidation, NodalKernelRejectsNegativeDy) {
+    EXPECT_THROW(NodalKernel(2, 10, 10, 0.1, -0.1), std::invalid_argument);
+}
+
+TEST(SpacingValidation, NodalKernelOnCellsRejectsInf) {
+    const ivec dc = {1, 1};
+    const ivec nc = {0, 0};
+    EXPECT_THROW(NodalKernel::onCells(2, 10, INF_D, dc, nc),
+                 std::invalid_argument);
+}
+
+TEST(SpacingValidation, SidedNodalRejectsZero) {
+    EXPECT_THROW(SidedNodal(10, 0.0, SidedNodal::Type::Centered),
+                 std::invalid_argument);
+    vec u(11, fill::zeros), out;
+    EXPECT_THROW(SidedNodal::applyStencil(SidedNodal::Type::Forward, -0.1, u,
+                                          out),
+                 std::invalid_argument);
+}
+
 // ---------------------------------------------------------------------------
 // Positive sanity check
 // ---------------------------------------------------------------------------
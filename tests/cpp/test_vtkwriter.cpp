@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_vtkwriter.cpp
+ *
+ * @brief Checks the staggered block layout written by VTKWriter.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::string readText(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+} // namespace
+
+TEST(VTKWriterTests, RejectsMismatchedLayout) {
+  mole::VTKWriter writer(4, 3, 0.25, 1.0 / 3);
+  EXPECT_THROW(writer.addField("u", vec(20), mole::FieldLocation::Cells),
+               std::invalid_argument);
+  EXPECT_NO_THROW(writer.addField("u", vec(6 * 5), mole::FieldLocation::Cells));
+  EXPECT_NO_THROW(
+      writer.addField("q", vec(2 * 4 * 3 + 4 + 3), mole::FieldLocation::Faces));
+  EXPECT_NO_THROW(writer.addField("w", vec(5 * 4), mole::FieldLocation::Nodes));
+}
+
+TEST(VTKWriterTests, WritesStaggeredBlocks) {
+  const u32 k = 2, m = 4, n = 3;
+  const Real dx = 0.25, dy = 1.0 / 3;
+
+  Gradient G(k, m, n, dx, dy);
+  vec u(G.n_cols, fill::ones);
+  vec q = G * u;
+
+  mole::VTKWriter writer(m, n, dx, dy);
+  writer.addField("u", u);
+  writer.addField("q", q, mole::FieldLocation::Faces);
+  writer.writeVTK("vtkwriter_test");
+  writer.writeXDMF("vtkwriter_test", 0.5);
+
+  const std::string vtm = readText("vtkwriter_test.vtm");
+  EXPECT_NE(vtm.find("vtkwriter_test_cells.vtr"), std::string::npos);
+  EXPECT_NE(vtm.find("vtkwriter_test_faces_x.vtr"), std::string::npos);
+  EXPECT_NE(vtm.find("vtkwriter_test_faces_y.vtr"), std::string::npos);
+  EXPECT_EQ(vtm.find("nodes"), std::string::npos);
+
+  // x-faces: m+1 normal positions by n cell centers
+  const std::string fx = readText("vtkwriter_test_faces_x.vtr");
+  EXPECT_NE(fx.find("WholeExtent=\"0 4 0 2 0 0\""), std::string::npos);
+  const std::string cells = readText("vtkwriter_test_cells.vtr");
+  EXPECT_NE(cells.find("WholeExtent=\"0 5 0 4 0 0\""), std::string::npos);
+
+  const std::string xmf = readText("vtkwriter_test.xmf");
+  EXPECT_NE(xmf.find("Dimensions=\"4 5\""), std::string::npos);
+  EXPECT_NE(xmf.find("vtkwriter_test_faces_y_q.bin"), std::string::npos);
+
+  // The raw x-face component is exactly the leading slice of the face field.
+  vec raw((m + 1) * n);
+  std::ifstream in("vtkwriter_test_faces_x_q.bin", std::ios::binary);
+  in.read(reinterpret_cast<char *>(raw.memptr()), raw.n_elem * sizeof(Real));
+  ASSERT_TRUE(static_cast<bool>(in));
+  EXPECT_NEAR(norm(raw - q.head(raw.n_elem)), 0.0, 1e-14);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ * © 2008-2024 San Diego State University Research Foundation (SDSURF).
+ * See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+ */
+
+/*
+ * @file test_weights.cpp
+ *
+ * @brief Checks the mimetic weights against the tabulated ones and the
+ *        weighted inner products against their dense definitions.
+ */
+
+#include "mole.h"
+#include <gtest/gtest.h>
+
+using mole::weightsP;
+using mole::weightsQ;
+
+TEST(WeightsTests, SecondOrderP) {
+  const u32 m = 10;
+  const Real dx = 0.5;
+  vec expected(m + 1, fill::ones);
+  expected(0) = expected(m) = 3.0 / 8.0;
+  expected(1) = expected(m - 1) = 9.0 / 8.0;
+  EXPECT_LT(max(abs(weightsP(2, m, dx) - dx * expected)), 1e-12);
+}
+
+TEST(WeightsTests, MatchTabulatedWeights) {
+  // getP() and getQ() tabulate the weights of the smallest grids
+  for (u16 k : {2, 4, 6}) {
+    Gradient G(k, 2 * k, 1.0);
+    EXPECT_LT(max(abs(weightsP(k, 2 * k, 1.0) - G.getP())), 1e-6)
+        << "k = " << k;
+
+    const u32 m = 2 * k + 1;
+    Divergence D(k, m, 1.0);
+    const vec Q = weightsQ(k, m, 1.0);
+    EXPECT_LT(max(abs(Q.subvec(1, m) - D.getQ())), 1e-6) << "k = " << k;
+  }
+}
+
+TEST(WeightsTests, IntegrateConstants) {
+  // G' P = [-1; 0; ...; 1] makes P exact for the derivative of x
+  const u32 m = 40;
+  const Real dx = 0.1;
+  for (u16 k : {2, 4, 6}) {
+    const vec P = weightsP(k, m, dx);
+    const vec Q = weightsQ(k, m, dx);
+    EXPECT_NEAR(accu(P), m * dx, 1e-10) << "k = " << k;
+    EXPECT_NEAR(accu(Q.subvec(1, m)), m * dx, 1e-10) << "k = " << k;
+
+    const sp_mat Gt = Gradient(k, m, dx).t();
+    vec b(m + 2, fill::zeros);
+    b(0) = -1.0;
+    b(m + 1) = 1.0;
+    EXPECT_LT(max(abs(Gt * P - b)), 1e-10) << "k = " << k;
+  }
+}
+
+TEST(WeightsTests, MultiDimensionalLayouts) {
+  const u16 k = 2;
+  const u32 m = 6, n = 7, o = 5;
+  const vec P2 = weightsP(k, m, n, 1.0, 1.0);
+  const vec Q2 = weightsQ(k, m, n, 1.0, 1.0);
+  EXPECT_EQ(P2.n_elem, Gradient(k, m, n, 1.0, 1.0).n_rows);
+  EXPECT_EQ(Q2.n_elem, Divergence(k, m, n, 1.0, 1.0).n_rows);
+
+  const vec P3 = weightsP(k, m, n, o, 1.0, 1.0, 1.0);
+  const vec Q3 = weightsQ(k, m, n, o, 1.0, 1.0, 1.0);
+  EXPECT_EQ(P3.n_elem, Gradient(k, m, n, o, 1.0, 1.0, 1.0).n_rows);
+  EXPECT_EQ(Q3.n_elem, Divergence(k, m, n, o, 1.0, 1.0, 1.0).n_rows);
+
+  // x-faces repeat the 1-D x weights on every row
+  const vec Pm = weightsP(k, m, 1.0);
+  EXPECT_LT(max(abs(P2.subvec(0, m) - Pm)), 1e-14);
+  EXPECT_LT(max(abs(P3.subvec((m + 1) * n, (m + 1) * n + m) - Pm)), 1e-14);
+}
+
+TEST(WeightsTests, WeightedProducts) {
+  const vec u = randu<vec>(50), w = randu<vec>(50), v = randu<vec>(50);
+  EXPECT_NEAR(mole::weightedDot(u, w, v), dot(u, w % v), 1e-12);
+  EXPECT_NEAR(mole::weightedNorm(u, w), std::sqrt(dot(u, w % u)), 1e-12);
+  EXPECT_THROW(mole::weightedDot(u, w, vec(49)), std::invalid_argument);
+}
+
+TEST(WeightsTests, EnergyFunctional) {
+  const u16 k = 4;
+  const u32 m = 30;
+  const Real dx = 1.0 / m;
+  const Gradient G(k, m, dx);
+  const vec P = weightsP(k, m, dx);
+  const mole::EnergyFunctional energy(G, P);
+
+  const vec u = randu<vec>(m + 2);
+  const vec Gu = G * u;
+  EXPECT_NEAR(energy(u), dot(Gu, P % Gu), 1e-10);
+  EXPECT_THROW(energy(vec(m + 1)), std::invalid_argument);
+  EXPECT_THROW(mole::EnergyFunctional(G, vec(m)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}